@@ -11,12 +11,7 @@ def cpp_lib(override=None):
     if _cpp_lib_override is not None:
         return importlib.import_module(_cpp_lib_override)
 
-    if not __debug__:
-        return importlib.import_module("pybindlibs.cpp")
-    try:
-        return importlib.import_module("pybindlibs.cpp_dbg")
-    except ImportError as err:
-        return importlib.import_module("pybindlibs.cpp")
+    return importlib.import_module("pybindlibs.cpp")
 
 
 def cpp_etc_lib():
@@ -27,7 +27,8 @@ if venv_path is not None:
 from .uniform_model import UniformModel
 from .maxwellian_fluid_model import MaxwellianFluidModel
 from .electron_model import ElectronModel
-from .diagnostics import FluidDiagnostics, ElectromagDiagnostics, ParticleDiagnostics, MetaDiagnostics
+from .diagnostics import FluidDiagnostics, ElectromagDiagnostics, ParticleDiagnostics, MetaDiagnostics, \
+                         DistributionDiagnostics, ReductionDiagnostics
 from .simulation import Simulation, serialize as serialize_sim, deserialize as deserialize_sim
 
 
@@ -46,13 +47,45 @@ def _patch_data_ids(path):
     h5File = cpp_etc_lib().samrai_restart_file(path)
     return h5py.File(h5File, "r")["phare"]["patch"]["ids"][:]
 
-def _serialized_simulation_string(path):
+def _serialized_simulation_string(path, restart_format="samraih5"):
     import h5py
     from pyphare.cpp import cpp_etc_lib
+    if restart_format == "phareh5":
+        return h5py.File(cpp_etc_lib().phare_restart_file(path), "r").attrs["serialized_simulation"]
     h5File = cpp_etc_lib().samrai_restart_file(path)
     return h5py.File(h5File, "r")["phare"].attrs["serialized_simulation"]
 
 
+def _restart_time_step(path, restart_format="samraih5"):
+    """
+     the time step saved in a restart file, an adaptive time stepping resumes with it.
+     None for restart files written before it was saved
+    """
+    import h5py
+    from pyphare.cpp import cpp_etc_lib
+    if restart_format == "phareh5":
+        return h5py.File(cpp_etc_lib().phare_restart_file(path), "r").attrs.get("time_step", None)
+    h5File = cpp_etc_lib().samrai_restart_file(path)
+    return h5py.File(h5File, "r")["phare"].attrs.get("time_step", None)
+
+
+def _restart_refinement_boxes(path):
+    """
+     the patches of the refined levels of a "phareh5" restart file, as refinement boxes in the
+     index space of the next coarser level, to rebuild these levels on restart
+    """
+    import h5py
+    from pyphare.core.box import Box
+    from pyphare.cpp import cpp_etc_lib
+    h5File = h5py.File(cpp_etc_lib().phare_restart_file(path), "r")
+    refinement_boxes = {}
+    for ilvl in range(1, h5File.attrs["nbrLevels"]):
+        bounds = h5File[f"levels/L{ilvl}/boxes"][:]
+        ndim = bounds.shape[1] // 2
+        refinement_boxes[f"L{ilvl-1}"] = [Box(b[:ndim] // 2, b[ndim:] // 2) for b in bounds]
+    return refinement_boxes
+
+
 # converts scalars to array of expected size
 # converts lists to arrays
 class py_fn_wrapper:
@@ -107,6 +140,12 @@ def populateDict():
     add_string = pp.add_string
     addInitFunction = getattr(pp, 'addInitFunction{:d}'.format(simulation.ndim)+'D')
 
+    # "phareh5" restarts load the fields and particles of the saved levels from the restart file,
+    #  initial condition functions are not given to C++ where they would never be called
+    init_from_restart = simulation.restart_options is not None \
+        and "restart_time" in simulation.restart_options \
+        and simulation.restart_options.get("format", "samraih5") == "phareh5"
+
     add_string("simulation/name", "simulation_test")
     add_int("simulation/dimension", simulation.ndim)
     add_string("simulation/boundary_types", simulation.boundary_types[0])
@@ -138,12 +177,22 @@ def populateDict():
     add_int("simulation/refined_particle_nbr", simulation.refined_particle_nbr)
     add_double("simulation/time_step", simulation.time_step)
     add_int("simulation/time_step_nbr", simulation.time_step_nbr)
+    if simulation.time_stepping is not None:
+        add_string("simulation/time_stepping/mode", simulation.time_stepping["mode"])
+        for key in ["cfl", "min_dt", "max_dt"]:
+            if key in simulation.time_stepping:
+                add_double("simulation/time_stepping/" + key, simulation.time_stepping[key])
 
 
 
     add_string("simulation/AMR/clustering", simulation.clustering)
     add_int("simulation/AMR/max_nbr_levels", simulation.max_nbr_levels)
+    if simulation.time_refinement is not None:
+        add_string("simulation/AMR/time_refinement/mode", simulation.time_refinement["mode"])
+        if "cfl" in simulation.time_refinement:
+            add_double("simulation/AMR/time_refinement/cfl", simulation.time_refinement["cfl"])
     add_vector_int("simulation/AMR/nesting_buffer", simulation.nesting_buffer)
+    add_string("simulation/AMR/ghost_stream_encoding", simulation.ghost_stream_encoding)
     
     add_int("simulation/AMR/tag_buffer", simulation.tag_buffer) 
    
@@ -180,13 +229,35 @@ def populateDict():
     if refinement_boxes is not None and simulation.refinement =="boxes":
         as_paths(refinement_boxes)
     elif simulation.refinement == "tagging":
+        if init_from_restart:
+            # the levels of the restart are rebuilt before tagging takes over
+            from pyphare.cpp import cpp_etc_lib
+            restart_time = simulation.restart_options["restart_time"]
+            as_paths(_restart_refinement_boxes(
+                cpp_etc_lib().restart_path_for_time(simulation.restart_file_path(), restart_time)))
         add_string("simulation/AMR/refinement/tagging/method","auto")
+        if simulation.tagging_options is not None:
+            tagging_path = "simulation/AMR/refinement/tagging/"
+            tagging_options = simulation.tagging_options
+            for threshold in ["activate_threshold", "deactivate_threshold"]:
+                if threshold in tagging_options:
+                    add_double(tagging_path + threshold, tagging_options[threshold])
+            if "min_lifetime" in tagging_options:
+                add_int(tagging_path + "min_lifetime", tagging_options["min_lifetime"])
+            criteria = tagging_options.get("criteria", [])
+            add_int(tagging_path + "use_density", "density" in criteria)
+            add_int(tagging_path + "use_current", "current" in criteria)
     else:
         add_string("simulation/AMR/refinement/tagging/method","none") # integrator.h might want some looking at
 
     add_string("simulation/algo/ion_updater/pusher/name", simulation.particle_pusher)
+    if simulation.particle_merging is not None:
+        merger_path = "simulation/algo/ion_updater/merger/"
+        for key in ["max_ppc", "target_ppc", "min_level"]:
+            add_int(merger_path + key, simulation.particle_merging[key])
     add_double("simulation/algo/ohm/resistivity", simulation.resistivity)
     add_double("simulation/algo/ohm/hyper_resistivity", simulation.hyper_resistivity)
+    add_int("simulation/algo/field_substeps", simulation.field_substeps)
 
 
     init_model = simulation.model
@@ -204,13 +275,14 @@ def populateDict():
         add_double(pop_path+"{:d}/mass".format(pop_index), d["mass"])
         add_string(partinit_path+"name", "maxwellian")
 
-        addInitFunction(partinit_path+"density", fn_wrapper(d["density"]))
-        addInitFunction(partinit_path+"bulk_velocity_x", fn_wrapper(d["vx"]))
-        addInitFunction(partinit_path+"bulk_velocity_y", fn_wrapper(d["vy"]))
-        addInitFunction(partinit_path+"bulk_velocity_z", fn_wrapper(d["vz"]))
-        addInitFunction(partinit_path+"thermal_velocity_x",fn_wrapper(d["vthx"]))
-        addInitFunction(partinit_path+"thermal_velocity_y",fn_wrapper(d["vthy"]))
-        addInitFunction(partinit_path+"thermal_velocity_z",fn_wrapper(d["vthz"]))
+        if not init_from_restart:
+            addInitFunction(partinit_path+"density", fn_wrapper(d["density"]))
+            addInitFunction(partinit_path+"bulk_velocity_x", fn_wrapper(d["vx"]))
+            addInitFunction(partinit_path+"bulk_velocity_y", fn_wrapper(d["vy"]))
+            addInitFunction(partinit_path+"bulk_velocity_z", fn_wrapper(d["vz"]))
+            addInitFunction(partinit_path+"thermal_velocity_x",fn_wrapper(d["vthx"]))
+            addInitFunction(partinit_path+"thermal_velocity_y",fn_wrapper(d["vthy"]))
+            addInitFunction(partinit_path+"thermal_velocity_z",fn_wrapper(d["vthz"]))
         add_int(partinit_path+"nbr_part_per_cell", d["nbrParticlesPerCell"])
         add_double(partinit_path+"charge", d["charge"])
         add_string(partinit_path+"basis", "cartesian")
@@ -223,9 +295,10 @@ def populateDict():
 
     add_string("simulation/electromag/magnetic/name", "B")
     maginit_path = "simulation/electromag/magnetic/initializer/"
-    addInitFunction(maginit_path+"x_component", fn_wrapper(modelDict["bx"]))
-    addInitFunction(maginit_path+"y_component", fn_wrapper(modelDict["by"]))
-    addInitFunction(maginit_path+"z_component", fn_wrapper(modelDict["bz"]))
+    if not init_from_restart:
+        addInitFunction(maginit_path+"x_component", fn_wrapper(modelDict["bx"]))
+        addInitFunction(maginit_path+"y_component", fn_wrapper(modelDict["by"]))
+        addInitFunction(maginit_path+"z_component", fn_wrapper(modelDict["bz"]))
 
 
     #### adding diagnostics
@@ -236,6 +309,34 @@ def populateDict():
         add_string(name_path + "/" + 'type' , diag.type)
         add_string(name_path + "/" + 'quantity' , diag.quantity)
         add_size_t(name_path + "/" + "flush_every", diag.flush_every)
+        add_string(name_path + "/" + "layout", diag.layout)
+        add_string(name_path + "/" + "precision", diag.precision)
+        if diag.compression is not None:
+            for key, value in diag.compression.items():
+                add_size_t(name_path + "/compression/" + key, value)
+        if diag.selection is not None:
+            selection_path = name_path + "/selection/"
+            if "stride" in diag.selection:
+                add_size_t(selection_path + "stride", diag.selection["stride"])
+            if "fraction" in diag.selection:
+                add_double(selection_path + "fraction", diag.selection["fraction"])
+            if "boxes" in diag.selection:
+                add_vector_int(selection_path + "boxes", diag.selection["boxes"])
+            for key in ["v_min", "v_max"]:
+                if key in diag.selection:
+                    pp.add_array_as_vector(selection_path + key, diag.selection[key])
+        if diag.distribution is not None:
+            distribution_path = name_path + "/distribution/"
+            add_vector_int(distribution_path + "boxes", diag.distribution["boxes"])
+            add_vector_int(distribution_path + "bins", diag.distribution["bins"])
+            add_size_t(distribution_path + "level", diag.distribution["level"])
+            for key in ["v_min", "v_max"]:
+                pp.add_array_as_vector(distribution_path + key, diag.distribution[key])
+        if diag.reduction is not None:
+            reduction_path = name_path + "/reduction/"
+            add_size_t(reduction_path + "axis", diag.reduction["axis"])
+            if "boxes" in diag.reduction:
+                add_vector_int(reduction_path + "boxes", diag.reduction["boxes"])
         pp.add_array_as_vector(name_path + "/" + "write_timestamps", diag.write_timestamps)
         pp.add_array_as_vector(name_path + "/" + "compute_timestamps", diag.compute_timestamps)
         add_size_t(name_path + "/" + 'n_attributes' , len(diag.attributes))
@@ -262,6 +363,7 @@ def populateDict():
         restart_options = simulation.restart_options
         restarts_path = "simulation/restarts/"
         restart_file_path = "phare_outputs"
+        restart_format = restart_options.get("format", "samraih5")
 
         if "dir" in restart_options:
             restart_file_path = restart_options["dir"]
@@ -275,18 +377,23 @@ def populateDict():
             if not os.path.exists(restart_file_load_path):
                 raise ValueError(f"PHARE restart file not found for time {restart_time}")
 
-            deserialized_simulation = deserialize_sim(_serialized_simulation_string(restart_file_load_path))
+            deserialized_simulation = deserialize_sim(_serialized_simulation_string(restart_file_load_path, restart_format))
             if not simulation.is_restartable_compared_to(deserialized_simulation):
                 raise ValueError("deserialized Restart simulation is incompatible with configured simulation parameters")
 
-            add_vector_int(restarts_path + "restart_ids", _patch_data_ids(restart_file_load_path))
+            if restart_format == "samraih5":
+                add_vector_int(restarts_path + "restart_ids", _patch_data_ids(restart_file_load_path))
             add_string(restarts_path + "loadPath", restart_file_load_path)
             add_double(restarts_path + "restart_time", restart_time)
+            restart_time_step = _restart_time_step(restart_file_load_path, restart_format)
+            if restart_time_step is not None:
+                add_double(restarts_path + "time_step", restart_time_step)
 
         if "mode" in restart_options:
             add_string(restarts_path + "mode", restart_options["mode"])
 
         add_string(restarts_path + "filePath", restart_file_path)
+        add_string(restarts_path + "format", restart_format)
 
 
         pp.add_array_as_vector(restarts_path + "write_timestamps", restart_options["timestamps"])
@@ -1,4 +1,6 @@
 
+import os
+
 from ..core import phare_utilities
 from . import global_vars
 
@@ -16,7 +18,9 @@ def diagnostics_checker(func):
         if len(missing_mandatory_kwds) > 0:
             raise RuntimeError("Error: missing mandatory parameters : " + ', '.join(missing_mandatory_kwds))
 
-        accepted_keywords = ['path', 'compute_timestamps', 'population_name', 'flush_every']
+        accepted_keywords = ['path', 'compute_timestamps', 'population_name', 'flush_every',
+                             'layout', 'compression', 'selection', 'distribution',
+                             'reduction', 'precision']
         accepted_keywords += mandatory_keywords
 
         # check that all passed keywords are in the accepted keyword list
@@ -61,6 +65,172 @@ def validate_timestamps(clazz, **kwargs):
 
 
 
+# ------------------------------------------------------------------------------
+
+def check_compression(clazz, compression):
+    """
+    compression is None or a dict with keys
+      - chunk_size: number of values per dataset chunk (mandatory)
+      - shuffle: bool, byte shuffling before compression, default False
+      - deflate: int in [0, 9], deflate (gzip) compression level, default 0 (no compression)
+      - error_bound: float, enables lossy quantization of floating point values such that
+                     the absolute error is less than error_bound, default None (lossless)
+    with several MPI processes, compression requires the "aggregated" layout
+    """
+    if compression is None:
+        return None
+
+    accepted = ["chunk_size", "shuffle", "deflate", "error_bound"]
+    wrong_keys = [key for key in compression if key not in accepted]
+    if len(wrong_keys) > 0:
+        raise ValueError(f"Error: {clazz}.compression invalid keys {wrong_keys}, expected {accepted}")
+
+    if "chunk_size" not in compression or int(compression["chunk_size"]) <= 0:
+        raise ValueError(f"Error: {clazz}.compression requires a positive chunk_size")
+
+    deflate = int(compression.get("deflate", 0))
+    if deflate < 0 or deflate > 9:
+        raise ValueError(f"Error: {clazz}.compression deflate level must be in [0, 9]")
+
+    # scale-offset quantization keeps d decimal digits, the error being at most 0.5 * 10^-d
+    quantize_digits = 0
+    error_bound = compression.get("error_bound", None)
+    if error_bound is not None:
+        if error_bound <= 0:
+            raise ValueError(f"Error: {clazz}.compression error_bound must be positive")
+        quantize_digits = max(1, int(np.ceil(np.log10(0.5 / error_bound))))
+
+    return {"chunk_size": int(compression["chunk_size"]),
+            "shuffle": int(bool(compression.get("shuffle", False))),
+            "deflate": deflate,
+            "quantize_digits": quantize_digits}
+
+
+
+def check_selection(clazz, selection):
+    """
+    selection of the particles written by a particle diagnostic, None or a dict with keys
+      - stride: int, only every stride-th particle is written
+      - fraction: float in ]0, 1], only a deterministic (hash based) fraction of particles is written
+      - boxes: list of Box, in level 0 cell indexes, only particles in one of them are written
+      - v_min, v_max: 3 floats, only particles with velocity components within are written
+    """
+    if selection is None:
+        return None
+
+    accepted = ["stride", "fraction", "boxes", "v_min", "v_max"]
+    wrong_keys = [key for key in selection if key not in accepted]
+    if len(wrong_keys) > 0:
+        raise ValueError(f"Error: {clazz}.selection invalid keys {wrong_keys}, expected {accepted}")
+
+    checked = {}
+    if "stride" in selection:
+        checked["stride"] = int(selection["stride"])
+        if checked["stride"] < 1:
+            raise ValueError(f"Error: {clazz}.selection stride must be at least 1")
+
+    if "fraction" in selection:
+        checked["fraction"] = float(selection["fraction"])
+        if checked["fraction"] <= 0 or checked["fraction"] > 1:
+            raise ValueError(f"Error: {clazz}.selection fraction must be in ]0, 1]")
+
+    if "boxes" in selection:
+        ndim = global_vars.sim.ndim
+        bounds = []
+        for box in selection["boxes"]:
+            if len(box.lower) != ndim:
+                raise ValueError(f"Error: {clazz}.selection boxes must be of dimension {ndim}")
+            bounds += [int(x) for x in box.lower] + [int(x) for x in box.upper]
+        checked["boxes"] = bounds
+
+    for key in ["v_min", "v_max"]:
+        if key in selection:
+            if len(selection[key]) != 3:
+                raise ValueError(f"Error: {clazz}.selection {key} must have 3 components")
+            checked[key] = np.asarray(selection[key], dtype=float)
+
+    return checked
+
+
+
+def check_distribution(clazz, distribution):
+    """
+    velocity histograms of a distribution diagnostic, a dict with keys
+      - boxes: list of Box, in level 0 cell indexes, one histogram per box (mandatory)
+      - bins: int or 3 ints, number of bins per velocity component, 1 integrates over the component
+      - v_min, v_max: 3 floats, velocity range of the bins, particles out of it are not counted
+      - level: int, level of the particles binned, default 0 which covers the whole domain
+    """
+    if distribution is None:
+        raise ValueError(f"Error: {clazz} requires a distribution parameter")
+
+    accepted = ["boxes", "bins", "v_min", "v_max", "level"]
+    wrong_keys = [key for key in distribution if key not in accepted]
+    if len(wrong_keys) > 0:
+        raise ValueError(f"Error: {clazz}.distribution invalid keys {wrong_keys}, expected {accepted}")
+
+    missing = [key for key in ["boxes", "bins", "v_min", "v_max"] if key not in distribution]
+    if len(missing) > 0:
+        raise ValueError(f"Error: {clazz}.distribution missing keys {missing}")
+
+    ndim = global_vars.sim.ndim
+    bounds = []
+    for box in distribution["boxes"]:
+        if len(box.lower) != ndim:
+            raise ValueError(f"Error: {clazz}.distribution boxes must be of dimension {ndim}")
+        bounds += [int(x) for x in box.lower] + [int(x) for x in box.upper]
+    if len(bounds) == 0:
+        raise ValueError(f"Error: {clazz}.distribution requires at least one box")
+
+    bins = distribution["bins"]
+    bins = [int(bins)] * 3 if np.isscalar(bins) else [int(x) for x in bins]
+    if len(bins) != 3 or any([nbr < 1 for nbr in bins]):
+        raise ValueError(f"Error: {clazz}.distribution bins must be 3 integers of at least 1")
+
+    checked = {"boxes": bounds, "bins": bins, "level": int(distribution.get("level", 0))}
+    for key in ["v_min", "v_max"]:
+        if len(distribution[key]) != 3:
+            raise ValueError(f"Error: {clazz}.distribution {key} must have 3 components")
+        checked[key] = np.asarray(distribution[key], dtype=float)
+    if np.any(checked["v_min"] >= checked["v_max"]):
+        raise ValueError(f"Error: {clazz}.distribution v_min must be less than v_max")
+
+    return checked
+
+
+
+def check_reduction(clazz, quantity, reduction):
+    """
+    parameters of a reduction diagnostic, None or a dict with keys
+      - axis: int, direction of profiles and spectra, default 0
+      - boxes: list of Box, in level 0 cell indexes, one profile per box (mandatory for profiles)
+    """
+    reduction = {} if reduction is None else reduction
+
+    accepted = ["axis", "boxes"]
+    wrong_keys = [key for key in reduction if key not in accepted]
+    if len(wrong_keys) > 0:
+        raise ValueError(f"Error: {clazz}.reduction invalid keys {wrong_keys}, expected {accepted}")
+
+    ndim = global_vars.sim.ndim
+    checked = {"axis": int(reduction.get("axis", 0))}
+    if checked["axis"] < 0 or checked["axis"] >= ndim:
+        raise ValueError(f"Error: {clazz}.reduction axis must be in [0, {ndim})")
+
+    if quantity == "profile":
+        if len(reduction.get("boxes", [])) == 0:
+            raise ValueError(f"Error: {clazz} profiles require at least one box")
+        bounds = []
+        for box in reduction["boxes"]:
+            if len(box.lower) != ndim:
+                raise ValueError(f"Error: {clazz}.reduction boxes must be of dimension {ndim}")
+            bounds += [int(x) for x in box.lower] + [int(x) for x in box.upper]
+        checked["boxes"] = bounds
+
+    return checked
+
+
+
 # ------------------------------------------------------------------------------
 
 def try_cpp_dep_vers():
@@ -73,6 +243,8 @@ def try_cpp_dep_vers():
 class Diagnostics(object):
 
     h5_flush_never = 0
+    layouts = ["patches", "aggregated"]
+    precisions = ["float", "double"]
     cpp_dep_vers = try_cpp_dep_vers()
 
     @diagnostics_checker
@@ -97,12 +269,48 @@ class Diagnostics(object):
         for key in self.attributes:
             self.attributes[key] = self.attributes[key]
 
+        self.distribution = None
+        self.reduction = None
         self._setSubTypeAttributes(**kwargs)
+        for key in ["distribution", "reduction"]:
+            if key in kwargs and self.type != key:
+                raise ValueError(f"Error: {self.__class__.__name__} does not support the {key} parameter")
+
+        # results computed after the last write timestamp would never be written
+        if self.type in ["distribution", "reduction"] and len(self.compute_timestamps) > 0:
+            if len(self.write_timestamps) == 0 or \
+               np.max(self.compute_timestamps) > np.max(self.write_timestamps):
+                raise RuntimeError(f"Error: {self.__class__.__name__}.compute_timestamps cannot be"
+                                   " greater than the last write timestamp")
+
         self.flush_every = kwargs.get("flush_every", 1) # flushes every dump, safe, but costly
 
         if self.flush_every < 0:
             raise RuntimeError(f"{self.__class__.__name__,}.flush_every cannot be negative")
 
+        # "patches": one dataset per patch and quantity
+        # "aggregated": one dataset per level and quantity, with a table indexing the patches
+        self.layout = kwargs.get("layout", "patches")
+        if self.layout not in Diagnostics.layouts:
+            raise ValueError(f"Error: invalid layout ({self.layout}), expected one of {Diagnostics.layouts}")
+        if self.layout == "aggregated" and self.type not in ["electromag", "fluid", "particle"]:
+            raise ValueError(f"Error: {self.__class__.__name__} does not support the aggregated layout")
+
+        # storage precision of floating point values, the default of the simulation diag_options
+        # if any, then of the PHARE_DIAG_PRECISION environment variable (set for tests), float otherwise
+        diag_options = global_vars.sim.diag_options or {}
+        default_precision = diag_options.get("options", {}).get("precision",
+                                                                os.environ.get("PHARE_DIAG_PRECISION", "float"))
+        self.precision = kwargs.get("precision", default_precision)
+        if self.precision not in Diagnostics.precisions:
+            raise ValueError(f"Error: invalid precision ({self.precision}), expected one of {Diagnostics.precisions}")
+
+        self.compression = check_compression(self.__class__.__name__, kwargs.get("compression", None))
+
+        self.selection = check_selection(self.__class__.__name__, kwargs.get("selection", None))
+        if self.selection is not None and self.type != "particle":
+            raise ValueError(f"Error: {self.__class__.__name__} does not support particle selection")
+
         if any([self.quantity == diagnostic.quantity for diagnostic in global_vars.sim.diagnostics]):
             raise RuntimeError(f"Error: Diagnostic ({kwargs['quantity']}) already registered")
 
@@ -279,3 +487,76 @@ class MetaDiagnostics(Diagnostics):
                 "path": self.path
                }
 
+
+
+# ------------------------------------------------------------------------------
+
+
+class DistributionDiagnostics(Diagnostics):
+
+    distribution_quantities = ['distribution']
+    type = "distribution"
+
+    def __init__(self, **kwargs):
+        super(DistributionDiagnostics, self).__init__(DistributionDiagnostics.type \
+                                                      + str(global_vars.sim.count_diagnostics(DistributionDiagnostics.type)),
+                                                      **kwargs)
+
+    def _setSubTypeAttributes(self, **kwargs):
+
+        if kwargs['quantity'] not in DistributionDiagnostics.distribution_quantities:
+            error_msg = "Error: '{}' not a valid distribution diagnostics : " + ', '.join(DistributionDiagnostics.distribution_quantities)
+            raise ValueError(error_msg.format(kwargs['quantity']))
+
+        if 'population_name' not in kwargs:
+            raise ValueError("Error: missing population_name")
+        self.population_name = kwargs['population_name']
+
+        if self.population_name not in global_vars.sim.model.populations:
+            raise ValueError("Error: population '{}' not in simulation initial model".format(self.population_name))
+
+        self.distribution = check_distribution(self.__class__.__name__, kwargs.get("distribution", None))
+
+        self.quantity = "/ions/pop/" + self.population_name + "/" + kwargs['quantity']
+
+    def to_dict(self):
+        return {"name": self.name,
+                "type": DistributionDiagnostics.type,
+                "quantity": self.quantity,
+                "write_timestamps": self.write_timestamps,
+                "compute_timestamps": self.compute_timestamps,
+                "path": self.path,
+                "population_name": self.population_name}
+
+
+
+# ------------------------------------------------------------------------------
+
+
+class ReductionDiagnostics(Diagnostics):
+
+    reduction_quantities = ['energy', 'profile', 'spectrum']
+    type = "reduction"
+
+    def __init__(self, **kwargs):
+        super(ReductionDiagnostics, self).__init__(ReductionDiagnostics.type \
+                                                   + str(global_vars.sim.count_diagnostics(ReductionDiagnostics.type)),
+                                                   **kwargs)
+
+    def _setSubTypeAttributes(self, **kwargs):
+
+        if kwargs['quantity'] not in ReductionDiagnostics.reduction_quantities:
+            error_msg = "Error: '{}' not a valid reduction diagnostics : " + ', '.join(ReductionDiagnostics.reduction_quantities)
+            raise ValueError(error_msg.format(kwargs['quantity']))
+
+        self.reduction = check_reduction(self.__class__.__name__, kwargs['quantity'], kwargs.get("reduction", None))
+
+        self.quantity = f"/{kwargs['quantity']}"
+
+    def to_dict(self):
+        return {"name": self.name,
+                "type": ReductionDiagnostics.type,
+                "quantity": self.quantity,
+                "write_timestamps": self.write_timestamps,
+                "compute_timestamps": self.compute_timestamps,
+                "path": self.path}
@@ -24,6 +24,29 @@ def validate(sim):
 
     sim.restart_options["timestamps"] = conserve_existing(sim)
 
+    if restarts_from_phareh5(sim) and sim.refinement == "tagging" and has_tag_hysteresis(sim):
+        raise RuntimeError("Error: phareh5 restarts do not save tag ages, a tagging hysteresis"
+                           " (min_lifetime or deactivate_threshold) requires samraih5 restarts")
+
+# ------------------------------------------------------------------------------
+
+
+
+def restarts_from_phareh5(sim):
+    restart_options = sim.restart_options
+    return "restart_time" in restart_options and restart_options.get("format", "samraih5") == "phareh5"
+
+
+
+def has_tag_hysteresis(sim):
+    """
+      tags then depend on the tag ages, the number of tagging steps cells have been tagged for
+    """
+    tagging_options = sim.tagging_options or {}
+    activate = tagging_options.get("activate_threshold", 0.1)
+    deactivate = tagging_options.get("deactivate_threshold", activate)
+    return tagging_options.get("min_lifetime", 0) > 0 or deactivate < activate
+
 # ------------------------------------------------------------------------------
 
 
@@ -378,6 +378,11 @@ def check_diag_options(**kwargs):
             mode = diag_options["options"]["mode"]
             if mode not in valid_modes:
                 raise ValueError (f"Invalid diagnostics mode {mode}, valid modes are {valid_modes}")
+        valid_precisions = ["float", "double"]
+        if "precision" in diag_options["options"]:
+            precision = diag_options["options"]["precision"]
+            if precision not in valid_precisions:
+                raise ValueError (f"Invalid diagnostics precision {precision}, valid precisions are {valid_precisions}")
     return diag_options
 
 
@@ -399,6 +404,11 @@ def check_restart_options(**kwargs):
         if mode not in valid_modes:
             raise ValueError (f"Invalid restart mode {mode}, valid modes are {valid_modes}")
 
+        valid_formats = ["samraih5", "phareh5"]
+        restart_format = restart_options.get("format", "samraih5")
+        if restart_format not in valid_formats:
+            raise ValueError (f"Invalid restart format {restart_format}, valid formats are {valid_formats}")
+
     return restart_options
 
 def validate_restart_options(sim):
@@ -414,6 +424,94 @@ def check_refinement(**kwargs):
 
 
 
+def check_tagging_options(**kwargs):
+    tagging_options = kwargs.get("tagging_options", None)
+
+    if tagging_options is not None:
+        valid_keys = ["activate_threshold", "deactivate_threshold", "min_lifetime", "criteria"]
+        invalid_keys = [key for key in tagging_options if key not in valid_keys]
+        if len(invalid_keys) > 0:
+            raise ValueError(f"Error: invalid tagging_options {invalid_keys}, valid keys are {valid_keys}")
+
+        activate = tagging_options.get("activate_threshold", 0.1)
+        deactivate = tagging_options.get("deactivate_threshold", activate)
+        if deactivate > activate:
+            raise ValueError("Error: tagging deactivate_threshold cannot be greater than activate_threshold")
+
+        if tagging_options.get("min_lifetime", 0) < 0:
+            raise ValueError("Error: tagging min_lifetime cannot be negative")
+
+        valid_criteria = ["B", "density", "current"]
+        for criterion in tagging_options.get("criteria", []):
+            if criterion not in valid_criteria:
+                raise ValueError(f"Error: invalid tagging criterion {criterion}, valid criteria are {valid_criteria}")
+
+    return tagging_options
+
+
+
+def check_time_stepping(**kwargs):
+    time_stepping = kwargs.get("time_stepping", None)
+
+    if time_stepping is not None:
+        valid_keys = ["mode", "cfl", "min_dt", "max_dt"]
+        invalid_keys = [key for key in time_stepping if key not in valid_keys]
+        if len(invalid_keys) > 0:
+            raise ValueError(f"Error: invalid time_stepping {invalid_keys}, valid keys are {valid_keys}")
+
+        valid_modes = ["constant", "adaptive"]
+        time_stepping["mode"] = time_stepping.get("mode", "adaptive")
+        if time_stepping["mode"] not in valid_modes:
+            raise ValueError(f"Error: invalid time_stepping mode {time_stepping['mode']}, valid modes are {valid_modes}")
+
+        if time_stepping.get("cfl", 0.5) <= 0:
+            raise ValueError("Error: time_stepping cfl must be positive")
+
+        if time_stepping.get("min_dt", 0) > time_stepping.get("max_dt", np.inf):
+            raise ValueError("Error: time_stepping min_dt cannot be greater than max_dt")
+
+    return time_stepping
+
+
+
+def check_time_refinement(**kwargs):
+    time_refinement = kwargs.get("time_refinement", None)
+
+    if time_refinement is not None:
+        valid_keys = ["mode", "cfl"]
+        invalid_keys = [key for key in time_refinement if key not in valid_keys]
+        if len(invalid_keys) > 0:
+            raise ValueError(f"Error: invalid time_refinement {invalid_keys}, valid keys are {valid_keys}")
+
+        valid_modes = ["fixed", "adaptive"]
+        time_refinement["mode"] = time_refinement.get("mode", "adaptive")
+        if time_refinement["mode"] not in valid_modes:
+            raise ValueError(f"Error: invalid time_refinement mode {time_refinement['mode']}, valid modes are {valid_modes}")
+
+        if time_refinement.get("cfl", 0.5) <= 0:
+            raise ValueError("Error: time_refinement cfl must be positive")
+
+    return time_refinement
+
+
+
+def check_particle_merging(**kwargs):
+    particle_merging = kwargs.get("particle_merging", None)
+
+    if particle_merging is not None:
+        for key in ["max_ppc", "target_ppc"]:
+            if key not in particle_merging:
+                raise ValueError(f"Error: particle_merging expects {key}")
+
+        if particle_merging["target_ppc"] < 2 or particle_merging["target_ppc"] > particle_merging["max_ppc"]:
+            raise ValueError("Error: particle_merging expects 2 <= target_ppc <= max_ppc")
+
+        particle_merging["min_level"] = particle_merging.get("min_level", 1)
+
+    return particle_merging
+
+
+
 def check_nesting_buffer(ndim, **kwargs):
     nesting_buffer = phare_utilities.np_array_ify(kwargs.get('nesting_buffer', 0), ndim)
 
@@ -469,6 +567,15 @@ def check_hyper_resistivity(**kwargs):
 
     return hyper_resistivity
 
+
+
+def check_field_substeps(**kwargs):
+    field_substeps = kwargs.get("field_substeps", 1)
+    if not isinstance(field_substeps, int) or field_substeps < 1:
+        raise ValueError(f"Error: field_substeps should be a strictly positive integer")
+
+    return field_substeps
+
 def check_clustering(**kwargs):
     valid_keys = ["berger", "tile"]
     clustering = kwargs.get("clustering", "berger")
@@ -478,6 +585,15 @@ def check_clustering(**kwargs):
 
 
 
+def check_ghost_stream_encoding(**kwargs):
+    valid_keys = ["double", "float", "delta"]
+    encoding = kwargs.get("ghost_stream_encoding", "double")
+    if encoding not in valid_keys:
+        raise ValueError(f"Error: invalid ghost_stream_encoding {encoding}, valid encodings are {valid_keys}")
+    return encoding
+
+
+
 # ------------------------------------------------------------------------------
 
 def checker(func):
@@ -487,7 +603,9 @@ def checker(func):
                              'boundary_types', 'refined_particle_nbr', 'path', 'nesting_buffer',
                              'diag_export_format', 'refinement_boxes', 'refinement', 'clustering',
                              'smallest_patch_size', 'largest_patch_size', "diag_options",
-                             'resistivity', 'hyper_resistivity', 'strict', "restart_options", 'tag_buffer', ]
+                             'resistivity', 'hyper_resistivity', 'strict', "restart_options", 'tag_buffer',
+                             'tagging_options', 'particle_merging', 'time_stepping', 'field_substeps',
+                             'time_refinement', 'ghost_stream_encoding', ]
 
         accepted_keywords += check_optional_keywords(**kwargs)
 
@@ -509,6 +627,7 @@ def checker(func):
         kwargs["time_step_nbr"] = time_step_nbr
         kwargs["time_step"] = time_step
         kwargs["final_time"] = final_time
+        kwargs["time_stepping"] = check_time_stepping(**kwargs)
 
         kwargs["interp_order"] = check_interp_order(**kwargs)
         kwargs["refinement_ratio"] = 2
@@ -537,6 +656,10 @@ def checker(func):
         kwargs["tag_buffer"] = kwargs.get('tag_buffer', 1)
 
         kwargs["refinement"] = check_refinement(**kwargs)
+        kwargs["tagging_options"] = check_tagging_options(**kwargs)
+        kwargs["particle_merging"] = check_particle_merging(**kwargs)
+        kwargs["time_refinement"] = check_time_refinement(**kwargs)
+        kwargs["ghost_stream_encoding"] = check_ghost_stream_encoding(**kwargs)
         if kwargs["refinement"] == "boxes":
             kwargs["refinement_boxes"], kwargs["max_nbr_levels"] = check_refinement_boxes(ndim, **kwargs)
         else:
@@ -548,6 +671,8 @@ def checker(func):
 
         kwargs["hyper_resistivity"] = check_hyper_resistivity(**kwargs)
 
+        kwargs["field_substeps"] = check_field_substeps(**kwargs)
+
         return func(simulation_object, **kwargs)
 
     return wrapper
@@ -587,6 +712,7 @@ class Simulation(object):
                                              "mode":"overwrite"}},
                    restart_options={"dir": restart_outputs,
                                    "mode": "overwrite" or "conserve",
+                                   "format": "samraih5" (default, per MPI process) or "phareh5" (any number of MPI processes on restart, initial condition functions are not evaluated),
                                    "timestamps" : [.009, 99999]
                                    "restart_time" : 99999.99999 },
                    strict=True (turns warnings to errors, false by default),
@@ -602,6 +728,16 @@ Setting time parameters:
           simulation time step. Use with time_step_nbr OR final_time
         * *time_step_nbr* (``int``) -- number of time step to perform.
           Use with final_time OR time_step
+        * *time_stepping* (``dict``) --
+          [default=None] {"mode": "adaptive", "cfl": float, "min_dt": float, "max_dt": float}.
+          In adaptive mode, each time step is "cfl" (default 0.5) times the largest stable time step,
+          estimated from particle velocities, the magnetic field and the density, and lands exactly on
+          diagnostic and restart timestamps. time_step is then the first time step, and the simulation
+          stops if the time step falls below "min_dt".
+        * *field_substeps* (``int``) --
+          [default=1] number of substeps in which the magnetic and electric fields are advanced during
+          each ion push, the ion moments being fixed. Adaptive time steps are then limited by the
+          whistler waves over a substep, and still by the particles and the Alfven waves over a step.
 
 
 
@@ -675,6 +811,27 @@ Adaptive Mesh Refinement (AMR) parameters
           number of refined particle per coarse particle.
         * *tag_buffer* (``int``) --
           [default=1] value representing the number of cells by which tagged cells are buffered before clustering into boxes.
+        * *tagging_options* (``dict``) --
+          [default=None] used if refinement is "tagging". Cells get tagged when their criterion exceeds
+          "activate_threshold" (default 0.1) and stay tagged while it exceeds "deactivate_threshold"
+          (default activate_threshold), for at least "min_lifetime" tagging steps (default 0).
+          "min_lifetime" applies to tagged cells, not to patches: patches follow from the clustering
+          of the tagged cells. Tag ages are saved in "samraih5" restart files only, restarting from a "phareh5" one
+          with a tagging hysteresis (min_lifetime or deactivate_threshold) is rejected.
+          "criteria" lists what the criterion is computed on, among "B" (always used), "density" and "current".
+        * *particle_merging* (``dict``) --
+          [default=None] {"max_ppc": int, "target_ppc": int, "min_level": int}. On levels from "min_level"
+          (default 1), cells with more than "max_ppc" particles of a population get them merged down to about
+          "target_ppc", conserving weight, momentum and energy.
+        * *time_refinement* (``dict``) --
+          [default=None] {"mode": "adaptive", "cfl": float}. By default, each refined level takes 4 substeps per
+          step of its coarser level. In adaptive mode, refined levels take the fewest substeps that keep their
+          time step below "cfl" (default 0.5) times their stable time step. level_time_steps and level_step_nbr
+          then no longer describe the actual substeps.
+        * *ghost_stream_encoding* (``str``) --
+          [default="double"] how E and B values are sent between MPI ranks to fill the ghosts of refined levels.
+          "delta" is lossless and sends fewer bytes on smooth fields, "float" halves the bytes sent but
+          rounds the ghost values to single precision.
     """
 
     @checker
@@ -694,7 +851,7 @@ Adaptive Mesh Refinement (AMR) parameters
         self.model = None
         self.electrons = None
 
-        # hard coded in C++ MultiPhysicsIntegrator::getMaxFinerLevelDt
+        # hard coded in C++ MultiPhysicsIntegrator::getMaxFinerLevelDt, unless time_refinement is adaptive
         self.nSubcycles = 4
         self.stepDiff = 1/self.nSubcycles
 
@@ -2,6 +2,7 @@
 
 import os
 import numpy as np
+from collections.abc import MutableMapping
 
 from .particles import Particles
 
@@ -159,10 +160,12 @@ class ParticleData(PatchData):
     def __init__(self, layout, data, pop_name):
         """
         :param layout: A GridLayout object representing the domain in which particles are
-        :param data: dataset containing particles
+        :param data: dataset containing particles, or a function returning it, called on first
+                     access to the dataset
         """
         super().__init__(layout, 'particles')
-        self.dataset = data
+        self._dataset = None if callable(data) else data
+        self._load_dataset = data if callable(data) else None
         self.pop_name = pop_name
         self.name = pop_name
         self.ndim = layout.box.ndim
@@ -179,6 +182,13 @@ class ParticleData(PatchData):
         assert (self.box.lower == self.ghost_box.lower + self.ghosts_nbr).all()
 
 
+    @property
+    def dataset(self):
+        if self._dataset is None:
+            self._dataset = self._load_dataset()
+        return self._dataset
+
+
     def select(self, box):
         return self.dataset[box]
 
@@ -523,6 +533,60 @@ def finest_part_data(hierarchy, time=None):
 
 
 
+class TimeIndex(MutableMapping):
+    """
+    the patch levels of a hierarchy per time, as a dict
+    times can be indexed with a function building their patch levels, which is only called when
+    the time is first accessed. Further functions indexed for the same time are given the patch
+    levels built by the previous ones, to add data to them.
+    """
+
+    def __init__(self):
+        self.patch_levels = {} # in time insertion order, None until built
+        self.builders = {}
+
+    def index(self, time, build):
+        """
+        build: function taking the patch levels of the time built so far, or None, and returning
+               the patch levels of the time
+        """
+        if self.is_built(time):
+            self.patch_levels[time] = build(self.patch_levels[time])
+        else:
+            self.patch_levels.setdefault(time, None)
+            self.builders.setdefault(time, []).append(build)
+
+    def is_built(self, time):
+        return time in self.patch_levels and time not in self.builders
+
+    def __getitem__(self, time):
+        if time in self.builders:
+            patch_levels = None
+            for build in self.builders.pop(time):
+                patch_levels = build(patch_levels)
+            self.patch_levels[time] = patch_levels
+        return self.patch_levels[time]
+
+    def __setitem__(self, time, patch_levels):
+        self.builders.pop(time, None)
+        self.patch_levels[time] = patch_levels
+
+    def __delitem__(self, time):
+        del self.patch_levels[time]
+        self.builders.pop(time, None)
+
+    def __contains__(self, time): # without building the time
+        return time in self.patch_levels
+
+    def __iter__(self):
+        return iter(self.patch_levels)
+
+    def __len__(self):
+        return len(self.patch_levels)
+
+
+
+
 class PatchHierarchy:
     """is a collection of patch levels """
 
@@ -530,7 +594,7 @@ class PatchHierarchy:
     def __init__(self, patch_levels, domain_box, refinement_ratio=2, time=0., data_files=None):
         self.patch_levels = patch_levels
         self.ndim = len(domain_box.lower)
-        self.time_hier = {}
+        self.time_hier = TimeIndex()
         self.time_hier.update({self.format_timestamp(time):patch_levels})
 
         self.domain_box = domain_box
@@ -1081,28 +1145,86 @@ def pop_name(basename):
 
 
 
+class LazyDataset:
+    """
+    a dataset of a h5py file, or consecutive rows of it reshaped to a given shape, only read when
+    its data is first accessed. Uncompressed contiguous datasets are memory mapped instead of read,
+    copy on write: the data can be modified, the file is not.
+    """
+
+    def __init__(self, h5_dataset, rows=None, shape=None):
+        self.h5_dataset = h5_dataset
+        self.rows = rows
+        self.shape = tuple(h5_dataset.shape if shape is None else shape)
+        self.dtype = h5_dataset.dtype
+        self._data = None
+
+    @property
+    def ndim(self):
+        return len(self.shape)
+
+    @property
+    def size(self):
+        return int(np.prod(self.shape))
+
+    @property
+    def data(self):
+        if self._data is None:
+            self._data = self._read()
+        return self._data
+
+    def is_memory_mappable(self):
+        ds = self.h5_dataset
+        # filters, compression included, need chunks
+        return ds.size > 0 and ds.chunks is None and ds.external is None \
+            and ds.id.get_offset() is not None
+
+    def _read(self):
+        ds = self.h5_dataset
+        rows = slice(None) if self.rows is None else self.rows
+        if self.is_memory_mappable():
+            data = np.memmap(ds.file.filename, dtype=ds.dtype, mode="c",
+                             offset=ds.id.get_offset(), shape=ds.shape)[rows]
+        else:
+            data = ds[()] if self.rows is None else ds[rows]
+        return data.reshape(self.shape)
+
+    def __getitem__(self, key):
+        return self.data[key]
+
+    def __array__(self, dtype=None):
+        return np.asarray(self.data, dtype=dtype)
+
+    def __len__(self):
+        return self.shape[0]
+
+
+
+
 def add_to_patchdata(patch_datas, h5_patch_grp, basename, layout):
     """
     adds data in the h5_patch_grp in the given PatchData dict
+    datasets are not read, see LazyDataset and ParticleData
     returns True if valid h5 patch found
     """
 
     if is_particle_file(basename):
 
-        v = np.asarray(h5_patch_grp["v"])
-        s = v.size
-        v = v[:].reshape(int(s / 3), 3)
-        nbrParts = v.shape[0]
-        dl = np.zeros((nbrParts, layout.ndim))
-        for i in range(layout.ndim):
-            dl[:,i] = layout.dl[i]
-
-        particles = Particles(icells=h5_patch_grp["iCell"],
-                              deltas=h5_patch_grp["delta"],
-                              v=v,
-                              weights=h5_patch_grp["weight"],
-                              charges=h5_patch_grp["charge"],
-                              dl=dl)
+        def particles():
+            v = np.asarray(h5_patch_grp["v"])
+            s = v.size
+            v = v[:].reshape(int(s / 3), 3)
+            nbrParts = v.shape[0]
+            dl = np.zeros((nbrParts, layout.ndim))
+            for i in range(layout.ndim):
+                dl[:,i] = layout.dl[i]
+
+            return Particles(icells=h5_patch_grp["iCell"],
+                             deltas=h5_patch_grp["delta"],
+                             v=v,
+                             weights=h5_patch_grp["weight"],
+                             charges=h5_patch_grp["charge"],
+                             dl=dl)
 
         pdname = particle_dataset_name(basename)
         if pdname in patch_datas:
@@ -1114,6 +1236,8 @@ def add_to_patchdata(patch_datas, h5_patch_grp, basename, layout):
         for dataset_name in h5_patch_grp.keys():
 
             dataset = h5_patch_grp[dataset_name]
+            if not isinstance(dataset, LazyDataset):
+                dataset = LazyDataset(dataset)
 
             if dataset_name not in field_qties:
                 raise RuntimeError(
@@ -1143,141 +1267,201 @@ def patch_has_datasets(h5_patch_grp):
 
 
 
-h5_time_grp_key = "t"
+aggregated_index_key = "patches"
 
 
 
 
-def hierarchy_fromh5(h5_filename, time, hier, silent=True):
-    import h5py
-    data_file = h5py.File(h5_filename, "r")
-    basename = os.path.basename(h5_filename)
+class AggregatedPatchGroup:
+    """
+    one patch of a level written with the "aggregated" diagnostic layout,
+    seen as the h5py group of a patch written with the default layout:
+    datasets are the slices of the level datasets belonging to the patch
+    """
+    def __init__(self, h5_lvl_grp, index, ipatch):
+        self.name = h5_lvl_grp.name + "/p" + str(ipatch)
+        self.attrs = {key: index[key][ipatch] for key in ("origin", "lower", "upper")}
+        self.h5_lvl_grp = h5_lvl_grp
+        self.slices = {}
+        for dataset_name in h5_lvl_grp.keys():
+            if dataset_name == aggregated_index_key:
+                continue
+            offset = int(index[dataset_name + "_offset"][ipatch])
+            shape = tuple(int(n) for n in index[dataset_name + "_shape"][ipatch])
+            self.slices[dataset_name] = (offset, shape)
 
-    root_cell_width = np.asarray(data_file.attrs["cell_width"])
-    interp = data_file.attrs["interpOrder"]
-    domain_box = Box([0] * len(data_file.attrs["domain_box"]), data_file.attrs["domain_box"])
+    def keys(self):
+        return self.slices.keys()
 
-    if create_from_all_times(time, hier):
-        # first create from first time
-        # then add all other times
-        if not silent:
-            print("creating hierarchy from all times in file")
-        times = list(data_file[h5_time_grp_key].keys())
-        hier = hierarchy_fromh5(h5_filename, time=times[0], hier=hier)
-        if len(times) > 1:
-            for t in times[1:]:
-                hierarchy_fromh5(h5_filename, t, hier)
-        return hier
+    def __getitem__(self, dataset_name):
+        # offsets count rows of the level dataset, values for fields, particles for particles
+        offset, shape = self.slices[dataset_name]
+        dataset = self.h5_lvl_grp[dataset_name]
+        nbr_rows = int(np.prod(shape)) // int(np.prod(dataset.shape[1:]))
+        return LazyDataset(dataset, slice(offset, offset + nbr_rows), shape)
 
-    if create_from_one_time(time, hier):
-        if not silent:
-            print("creating hierarchy from time {}".format(time))
-        t = time
 
-        h5_time_grp = data_file[h5_time_grp_key][time]
-        patch_levels = {}
 
-        for plvl_key in h5_time_grp.keys():
 
-            h5_patch_lvl_grp = h5_time_grp[plvl_key]
-            ilvl = int(plvl_key[2:])
-            lvl_cell_width = root_cell_width / refinement_ratio ** ilvl
-            patches = {}
-
-            for pkey in h5_patch_lvl_grp.keys():
+class AggregatedPatchLevelGroup:
+    """
+    a level written with the "aggregated" diagnostic layout,
+    seen as the h5py group of a level written with the default layout
+    patches are named after their position in the index table of the level
+    """
+    def __init__(self, h5_lvl_grp):
+        h5_index = h5_lvl_grp[aggregated_index_key]
+        index = {key: h5_index[key][:] for key in h5_index.keys()}
+        self.patch_grps = {
+            "p" + str(ipatch): AggregatedPatchGroup(h5_lvl_grp, index, ipatch)
+            for ipatch in range(len(index["lower"]))
+        }
 
-                h5_patch_grp = h5_patch_lvl_grp[pkey]
+    def keys(self):
+        return self.patch_grps.keys()
 
-                if patch_has_datasets(h5_patch_grp):
-                    patch_datas = {}
-                    layout = make_layout(h5_patch_grp, lvl_cell_width, interp)
-                    add_to_patchdata(patch_datas, h5_patch_grp, basename, layout)
+    def __getitem__(self, pkey):
+        return self.patch_grps[pkey]
 
-                    if ilvl not in patches:
-                        patches[ilvl] = []
 
-                    patches[ilvl].append(Patch(patch_datas, h5_patch_grp.name.split("/")[-1]))
 
-                    patch_levels[ilvl] = PatchLevel(ilvl, patches[ilvl])
 
-        diag_hier = PatchHierarchy(patch_levels, domain_box, refinement_ratio, t, data_file)
+def is_aggregated_layout(data_file):
+    layout = data_file.attrs.get("layout", "patches")
+    if isinstance(layout, bytes):
+        layout = layout.decode()
+    return layout == "aggregated"
 
-        return diag_hier
 
-    if load_one_time(time, hier):
-        if not silent:
-            print("loading data at time {} into existing hierarchy".format(time))
-        h5_time_grp = data_file[h5_time_grp_key][time]
-        t = time
 
-        if t in hier.time_hier:
-            if not silent:
-                print("time already exist, adding data...")
 
-            # time already exists in the hierarchy
-            # all we need to do is adding the data
-            # as patchDatas in the appropriate patches
-            # and levels, if data compatible with hierarchy
+def patch_level_group(data_file, h5_lvl_grp):
+    if is_aggregated_layout(data_file):
+        return AggregatedPatchLevelGroup(h5_lvl_grp)
+    return h5_lvl_grp
 
-            patch_levels = hier.time_hier[t]
 
-            for plvl_key in h5_time_grp.keys():
-                ilvl = int(plvl_key[2:])
-                lvl_cell_width = root_cell_width / refinement_ratio ** ilvl
 
-                for ipatch, pkey in enumerate(h5_time_grp[plvl_key].keys()):
-                    h5_patch_grp = h5_time_grp[plvl_key][pkey]
 
-                    if patch_has_datasets(h5_patch_grp):
-                        hier_patch = patch_levels[ilvl].patches[ipatch]
-                        origin = h5_time_grp[plvl_key][pkey].attrs['origin']
-                        upper = h5_time_grp[plvl_key][pkey].attrs['upper']
-                        lower = h5_time_grp[plvl_key][pkey].attrs['lower']
-                        file_patch_box = Box(lower, upper)
+h5_time_grp_key = "t"
 
-                        assert file_patch_box == hier_patch.box
-                        assert (abs(origin - hier_patch.origin) < 1e-6).all()
-                        assert (abs(lvl_cell_width - hier_patch.dl) < 1e-6).all()
 
-                        layout = make_layout(h5_patch_grp, lvl_cell_width, interp)
-                        add_to_patchdata(hier_patch.patch_datas, h5_patch_grp, basename, layout)
 
-            return hier
 
-        if not silent:
-            print("adding data to new time")
-        # time does not exist in the hierarchy
-        # we have to create a brand new set of patchLevels
-        # containing patches, and load data in their patchdatas
+def patch_levels_fromh5(data_file, time, patch_levels=None):
+    """
+    returns the patch levels of the h5py file at the given time, built from the metadata of its
+    patches, datasets are not read (see add_to_patchdata)
+    if patch_levels are given, the data of the file is added to their patches
+    """
+    basename = os.path.basename(data_file.filename)
+    root_cell_width = np.asarray(data_file.attrs["cell_width"])
+    interp = data_file.attrs["interpOrder"]
+    h5_time_grp = data_file[h5_time_grp_key][time]
 
-        patch_levels = {}
+    if patch_levels is not None:
+        # time already exists in the hierarchy
+        # all we need to do is adding the data
+        # as patchDatas in the appropriate patches
+        # and levels, if data compatible with hierarchy
 
         for plvl_key in h5_time_grp.keys():
             ilvl = int(plvl_key[2:])
-
             lvl_cell_width = root_cell_width / refinement_ratio ** ilvl
-            lvl_patches = []
+            h5_patch_lvl_grp = patch_level_group(data_file, h5_time_grp[plvl_key])
 
-            for ipatch, pkey in enumerate(h5_time_grp[plvl_key].keys()):
-                h5_patch_grp = h5_time_grp[plvl_key][pkey]
+            for ipatch, pkey in enumerate(h5_patch_lvl_grp.keys()):
+                h5_patch_grp = h5_patch_lvl_grp[pkey]
 
                 if patch_has_datasets(h5_patch_grp):
+                    hier_patch = patch_levels[ilvl].patches[ipatch]
+                    origin = h5_patch_grp.attrs['origin']
+                    upper = h5_patch_grp.attrs['upper']
+                    lower = h5_patch_grp.attrs['lower']
+                    file_patch_box = Box(lower, upper)
+
+                    assert file_patch_box == hier_patch.box
+                    assert (abs(origin - hier_patch.origin) < 1e-6).all()
+                    assert (abs(lvl_cell_width - hier_patch.dl) < 1e-6).all()
+
                     layout = make_layout(h5_patch_grp, lvl_cell_width, interp)
-                    patch_datas = {}
-                    add_to_patchdata(patch_datas, h5_patch_grp, basename, layout)
-                    lvl_patches.append(Patch(patch_datas))
+                    add_to_patchdata(hier_patch.patch_datas, h5_patch_grp, basename, layout)
+
+        return patch_levels
+
+    patch_levels = {}
+
+    for plvl_key in h5_time_grp.keys():
+
+        h5_patch_lvl_grp = patch_level_group(data_file, h5_time_grp[plvl_key])
+        ilvl = int(plvl_key[2:])
+        lvl_cell_width = root_cell_width / refinement_ratio ** ilvl
+        patches = {}
+
+        for pkey in h5_patch_lvl_grp.keys():
+
+            h5_patch_grp = h5_patch_lvl_grp[pkey]
+
+            if patch_has_datasets(h5_patch_grp):
+                patch_datas = {}
+                layout = make_layout(h5_patch_grp, lvl_cell_width, interp)
+                add_to_patchdata(patch_datas, h5_patch_grp, basename, layout)
 
-            patch_levels[ilvl] = PatchLevel(ilvl, lvl_patches)
+                if ilvl not in patches:
+                    patches[ilvl] = []
 
-        hier.time_hier[t] = patch_levels
+                patches[ilvl].append(Patch(patch_datas, h5_patch_grp.name.split("/")[-1]))
+
+                patch_levels[ilvl] = PatchLevel(ilvl, patches[ilvl])
+
+    return patch_levels
+
+
+
+
+def hierarchy_fromh5(h5_filename, time, hier, silent=True):
+    """
+    times of the file are only indexed, their patch levels are built when first accessed (see
+    TimeIndex), except for the first time of a new hierarchy. Datasets are read when accessed.
+    """
+    import h5py
+    data_file = h5py.File(h5_filename, "r")
+
+    domain_box = Box([0] * len(data_file.attrs["domain_box"]), data_file.attrs["domain_box"])
+
+    def patch_levels_at(t):
+        return lambda patch_levels: patch_levels_fromh5(data_file, t, patch_levels)
+
+    if create_from_all_times(time, hier):
+        # first create from first time
+        # then index all other times
+        if not silent:
+            print("creating hierarchy from all times in file")
+        times = list(data_file[h5_time_grp_key].keys())
+        hier = PatchHierarchy(patch_levels_fromh5(data_file, times[0]), domain_box,
+                              refinement_ratio, times[0], data_file)
+        for t in times[1:]:
+            hier.time_hier.index(t, patch_levels_at(t))
+        return hier
+
+    if create_from_one_time(time, hier):
+        if not silent:
+            print("creating hierarchy from time {}".format(time))
+        return PatchHierarchy(patch_levels_fromh5(data_file, time), domain_box, refinement_ratio,
+                              time, data_file)
+
+    if load_one_time(time, hier):
+        if not silent:
+            print("loading data at time {} into existing hierarchy".format(time))
+        # data is added to the patch levels of the time if it exists, else they are created
+        hier.time_hier.index(time, patch_levels_at(time))
         return hier
 
     if load_all_times(time, hier):
         if not silent:
             print("loading all times in existing hier")
-        for time in data_file[h5_time_grp_key].keys():
-            hier = hierarchy_fromh5(h5_filename, time, hier)
-
+        for t in data_file[h5_time_grp_key].keys():
+            hier.time_hier.index(t, patch_levels_at(t))
         return hier
 
 
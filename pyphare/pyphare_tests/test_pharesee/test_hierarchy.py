@@ -0,0 +1,129 @@
+import os
+import tempfile
+import unittest
+
+import h5py
+import numpy as np
+
+from pyphare.pharesee.hierarchy import hierarchy_fromh5, LazyDataset
+
+
+times = ["0.0000000000", "0.1000000000", "0.2000000000"]
+patch_boxes = [([0], [4]), ([5], [9])]
+
+
+def field_values(itime, ipatch):
+    return np.arange(8.0) + 100 * itime + 10 * ipatch
+
+
+def particle_nbr(itime, ipatch):
+    return 3 + itime + ipatch
+
+
+def write_file(path, field_name="EM_B_x", compression=None):
+    """a 1D diagnostic file with two patches per time, as written by PHARE"""
+    chunks = True if compression else None
+    with h5py.File(path, "w") as h5file:
+        h5file.attrs["cell_width"] = [0.1]
+        h5file.attrs["interpOrder"] = 1
+        h5file.attrs["domain_box"] = [9]
+        for itime, time in enumerate(times):
+            for ipatch, (lower, upper) in enumerate(patch_boxes):
+                h5_patch_grp = h5file.create_group(f"t/{time}/pl0/p0#{ipatch}")
+                h5_patch_grp.attrs["origin"] = [0.1 * lower[0]]
+                h5_patch_grp.attrs["lower"] = lower
+                h5_patch_grp.attrs["upper"] = upper
+                if "domain" in os.path.basename(path):
+                    nbr = particle_nbr(itime, ipatch)
+                    h5_patch_grp.create_dataset("iCell", data=np.full((nbr, 1), lower[0]))
+                    h5_patch_grp.create_dataset("delta", data=np.full((nbr, 1), 0.5))
+                    h5_patch_grp.create_dataset("v", data=np.ones(nbr * 3))
+                    h5_patch_grp.create_dataset("weight", data=np.ones(nbr))
+                    h5_patch_grp.create_dataset("charge", data=np.ones(nbr))
+                else:
+                    h5_patch_grp.create_dataset(
+                        field_name,
+                        data=field_values(itime, ipatch),
+                        chunks=chunks,
+                        compression=compression,
+                    )
+
+
+class HierarchyTest(unittest.TestCase):
+    def setUp(self):
+        self.tmp_dir = tempfile.TemporaryDirectory()
+
+    def tearDown(self):
+        self.tmp_dir.cleanup()
+
+    def file_path(self, name, **kwargs):
+        path = os.path.join(self.tmp_dir.name, name)
+        write_file(path, **kwargs)
+        return path
+
+    def test_times_are_indexed_and_built_when_accessed(self):
+        hier = hierarchy_fromh5(self.file_path("EM_B.h5"), None, None)
+
+        self.assertEqual(list(hier.time_hier.keys()), times)
+        self.assertTrue(hier.time_hier.is_built(times[0]))
+        for time in times[1:]:
+            self.assertIn(time, hier.time_hier)
+            self.assertFalse(hier.time_hier.is_built(time))
+
+        patches = hier.level(0, time=times[2]).patches
+        self.assertTrue(hier.time_hier.is_built(times[2]))
+        self.assertFalse(hier.time_hier.is_built(times[1]))
+        self.assertEqual(list(hier.time_hier.keys()), times)
+        for ipatch, (lower, upper) in enumerate(patch_boxes):
+            self.assertEqual(patches[ipatch].box.lower[0], lower[0])
+            self.assertEqual(patches[ipatch].box.upper[0], upper[0])
+
+    def test_field_datasets_are_read_when_accessed(self):
+        hier = hierarchy_fromh5(self.file_path("EM_B.h5"), None, None)
+
+        for itime, time in enumerate(times):
+            for ipatch, patch in enumerate(hier.level(0, time=time).patches):
+                dataset = patch.patch_datas["Bx"].dataset
+                self.assertIsInstance(dataset, LazyDataset)
+                self.assertIsNone(dataset._data)
+                self.assertEqual(dataset.shape, (8,))
+                np.testing.assert_array_equal(dataset[:], field_values(itime, ipatch))
+                self.assertIsInstance(dataset.data, np.memmap)
+
+    def test_compressed_datasets_are_not_memory_mapped(self):
+        hier = hierarchy_fromh5(self.file_path("EM_B.h5", compression="gzip"), None, None)
+
+        dataset = hier.level(0).patches[1].patch_datas["Bx"].dataset
+        self.assertFalse(dataset.is_memory_mappable())
+        np.testing.assert_array_equal(dataset[:], field_values(0, 1))
+        self.assertNotIsInstance(dataset.data, np.memmap)
+
+    def test_particles_are_read_when_accessed(self):
+        path = self.file_path("ions_pop_protons_domain.h5")
+        hier = hierarchy_fromh5(path, times[1], None)
+
+        for ipatch, patch in enumerate(hier.level(0, time=times[1]).patches):
+            pdata = patch.patch_datas["protons_domain"]
+            self.assertIsNone(pdata._dataset)
+            self.assertEqual(pdata.size(), particle_nbr(1, ipatch))
+            self.assertIsNotNone(pdata._dataset)
+
+    def test_data_of_other_files_is_added_when_accessed(self):
+        hier = hierarchy_fromh5(self.file_path("EM_B.h5"), None, None)
+        hier = hierarchy_fromh5(self.file_path("EM_E.h5", field_name="EM_E_x"), None, hier)
+
+        # the first time was built, data is added to it at once
+        self.assertIn("Ex", hier.level(0, time=times[0]).patches[0].patch_datas)
+        self.assertFalse(hier.time_hier.is_built(times[1]))
+
+        for itime, time in enumerate(times):
+            for ipatch, patch in enumerate(hier.level(0, time=time).patches):
+                self.assertEqual(sorted(patch.patch_datas.keys()), ["Bx", "Ex"])
+                for name in ["Bx", "Ex"]:
+                    np.testing.assert_array_equal(
+                        patch.patch_datas[name].dataset[:], field_values(itime, ipatch)
+                    )
+
+
+if __name__ == "__main__":
+    unittest.main()
@@ -111,6 +111,7 @@ if (test AND ${PHARE_EXEC_LEVEL_MIN} GREATER 0) # 0 = no tests
     set_property(TEST ${binary}        PROPERTY ENVIRONMENT "PYTHONPATH=${PHARE_PYTHONPATH}")
     # ASAN detects leaks by default, even in system/third party libraries
     set_property(TEST ${binary} APPEND PROPERTY ENVIRONMENT "ASAN_OPTIONS=detect_leaks=0")
+    set_property(TEST ${binary} APPEND PROPERTY ENVIRONMENT "PHARE_DIAG_PRECISION=${PHARE_TEST_DIAG_PRECISION}")
   endfunction(set_exe_paths_)
 
   function(add_phare_test_ binary directory)
@@ -78,6 +78,11 @@ if (NOT DEFINED PHARE_EXEC_LEVEL_MAX)
   set(PHARE_EXEC_LEVEL_MAX 10)
 endif()
 
+# -DPHARE_TEST_DIAG_PRECISION=double
+set(PHARE_TEST_DIAG_PRECISION "double" CACHE STRING "Default diagnostics precision of python tests")
+# Python tests compare outputs at machine precision, their diagnostics default to doubles
+# via the PHARE_DIAG_PRECISION environment variable, "float" tests the default of simulations
+
 # -Dbench=OFF
 option(bench "Compile PHARE Benchmarks" OFF)
 
@@ -98,6 +103,7 @@ function(print_phare_options)
   message("build with ubsan support                    : " ${ubsan})
   message("build with asan support                     : " ${asan})
   message("build with ccache (if found) in devMode     : " ${withCcache})
+  message("default diagnostics precision of py tests   : " ${PHARE_TEST_DIAG_PRECISION})
   message("build with LLNL Caliper                     : " ${withCaliper})
 
   if(${devMode})
@@ -14,6 +14,7 @@ if (test AND ${PHARE_EXEC_LEVEL_MIN} GREATER 0) # 0 = no tests
   add_subdirectory(tests/core/data/particles)
   add_subdirectory(tests/core/data/ions)
   add_subdirectory(tests/core/data/electrons)
+  add_subdirectory(tests/core/data/electromag)
   add_subdirectory(tests/core/data/ion_population)
   add_subdirectory(tests/core/data/maxwellian_particle_initializer)
   add_subdirectory(tests/core/data/particle_initializer)
@@ -22,6 +23,7 @@ if (test AND ${PHARE_EXEC_LEVEL_MIN} GREATER 0) # 0 = no tests
   add_subdirectory(tests/core/utilities/index)
   add_subdirectory(tests/core/utilities/indexer)
   add_subdirectory(tests/core/utilities/cellmap)
+  add_subdirectory(tests/core/utilities/timestamps)
   #add_subdirectory(tests/core/numerics/boundary_condition)
   add_subdirectory(tests/core/numerics/interpolator)
   add_subdirectory(tests/core/numerics/pusher)
@@ -29,6 +31,9 @@ if (test AND ${PHARE_EXEC_LEVEL_MIN} GREATER 0) # 0 = no tests
   add_subdirectory(tests/core/numerics/faraday)
   add_subdirectory(tests/core/numerics/ohm)
   add_subdirectory(tests/core/numerics/ion_updater)
+  add_subdirectory(tests/core/numerics/particle_merger)
+  add_subdirectory(tests/core/numerics/reduction)
+  add_subdirectory(tests/core/numerics/time_step)
 
 
   add_subdirectory(tests/initializer)
@@ -44,9 +49,11 @@ if (test AND ${PHARE_EXEC_LEVEL_MIN} GREATER 0) # 0 = no tests
   add_subdirectory(tests/amr/data/field/time_interpolate)
   add_subdirectory(tests/amr/resources_manager)
   add_subdirectory(tests/amr/messengers)
+  add_subdirectory(tests/amr/messengers/particle_migration)
   add_subdirectory(tests/amr/models)
   add_subdirectory(tests/amr/multiphysics_integrator)
   add_subdirectory(tests/amr/tagging)
+  add_subdirectory(tests/amr/tagging/hysteresis)
 
   add_subdirectory(tests/diagnostic)
 
@@ -95,6 +95,17 @@ namespace amr
         }
 
 
+        /** @brief fine start index along a single direction for the given coarse index
+         */
+        int computeStartIndex(int const coarseIndex, std::size_t const iDir) const
+        {
+            return coarseIndex * ratio_(iDir) + shifts_[iDir];
+        }
+
+
+        int ratio(std::size_t const iDir) const { return ratio_(iDir); }
+
+
         std::vector<double> const& weights(core::Direction dir) const
         {
             return weighters_[static_cast<std::size_t>(dir)].weights();
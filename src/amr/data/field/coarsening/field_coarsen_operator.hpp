@@ -130,64 +130,8 @@ namespace amr
             FieldCoarsener<dimension> coarsener{destinationLayout.centering(qty), sourceBox,
                                                 destinationBox, ratio};
 
-            // now we can loop over the intersection box
-
-            core::Point<int, dimension> startIndex;
-            core::Point<int, dimension> endIndex;
-
-            startIndex[dirX] = intersectionBox.lower(dirX);
-            endIndex[dirX]   = intersectionBox.upper(dirX);
-
-            if constexpr (dimension > 1)
-            {
-                startIndex[dirY] = intersectionBox.lower(dirY);
-                endIndex[dirY]   = intersectionBox.upper(dirY);
-            }
-            if constexpr (dimension > 2)
-            {
-                startIndex[dirZ] = intersectionBox.lower(dirZ);
-                endIndex[dirZ]   = intersectionBox.upper(dirZ);
-            }
-
-            if constexpr (dimension == 1)
-            {
-                for (int ix = startIndex[dirX]; ix <= endIndex[dirX]; ++ix)
-                {
-                    coarsener(sourceField, destinationField, {{ix}});
-                }
-            }
-
-
-
-
-            else if constexpr (dimension == 2)
-            {
-                for (int ix = startIndex[dirX]; ix <= endIndex[dirX]; ++ix)
-                {
-                    for (int iy = startIndex[dirY]; iy <= endIndex[dirY]; ++iy)
-                    {
-                        coarsener(sourceField, destinationField, {{ix, iy}});
-                    }
-                }
-            }
-
-
-
-
-            else if constexpr (dimension == 3)
-            {
-                for (int ix = startIndex[dirX]; ix <= endIndex[dirX]; ++ix)
-                {
-                    for (int iy = startIndex[dirY]; iy <= endIndex[dirY]; ++iy)
-                    {
-                        for (int iz = startIndex[dirZ]; iz <= endIndex[dirZ]; ++iz)
-
-                        {
-                            coarsener(sourceField, destinationField, {{ix, iy, iz}});
-                        }
-                    }
-                }
-            } // end 3D
+            // and coarsen the whole intersection box at once
+            coarsener.coarsenBox(sourceField, destinationField, intersectionBox);
         }
     };
 } // namespace amr
@@ -12,6 +12,7 @@
 
 #include <cstddef>
 #include <array>
+#include <vector>
 
 
 
@@ -140,6 +141,136 @@ namespace amr
 
 
 
+        /** @brief coarsens the fineField onto all the coarse indexes of coarseBox (in AMR index
+         * space)
+         *
+         * This computes the same values as operator() called on each index of the box. Fine start
+         * indexes advance by the ratio from one coarse index to the next, so they are computed once
+         * per box, and pointers to the fine rows under the stencil are computed once per coarse row
+         * rather than going through AMRToLocal and the field index operator at each point.
+         */
+        template<typename FieldT>
+        void coarsenBox(FieldT const& fineField, FieldT& coarseField,
+                        SAMRAI::hier::Box const& coarseBox) const
+        {
+            TBOX_ASSERT(fineField.physicalQuantity() == coarseField.physicalQuantity());
+
+            if (coarseBox.empty())
+                return;
+
+            std::array<int, dimension> fineStart, coarseStart, ratio, nbrCoarse;
+            for (std::size_t iDir = dirX; iDir < dimension; ++iDir)
+            {
+                fineStart[iDir]
+                    = indexesAndWeights_.computeStartIndex(coarseBox.lower(iDir), iDir)
+                      - sourceBox_.lower(iDir);
+                coarseStart[iDir] = coarseBox.lower(iDir) - destinationBox_.lower(iDir);
+                ratio[iDir]       = indexesAndWeights_.ratio(iDir);
+                nbrCoarse[iDir]   = coarseBox.upper(iDir) - coarseBox.lower(iDir) + 1;
+            }
+
+            auto const& xWeights = indexesAndWeights_.weights(core::Direction::X);
+
+            if constexpr (dimension == 1)
+            {
+                auto const* fine = &fineField(0);
+                auto* coarse     = &coarseField(coarseStart[dirX]);
+
+                for (int ix = 0; ix < nbrCoarse[dirX]; ++ix)
+                {
+                    auto const* stencil = fine + fineStart[dirX] + ix * ratio[dirX];
+
+                    double coarseValue = 0.;
+                    for (std::size_t iShiftX = 0; iShiftX < xWeights.size(); ++iShiftX)
+                        coarseValue += stencil[iShiftX] * xWeights[iShiftX];
+
+                    coarse[ix] = coarseValue;
+                }
+            }
+
+            else if constexpr (dimension == 2)
+            {
+                auto const& yWeights = indexesAndWeights_.weights(core::Direction::Y);
+                std::vector<double const*> rows(xWeights.size());
+
+                for (int ix = 0; ix < nbrCoarse[dirX]; ++ix)
+                {
+                    auto const fx = fineStart[dirX] + ix * ratio[dirX];
+                    for (std::size_t iShiftX = 0; iShiftX < xWeights.size(); ++iShiftX)
+                        rows[iShiftX] = &fineField(fx + iShiftX, 0);
+
+                    auto* coarse = &coarseField(coarseStart[dirX] + ix, coarseStart[dirY]);
+
+                    for (int iy = 0; iy < nbrCoarse[dirY]; ++iy)
+                    {
+                        auto const fy = fineStart[dirY] + iy * ratio[dirY];
+
+                        double coarseValue = 0.;
+                        for (std::size_t iShiftX = 0; iShiftX < xWeights.size(); ++iShiftX)
+                        {
+                            double Yinterp = 0.;
+                            for (std::size_t iShiftY = 0; iShiftY < yWeights.size(); ++iShiftY)
+                                Yinterp += rows[iShiftX][fy + iShiftY] * yWeights[iShiftY];
+
+                            coarseValue += Yinterp * xWeights[iShiftX];
+                        }
+                        coarse[iy] = coarseValue;
+                    }
+                }
+            }
+
+            else if constexpr (dimension == 3)
+            {
+                auto const& yWeights = indexesAndWeights_.weights(core::Direction::Y);
+                auto const& zWeights = indexesAndWeights_.weights(core::Direction::Z);
+                auto const nbrShiftY = yWeights.size();
+                std::vector<double const*> rows(xWeights.size() * nbrShiftY);
+
+                for (int ix = 0; ix < nbrCoarse[dirX]; ++ix)
+                {
+                    auto const fx = fineStart[dirX] + ix * ratio[dirX];
+
+                    for (int iy = 0; iy < nbrCoarse[dirY]; ++iy)
+                    {
+                        auto const fy = fineStart[dirY] + iy * ratio[dirY];
+                        for (std::size_t iShiftX = 0; iShiftX < xWeights.size(); ++iShiftX)
+                            for (std::size_t iShiftY = 0; iShiftY < nbrShiftY; ++iShiftY)
+                                rows[iShiftX * nbrShiftY + iShiftY]
+                                    = &fineField(fx + iShiftX, fy + iShiftY, 0);
+
+                        auto* coarse = &coarseField(coarseStart[dirX] + ix,
+                                                    coarseStart[dirY] + iy, coarseStart[dirZ]);
+
+                        for (int iz = 0; iz < nbrCoarse[dirZ]; ++iz)
+                        {
+                            auto const fz = fineStart[dirZ] + iz * ratio[dirZ];
+
+                            double coarseValue = 0.;
+                            for (std::size_t iShiftX = 0; iShiftX < xWeights.size(); ++iShiftX)
+                            {
+                                double Yinterp = 0.;
+                                for (std::size_t iShiftY = 0; iShiftY < nbrShiftY; ++iShiftY)
+                                {
+                                    auto const* row = rows[iShiftX * nbrShiftY + iShiftY] + fz;
+
+                                    double Zinterp = 0.;
+                                    for (std::size_t iShiftZ = 0; iShiftZ < zWeights.size();
+                                         ++iShiftZ)
+                                        Zinterp += row[iShiftZ] * zWeights[iShiftZ];
+
+                                    Yinterp += Zinterp * yWeights[iShiftY];
+                                }
+                                coarseValue += Yinterp * xWeights[iShiftX];
+                            }
+                            coarse[iz] = coarseValue;
+                        }
+                    }
+                }
+            }
+        }
+
+
+
     private:
         //! precompute the indexes and weights to use to coarsen fine values onto a coarse node
         FieldCoarsenIndexesAndWeights<dimension> indexesAndWeights_;
@@ -11,6 +11,8 @@
 #include "amr/resources_manager/amr_utils.hpp"
 
 #include "field_geometry.hpp"
+#include "field_stream_encoding.hpp"
+#include "field_stream_plan.hpp"
 
 #include "core/logger.hpp"
 
@@ -219,40 +221,23 @@ namespace amr
         {
             PHARE_LOG_SCOPE("packStream");
 
-            // getDataStreamSize_<true> mean that we want to apply the transformation
-            std::size_t expectedSize = getDataStreamSize_<true>(overlap) / sizeof(double);
-            std::vector<typename FieldImpl::type> buffer;
-            buffer.reserve(expectedSize);
-
             auto& fieldOverlap = dynamic_cast<FieldOverlap const&>(overlap);
 
             SAMRAI::hier::Transformation const& transformation = fieldOverlap.getTransformation();
-            if (transformation.getRotation() == SAMRAI::hier::Transformation::NO_ROTATE)
-            {
-                SAMRAI::hier::BoxContainer const& boxContainer
-                    = fieldOverlap.getDestinationBoxContainer();
-                for (auto const& box : boxContainer)
-                {
-                    auto const& source = field;
-                    SAMRAI::hier::Box sourceBox
-                        = Geometry::toFieldBox(getBox(), quantity_, gridLayout);
+            if (transformation.getRotation() != SAMRAI::hier::Transformation::NO_ROTATE)
+                throw std::runtime_error("packStream with rotate not implemented");
 
-                    SAMRAI::hier::Box packBox{box};
+            // the plan is only computed the first time this overlap is packed, overlaps are
+            // rebuilt with the schedules at regrid
+            auto const key = planKey_();
+            auto& plan     = fieldOverlap.packPlan(key);
+            if (!plan.matches(key))
+                makePackPlan_(plan, fieldOverlap);
 
-                    // Since the transformation, allow to transform the source box,
-                    // into the destination box space, and that the box in the boxContainer
-                    // are in destination space, we have to use the inverseTransform
-                    // to get into source space
-                    transformation.inverseTransform(packBox);
-                    packBox = packBox * sourceBox;
-
-                    internals_.packImpl(buffer, source, packBox, sourceBox);
-                }
-            }
-            // throw, we don't do rotations in phare....
+            plan.gather(field.data());
 
             // Once we have fill the buffer, we send it on the stream
-            stream.pack(buffer.data(), buffer.size());
+            packEncoded_(stream, plan.buffer, fieldOverlap);
         }
 
 
@@ -266,42 +251,22 @@ namespace amr
         {
             PHARE_LOG_SCOPE("unpackStream");
 
-            // For unpacking we need to know how much element we will need to
-            // extract
-            std::size_t expectedSize = getDataStreamSize(overlap) / sizeof(double);
-
-            std::vector<double> buffer;
-            buffer.resize(expectedSize, 0.);
-
             auto& fieldOverlap = dynamic_cast<FieldOverlap const&>(overlap);
 
-            // We flush a portion of the stream on the buffer.
-            stream.unpack(buffer.data(), expectedSize);
-
             SAMRAI::hier::Transformation const& transformation = fieldOverlap.getTransformation();
-            if (transformation.getRotation() == SAMRAI::hier::Transformation::NO_ROTATE)
-            {
-                // Here the seek counter will be used to index buffer
-                std::size_t seek = 0;
-
-                SAMRAI::hier::BoxContainer const& boxContainer
-                    = fieldOverlap.getDestinationBoxContainer();
-                for (auto const& box : boxContainer)
-                {
-                    // For unpackStream, there is no transformation needed, since all the box
-                    // are on the destination space
-
-                    auto& source = field;
-                    SAMRAI::hier::Box destination
-                        = Geometry::toFieldBox(getBox(), quantity_, gridLayout);
-
+            if (transformation.getRotation() != SAMRAI::hier::Transformation::NO_ROTATE)
+                throw std::runtime_error("unpackStream with rotate not implemented");
 
-                    SAMRAI::hier::Box packBox{box * destination};
+            auto const key = planKey_();
+            auto& plan     = fieldOverlap.unpackPlan(key);
+            if (!plan.matches(key))
+                makeUnpackPlan_(plan, fieldOverlap);
 
+            // For unpacking we need to know how much element we will need to
+            // extract, we flush this portion of the stream on the buffer.
+            unpackEncoded_(stream, nbrStreamValues_(fieldOverlap), plan.buffer, fieldOverlap);
 
-                    internals_.unpackImpl(seek, buffer, source, packBox, destination);
-                }
-            }
+            plan.scatter(plan.buffer, field.data());
         }
 
 
@@ -445,10 +410,178 @@ namespace amr
 
             // TODO: see FieldDataFactory todo of the same function
 
-            SAMRAI::hier::BoxContainer const& boxContainer
-                = fieldOverlap.getDestinationBoxContainer();
+            return FieldStreamCodec::maxEncodedSize(fieldOverlap.streamEncoding(),
+                                                    nbrStreamValues_(fieldOverlap));
+        }
+
+
+
+        /*** \brief number of field values exchanged on the overlap, whatever the encoding
+         */
+        static std::size_t nbrStreamValues_(FieldOverlap const& fieldOverlap)
+        {
+            if (fieldOverlap.isOverlapEmpty())
+                return 0;
+
+            return fieldOverlap.getDestinationBoxContainer().getTotalSizeOfBoxes();
+        }
+
+
+
+        /** stream plans depend on the field shape and index space, i.e. on the quantity (its
+         * centering), the patch box and the ghost box
+         */
+        std::vector<int> planKey_() const
+        {
+            std::vector<int> key{static_cast<int>(quantity_)};
+            for (auto const& box : {getBox(), getGhostBox()})
+                for (std::size_t iDim = 0; iDim < dimension; ++iDim)
+                {
+                    key.push_back(box.lower(iDim));
+                    key.push_back(box.upper(iDim));
+                }
+            return key;
+        }
+
+
+
+        /*** \brief computes the segments of the field to pack for the overlap
+         *
+         * Since the transformation allows to transform the source box into the destination box
+         * space, and that the boxes in the boxContainer are in destination space, we have to use
+         * the inverseTransform to get into source space
+         */
+        void makePackPlan_(FieldStreamPlan& plan, FieldOverlap const& fieldOverlap) const
+        {
+            plan.reset(planKey_());
+
+            SAMRAI::hier::Box sourceBox = Geometry::toFieldBox(getBox(), quantity_, gridLayout);
+            SAMRAI::hier::Transformation const& transformation = fieldOverlap.getTransformation();
+
+            for (auto const& box : fieldOverlap.getDestinationBoxContainer())
+            {
+                SAMRAI::hier::Box packBox{box};
+                transformation.inverseTransform(packBox);
+                addToPlan_(plan, packBox * sourceBox, sourceBox);
+            }
+        }
+
+
+
+        /*** \brief computes the segments of the field to unpack for the overlap
+         *
+         * For unpacking, there is no transformation needed, since all the boxes are on the
+         * destination space
+         */
+        void makeUnpackPlan_(FieldStreamPlan& plan, FieldOverlap const& fieldOverlap) const
+        {
+            plan.reset(planKey_());
+
+            SAMRAI::hier::Box destination = Geometry::toFieldBox(getBox(), quantity_, gridLayout);
 
-            return boxContainer.getTotalSizeOfBoxes() * sizeof(typename FieldImpl::type);
+            for (auto const& box : fieldOverlap.getDestinationBoxContainer())
+                addToPlan_(plan, box * destination, destination);
+        }
+
+
+
+        void addToPlan_(FieldStreamPlan& plan, SAMRAI::hier::Box const& overlapBox,
+                        SAMRAI::hier::Box const& fieldBox) const
+        {
+            std::array<int, dimension> lower, upper;
+            for (std::size_t iDim = 0; iDim < dimension; ++iDim)
+            {
+                lower[iDim] = overlapBox.lower(iDim) - fieldBox.lower(iDim);
+                upper[iDim] = overlapBox.upper(iDim) - fieldBox.lower(iDim);
+            }
+            plan.addBox(lower, upper, field.shape());
+        }
+
+
+
+        /*** \brief put the buffer on the stream with the encoding of the overlap
+         *
+         * Delta encoded buffers have a variable size, so their size in bytes is sent first
+         */
+        static void packEncoded_(SAMRAI::tbox::MessageStream& stream,
+                                 std::vector<double> const& buffer,
+                                 FieldOverlap const& fieldOverlap)
+        {
+            // consistent with getDataStreamSize which is null for empty overlaps
+            if (fieldOverlap.isOverlapEmpty())
+                return;
+
+            std::size_t wireBytes = 0;
+
+            switch (fieldOverlap.streamEncoding())
+            {
+                case FieldStreamEncoding::Double:
+                {
+                    stream.pack(buffer.data(), buffer.size());
+                    wireBytes = buffer.size() * sizeof(double);
+                    break;
+                }
+                case FieldStreamEncoding::Float:
+                {
+                    std::vector<float> encoded;
+                    FieldStreamCodec::encodeFloat(buffer, encoded);
+                    stream.pack(encoded.data(), encoded.size());
+                    wireBytes = encoded.size() * sizeof(float);
+                    break;
+                }
+                case FieldStreamEncoding::Delta:
+                {
+                    std::vector<char> encoded;
+                    FieldStreamCodec::encodeDelta(buffer, encoded);
+                    std::uint64_t nbrBytes = encoded.size();
+                    stream.pack(&nbrBytes, 1);
+                    stream.pack(encoded.data(), encoded.size());
+                    wireBytes = sizeof(std::uint64_t) + encoded.size();
+                    break;
+                }
+            }
+
+            if (auto stats = fieldOverlap.streamStats(); stats)
+            {
+                stats->nbrPacks += 1;
+                stats->rawBytes += buffer.size() * sizeof(double);
+                stats->wireBytes += wireBytes;
+            }
+        }
+
+
+
+        static void unpackEncoded_(SAMRAI::tbox::MessageStream& stream, std::size_t nbrValues,
+                                   std::vector<double>& buffer, FieldOverlap const& fieldOverlap)
+        {
+            if (fieldOverlap.isOverlapEmpty())
+                return;
+
+            switch (fieldOverlap.streamEncoding())
+            {
+                case FieldStreamEncoding::Double:
+                {
+                    buffer.resize(nbrValues, 0.);
+                    stream.unpack(buffer.data(), nbrValues);
+                    break;
+                }
+                case FieldStreamEncoding::Float:
+                {
+                    std::vector<float> encoded(nbrValues);
+                    stream.unpack(encoded.data(), nbrValues);
+                    FieldStreamCodec::decodeFloat(encoded, buffer);
+                    break;
+                }
+                case FieldStreamEncoding::Delta:
+                {
+                    std::uint64_t nbrBytes = 0;
+                    stream.unpack(&nbrBytes, 1);
+                    std::vector<char> encoded(nbrBytes);
+                    stream.unpack(encoded.data(), nbrBytes);
+                    FieldStreamCodec::decodeDelta(encoded, nbrValues, buffer);
+                    break;
+                }
+            }
         }
 
 
@@ -481,36 +614,6 @@ namespace amr
                 destination(xDestination) = source(xSource);
             }
         }
-
-
-
-        void packImpl(std::vector<double>& buffer, FieldImpl const& source,
-                      SAMRAI::hier::Box const& overlap, SAMRAI::hier::Box const& sourceBox) const
-        {
-            int xStart = overlap.lower(0) - sourceBox.lower(0);
-            int xEnd   = overlap.upper(0) - sourceBox.lower(0);
-
-            for (int xi = xStart; xi <= xEnd; ++xi)
-            {
-                buffer.push_back(source(xi));
-            }
-        }
-
-
-
-        void unpackImpl(std::size_t& seek, std::vector<double> const& buffer, FieldImpl& source,
-                        SAMRAI::hier::Box const& overlap,
-                        SAMRAI::hier::Box const& destination) const
-        {
-            int xStart = overlap.lower(0) - destination.lower(0);
-            int xEnd   = overlap.upper(0) - destination.lower(0);
-
-            for (int xi = xStart; xi <= xEnd; ++xi)
-            {
-                source(xi) = buffer[seek];
-                ++seek;
-            }
-        }
     };
 
 
@@ -551,51 +654,6 @@ namespace amr
                 }
             }
         }
-
-
-
-
-        void packImpl(std::vector<double>& buffer, FieldImpl const& source,
-                      SAMRAI::hier::Box const& overlap, SAMRAI::hier::Box const& destination) const
-
-        {
-            int xStart = overlap.lower(0) - destination.lower(0);
-            int xEnd   = overlap.upper(0) - destination.lower(0);
-
-            int yStart = overlap.lower(1) - destination.lower(1);
-            int yEnd   = overlap.upper(1) - destination.lower(1);
-
-            for (int xi = xStart; xi <= xEnd; ++xi)
-            {
-                for (int yi = yStart; yi <= yEnd; ++yi)
-                {
-                    buffer.push_back(source(xi, yi));
-                }
-            }
-        }
-
-
-
-
-        void unpackImpl(std::size_t& seek, std::vector<double> const& buffer, FieldImpl& source,
-                        SAMRAI::hier::Box const& overlap,
-                        SAMRAI::hier::Box const& destination) const
-        {
-            int xStart = overlap.lower(0) - destination.lower(0);
-            int xEnd   = overlap.upper(0) - destination.lower(0);
-
-            int yStart = overlap.lower(1) - destination.lower(1);
-            int yEnd   = overlap.upper(1) - destination.lower(1);
-
-            for (int xi = xStart; xi <= xEnd; ++xi)
-            {
-                for (int yi = yStart; yi <= yEnd; ++yi)
-                {
-                    source(xi, yi) = buffer[seek];
-                    ++seek;
-                }
-            }
-        }
     };
 
 
@@ -650,62 +708,6 @@ namespace amr
                 }
             }
         }
-
-
-
-
-        void packImpl(std::vector<double>& buffer, FieldImpl const& source,
-                      SAMRAI::hier::Box const& overlap, SAMRAI::hier::Box const& destination) const
-        {
-            int xStart = overlap.lower(0) - destination.lower(0);
-            int xEnd   = overlap.upper(0) - destination.lower(0);
-
-            int yStart = overlap.lower(1) - destination.lower(1);
-            int yEnd   = overlap.upper(1) - destination.lower(1);
-
-            int zStart = overlap.lower(2) - destination.lower(2);
-            int zEnd   = overlap.upper(2) - destination.lower(2);
-
-            for (int xi = xStart; xi <= xEnd; ++xi)
-            {
-                for (int yi = yStart; yi <= yEnd; ++yi)
-                {
-                    for (int zi = zStart; zi <= zEnd; ++zi)
-                    {
-                        buffer.push_back(source(xi, yi, zi));
-                    }
-                }
-            }
-        }
-
-
-
-
-        void unpackImpl(std::size_t& seek, std::vector<double> const& buffer, FieldImpl& source,
-                        SAMRAI::hier::Box const& overlap,
-                        SAMRAI::hier::Box const& destination) const
-        {
-            int xStart = overlap.lower(0) - destination.lower(0);
-            int xEnd   = overlap.upper(0) - destination.lower(0);
-
-            int yStart = overlap.lower(1) - destination.lower(1);
-            int yEnd   = overlap.upper(1) - destination.lower(1);
-
-            int zStart = overlap.lower(2) - destination.lower(2);
-            int zEnd   = overlap.upper(2) - destination.lower(2);
-
-            for (int xi = xStart; xi <= xEnd; ++xi)
-            {
-                for (int yi = yStart; yi <= yEnd; ++yi)
-                {
-                    for (int zi = zStart; zi <= zEnd; ++zi)
-                    {
-                        source(xi, yi, zi) = buffer[seek];
-                        ++seek;
-                    }
-                }
-            }
-        }
     };
 
 
@@ -5,6 +5,13 @@
 #include <SAMRAI/hier/BoxOverlap.h>
 #include <SAMRAI/hier/Transformation.h>
 
+#include "amr/data/field/field_stream_encoding.hpp"
+#include "amr/data/field/field_stream_plan.hpp"
+
+#include <map>
+#include <memory>
+#include <vector>
+
 namespace PHARE
 {
 namespace amr
@@ -29,6 +36,20 @@ namespace amr
         {
         }
 
+        /** the encoding tells how FieldData values on this overlap are put on streams, if
+         * streamStats is not null, it accumulates the packed byte counts
+         */
+        FieldOverlap(SAMRAI::hier::BoxContainer const& boxes,
+                     SAMRAI::hier::Transformation const& transformation,
+                     FieldStreamEncoding encoding, std::shared_ptr<FieldStreamStats> streamStats)
+            : destinationBoxes_{boxes}
+            , transformation_{transformation}
+            , isOverlapEmpty_{boxes.empty()}
+            , encoding_{encoding}
+            , streamStats_{std::move(streamStats)}
+        {
+        }
+
         ~FieldOverlap() = default;
 
 
@@ -57,10 +78,38 @@ namespace amr
         }
 
 
+
+        FieldStreamEncoding streamEncoding() const { return encoding_; }
+
+        FieldStreamStats* streamStats() const { return streamStats_.get(); }
+
+
+
+        /** pack and unpack plans are computed by FieldData the first time the overlap is
+         * streamed, and reused afterwards. Overlaps live as long as the schedule transactions
+         * using them, so plans are naturally invalidated when schedules are rebuilt at regrid.
+         *
+         * SAMRAI may use the same overlap for all the quantities of an equivalence class, so plans
+         * are stored per key, the key identifying the layout of the streamed field (see
+         * FieldData::planKey_). The returned plan is empty the first time a key is used.
+         */
+        FieldStreamPlan& packPlan(std::vector<int> const& key) const { return (*packPlans_)[key]; }
+
+        FieldStreamPlan& unpackPlan(std::vector<int> const& key) const
+        {
+            return (*unpackPlans_)[key];
+        }
+
+
     private:
         SAMRAI::hier::BoxContainer const destinationBoxes_;
         SAMRAI::hier::Transformation const transformation_;
         bool const isOverlapEmpty_;
+        FieldStreamEncoding const encoding_ = FieldStreamEncoding::Double;
+        std::shared_ptr<FieldStreamStats> const streamStats_;
+        using Plans = std::map<std::vector<int>, FieldStreamPlan>;
+        std::shared_ptr<Plans> const packPlans_   = std::make_shared<Plans>();
+        std::shared_ptr<Plans> const unpackPlans_ = std::make_shared<Plans>();
     };
 
 } // namespace amr
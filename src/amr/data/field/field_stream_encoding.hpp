@@ -0,0 +1,190 @@
+#ifndef PHARE_SRC_AMR_FIELD_FIELD_STREAM_ENCODING_HPP
+#define PHARE_SRC_AMR_FIELD_FIELD_STREAM_ENCODING_HPP
+
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace PHARE::amr
+{
+/** \brief FieldStreamEncoding tells how FieldData values are put on a MessageStream
+ *
+ *  Fields are always stored as double in memory, the encoding only applies to the bytes
+ *  exchanged between ranks:
+ *   - Double : values are sent as is
+ *   - Float  : values are sent as float32, this is lossy and meant for exchanges that tolerate
+ *              reduced precision
+ *   - Delta  : values are xor-ed with the previous value of the stream and only the significant
+ *              bytes are sent. This is lossless and efficient on smooth fields where neighbor
+ *              values share their sign, exponent and leading mantissa bits.
+ */
+enum class FieldStreamEncoding { Double, Float, Delta };
+
+
+
+inline std::string to_string(FieldStreamEncoding encoding)
+{
+    switch (encoding)
+    {
+        case FieldStreamEncoding::Double: return "double";
+        case FieldStreamEncoding::Float: return "float";
+        case FieldStreamEncoding::Delta: return "delta";
+    }
+    throw std::runtime_error("unknown FieldStreamEncoding");
+}
+
+
+
+inline FieldStreamEncoding fieldStreamEncoding(std::string const& name)
+{
+    for (auto encoding :
+         {FieldStreamEncoding::Double, FieldStreamEncoding::Float, FieldStreamEncoding::Delta})
+        if (name == to_string(encoding))
+            return encoding;
+    throw std::runtime_error("unknown FieldStreamEncoding " + name);
+}
+
+
+
+/** \brief FieldStreamStats accumulates the number of bytes packed by FieldData on streams
+ *
+ * rawBytes is what the stream would have cost with double values, wireBytes is what was actually
+ * packed with the encoding in use.
+ */
+struct FieldStreamStats
+{
+    std::size_t nbrPacks  = 0;
+    std::size_t rawBytes  = 0;
+    std::size_t wireBytes = 0;
+
+    double ratio() const
+    {
+        return rawBytes > 0 ? static_cast<double>(wireBytes) / rawBytes : 1.;
+    }
+
+    FieldStreamStats& operator+=(FieldStreamStats const& that)
+    {
+        nbrPacks += that.nbrPacks;
+        rawBytes += that.rawBytes;
+        wireBytes += that.wireBytes;
+        return *this;
+    }
+};
+
+
+
+/** \brief FieldStreamCodec converts between the in-memory double buffer of FieldData and the
+ * bytes put on the stream
+ *
+ * For the Delta encoding, each value is xor-ed with the previous one, and stored as one byte
+ * giving the number N of significant bytes of the xor result, followed by its N least
+ * significant bytes. An encoded value thus takes between 1 and 9 bytes.
+ */
+class FieldStreamCodec
+{
+public:
+    /** @brief maximum number of bytes needed to encode nbrValues values, used to tell SAMRAI
+     * how big the stream can be
+     */
+    static std::size_t maxEncodedSize(FieldStreamEncoding encoding, std::size_t nbrValues)
+    {
+        switch (encoding)
+        {
+            case FieldStreamEncoding::Double: return nbrValues * sizeof(double);
+            case FieldStreamEncoding::Float: return nbrValues * sizeof(float);
+            case FieldStreamEncoding::Delta:
+                return sizeof(std::uint64_t) + nbrValues * (1 + sizeof(std::uint64_t));
+        }
+        throw std::runtime_error("unknown FieldStreamEncoding");
+    }
+
+
+
+    static void encodeFloat(std::vector<double> const& values, std::vector<float>& encoded)
+    {
+        encoded.resize(values.size());
+        for (std::size_t i = 0; i < values.size(); ++i)
+            encoded[i] = static_cast<float>(values[i]);
+    }
+
+
+    static void decodeFloat(std::vector<float> const& encoded, std::vector<double>& values)
+    {
+        values.resize(encoded.size());
+        for (std::size_t i = 0; i < encoded.size(); ++i)
+            values[i] = static_cast<double>(encoded[i]);
+    }
+
+
+
+    static void encodeDelta(std::vector<double> const& values, std::vector<char>& encoded)
+    {
+        encoded.clear();
+        encoded.reserve(maxEncodedSize(FieldStreamEncoding::Delta, values.size()));
+
+        std::uint64_t previous = 0;
+        for (auto const& value : values)
+        {
+            auto bits     = toBits_(value);
+            auto residual = bits ^ previous;
+            previous      = bits;
+
+            std::uint8_t nbrBytes = 0;
+            for (auto r = residual; r != 0; r >>= 8)
+                ++nbrBytes;
+
+            encoded.push_back(static_cast<char>(nbrBytes));
+            for (std::uint8_t iByte = 0; iByte < nbrBytes; ++iByte)
+                encoded.push_back(static_cast<char>((residual >> (8 * iByte)) & 0xFF));
+        }
+    }
+
+
+    static void decodeDelta(std::vector<char> const& encoded, std::size_t nbrValues,
+                            std::vector<double>& values)
+    {
+        values.resize(nbrValues);
+
+        std::uint64_t previous = 0;
+        std::size_t seek       = 0;
+        for (std::size_t i = 0; i < nbrValues; ++i)
+        {
+            if (seek >= encoded.size())
+                throw std::runtime_error("FieldStreamCodec: truncated delta stream");
+
+            auto nbrBytes = static_cast<std::uint8_t>(encoded[seek++]);
+            if (nbrBytes > sizeof(std::uint64_t) or seek + nbrBytes > encoded.size())
+                throw std::runtime_error("FieldStreamCodec: corrupted delta stream");
+
+            std::uint64_t residual = 0;
+            for (std::uint8_t iByte = 0; iByte < nbrBytes; ++iByte)
+                residual |= static_cast<std::uint64_t>(static_cast<std::uint8_t>(encoded[seek++]))
+                            << (8 * iByte);
+
+            previous  = previous ^ residual;
+            values[i] = fromBits_(previous);
+        }
+    }
+
+
+private:
+    static std::uint64_t toBits_(double value)
+    {
+        std::uint64_t bits;
+        std::memcpy(&bits, &value, sizeof(double));
+        return bits;
+    }
+
+    static double fromBits_(std::uint64_t bits)
+    {
+        double value;
+        std::memcpy(&value, &bits, sizeof(double));
+        return value;
+    }
+};
+
+} // namespace PHARE::amr
+
+#endif
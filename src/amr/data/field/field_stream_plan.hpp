@@ -0,0 +1,128 @@
+#ifndef PHARE_SRC_AMR_FIELD_FIELD_STREAM_PLAN_HPP
+#define PHARE_SRC_AMR_FIELD_FIELD_STREAM_PLAN_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace PHARE::amr
+{
+/** \brief FieldStreamPlan is the precomputed list of contiguous memory segments of a field that
+ * are packed on, or unpacked from, a stream for a given overlap
+ *
+ * Fields are c-ordered, so each segment is a run of values along the last direction. Packing is
+ * then a gather of the segments into the reusable buffer, and unpacking a scatter from it.
+ *
+ * The plan is valid as long as the overlap and the field it was computed for do not change. The
+ * key identifies the field it was computed for (typically the patch box lower and upper
+ * indexes), see matches().
+ */
+struct FieldStreamPlan
+{
+    struct Segment
+    {
+        std::size_t offset;
+        std::size_t size;
+    };
+
+    std::vector<int> key;
+    std::vector<Segment> segments;
+    std::size_t size = 0;
+
+    //! reused from one pack to the next, to avoid an allocation per pack
+    std::vector<double> buffer;
+
+
+    bool matches(std::vector<int> const& otherKey) const
+    {
+        return !key.empty() and key == otherKey;
+    }
+
+
+    void reset(std::vector<int> newKey)
+    {
+        key = std::move(newKey);
+        segments.clear();
+        size = 0;
+    }
+
+
+    /** @brief add the segments of the local box [lower, upper] (inclusive bounds) of a field of
+     * the given shape, in the order they are traversed by the pack/unpack loops
+     */
+    template<std::size_t dim>
+    void addBox(std::array<int, dim> const& lower, std::array<int, dim> const& upper,
+                std::array<std::uint32_t, dim> const& shape)
+    {
+        for (std::size_t iDim = 0; iDim < dim; ++iDim)
+            if (upper[iDim] < lower[iDim])
+                return;
+
+        auto const rowSize = static_cast<std::size_t>(upper[dim - 1] - lower[dim - 1] + 1);
+
+        auto addRow = [&](std::size_t rowStart) {
+            // merge with the previous segment if contiguous in memory
+            if (!segments.empty()
+                and segments.back().offset + segments.back().size == rowStart + lower[dim - 1])
+                segments.back().size += rowSize;
+            else
+                segments.push_back({rowStart + lower[dim - 1], rowSize});
+            size += rowSize;
+        };
+
+        if constexpr (dim == 1)
+        {
+            addRow(0);
+        }
+        else if constexpr (dim == 2)
+        {
+            for (int ix = lower[0]; ix <= upper[0]; ++ix)
+                addRow(static_cast<std::size_t>(ix) * shape[1]);
+        }
+        else if constexpr (dim == 3)
+        {
+            for (int ix = lower[0]; ix <= upper[0]; ++ix)
+                for (int iy = lower[1]; iy <= upper[1]; ++iy)
+                    addRow((static_cast<std::size_t>(ix) * shape[1] + iy) * shape[2]);
+        }
+    }
+
+
+
+    //! copies the segments of the field data into the buffer
+    void gather(double const* data)
+    {
+        buffer.resize(size);
+
+        auto seek = buffer.data();
+        for (auto const& segment : segments)
+        {
+            auto const* src = data + segment.offset;
+            for (std::size_t i = 0; i < segment.size; ++i)
+                seek[i] = src[i];
+            seek += segment.size;
+        }
+    }
+
+
+
+    //! copies the values of the given buffer into the segments of the field data
+    void scatter(std::vector<double> const& values, double* data) const
+    {
+        auto const* seek = values.data();
+        for (auto const& segment : segments)
+        {
+            auto* dst = data + segment.offset;
+            for (std::size_t i = 0; i < segment.size; ++i)
+                dst[i] = seek[i];
+            seek += segment.size;
+        }
+    }
+};
+
+
+} // namespace PHARE::amr
+
+#endif
@@ -7,6 +7,7 @@
 
 #include "core/utilities/types.hpp"
 #include "core/utilities/mpi_utils.hpp"
+#include "amr/data/field/field_stream_encoding.hpp"
 #include "amr/data/field/refine/field_refine_operator.hpp"
 
 namespace PHARE::amr
@@ -25,24 +26,31 @@ namespace PHARE::amr
     we set the forwarding flag of "bool overwrite_interior" to true
       if the src.globalID > dst.globalID to end up with a single value across MPI domains.
     we also remove the exclusive interior of the src patch to isolate only shared primal nodes.
+
+  The FieldStreamEncoding given at construction is carried by all the overlaps the pattern
+  creates, so that the FieldData streams of all schedules using this pattern are encoded the same
+  way. The bytes they pack are accumulated in streamStats().
 */
 // This class is mostly a copy of BoxGeometryVariableFillPattern
 class FieldFillPattern : public SAMRAI::xfer::VariableFillPattern
 {
 public:
-    FieldFillPattern(std::optional<bool> overwrite_interior)
+    FieldFillPattern(std::optional<bool> overwrite_interior,
+                     FieldStreamEncoding encoding = FieldStreamEncoding::Double)
         : opt_overwrite_interior_{overwrite_interior}
+        , encoding_{encoding}
     {
     }
 
-    static auto make_shared(std::shared_ptr<SAMRAI::hier::RefineOperator> const& samrai_op)
+    static auto make_shared(std::shared_ptr<SAMRAI::hier::RefineOperator> const& samrai_op,
+                            FieldStreamEncoding encoding = FieldStreamEncoding::Double)
     {
         auto const& op = dynamic_cast<AFieldRefineOperator const&>(*samrai_op);
 
         if (op.node_only)
-            return std::make_shared<FieldFillPattern>(std::nullopt);
+            return std::make_shared<FieldFillPattern>(std::nullopt, encoding);
 
-        return std::make_shared<FieldFillPattern>(false);
+        return std::make_shared<FieldFillPattern>(false, encoding);
     }
 
 
@@ -84,15 +92,28 @@ public:
             auto destinationBoxes = overlap.getDestinationBoxContainer();
             destinationBoxes.removeIntersections(src_cast.unshared_interiorBox());
 
-            return std::make_shared<FieldOverlap>(destinationBoxes, overlap.getTransformation());
+            return std::make_shared<FieldOverlap>(destinationBoxes, overlap.getTransformation(),
+                                                  encoding_, streamStats_);
         }
 
-        return dst_geometry.calculateOverlap(src_geometry, src_mask, fill_box, overwrite_interior,
-                                             transformation);
+        auto basic_overlap = dst_geometry.calculateOverlap(src_geometry, src_mask, fill_box,
+                                                           overwrite_interior, transformation);
+        if (encoding_ == FieldStreamEncoding::Double)
+            return basic_overlap;
+
+        auto& overlap = dynamic_cast<FieldOverlap const&>(*basic_overlap);
+        return std::make_shared<FieldOverlap>(overlap.getDestinationBoxContainer(),
+                                              overlap.getTransformation(), encoding_,
+                                              streamStats_);
     }
 
     std::string const& getPatternName() const { return s_name_id; }
 
+    FieldStreamEncoding streamEncoding() const { return encoding_; }
+
+    //! bytes packed on streams by FieldData for the overlaps created by this pattern
+    FieldStreamStats const& streamStats() const { return *streamStats_; }
+
 private:
     FieldFillPattern(FieldFillPattern const&) = delete;
     FieldFillPattern& operator=(FieldFillPattern const&) = delete;
@@ -142,6 +163,8 @@ private:
     }
 
     std::optional<bool> opt_overwrite_interior_{nullptr};
+    FieldStreamEncoding const encoding_;
+    std::shared_ptr<FieldStreamStats> streamStats_ = std::make_shared<FieldStreamStats>();
 };
 
 } // namespace PHARE::amr
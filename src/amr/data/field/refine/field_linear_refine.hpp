@@ -12,6 +12,8 @@
 #include <SAMRAI/hier/IntVector.h>
 
 #include <array>
+#include <cmath>
+#include <cstdlib>
 #include <utility>
 #include <vector>
 
@@ -65,26 +67,21 @@ namespace amr
         {
             auto coarseIndex{fineIndex};
 
-            // here we perform the floating point division, and then we truncate to integer
-            coarseIndex[dirX]
-                = std::floor(static_cast<double>(fineIndex[dirX] + shifts_[dirX]) / ratio_(dirX)
-                             - shifts_[dirX]);
+            for (std::size_t iDir = dirX; iDir < dimension; ++iDir)
+                coarseIndex[iDir] = coarseStartIndex(fineIndex[iDir], iDir);
 
-            if constexpr (dimension > 1)
-            {
-                coarseIndex[dirY]
-                    = std::floor(static_cast<double>(fineIndex[dirY] + shifts_[dirY]) / ratio_(dirY)
-                                 - shifts_[dirY]);
-            }
+            return coarseIndex;
+        }
 
-            if constexpr (dimension > 2)
-            {
-                coarseIndex[dirZ]
-                    = std::floor(static_cast<double>(fineIndex[dirZ] + shifts_[dirZ]) / ratio_(dirZ)
-                                 - shifts_[dirZ]);
-            }
 
-            return coarseIndex;
+
+        /** @brief coarseStartIndex along a single direction
+         */
+        int coarseStartIndex(int const fineIndex, std::size_t const iDir) const
+        {
+            // here we perform the floating point division, and then we truncate to integer
+            return std::floor(static_cast<double>(fineIndex + shifts_[iDir]) / ratio_(iDir)
+                              - shifts_[iDir]);
         }
 
 
@@ -103,22 +100,23 @@ namespace amr
         core::Point<int, dimension>
         computeWeightIndex(core::Point<int, dimension> const& fineIndex) const
         {
-            auto indexesWeights{std::abs(fineIndex)};
+            auto indexesWeights{fineIndex};
 
-            indexesWeights[dirX] %= ratio_[dirX];
-
-            if constexpr (dimension > 1)
-            {
-                indexesWeights[dirY] %= ratio_[dirY];
-            }
-            if constexpr (dimension > 2)
-            {
-                indexesWeights[dirZ] %= ratio_[dirZ];
-            }
+            for (std::size_t iDir = dirX; iDir < dimension; ++iDir)
+                indexesWeights[iDir] = computeWeightIndex(fineIndex[iDir], iDir);
 
             return indexesWeights;
         }
 
+
+
+        /** @brief computeWeightIndex along a single direction
+         */
+        int computeWeightIndex(int const fineIndex, std::size_t const iDir) const
+        {
+            return std::abs(fineIndex) % ratio_[iDir];
+        }
+
     private:
         SAMRAI::hier::IntVector const ratio_;
         std::array<LinearWeighter, dimension> weighters_;
@@ -122,68 +122,11 @@ namespace amr
             for (auto const& box : overlapBoxes)
             {
                 // we compute the intersection with the destination,
-                // and then we apply the refine operation on each fine
-                // index.
+                // and then we apply the refine operation on the whole
+                // intersection box at once.
                 auto intersectionBox = destinationFieldBox * box;
 
-
-
-
-                if constexpr (dimension == 1)
-                {
-                    int iStartX = intersectionBox.lower(dirX);
-                    int iEndX   = intersectionBox.upper(dirX);
-
-                    for (int ix = iStartX; ix <= iEndX; ++ix)
-                    {
-                        refiner(sourceField, destinationField, {{ix}});
-                    }
-                }
-
-
-
-
-                else if constexpr (dimension == 2)
-                {
-                    int iStartX = intersectionBox.lower(dirX);
-                    int iStartY = intersectionBox.lower(dirY);
-
-                    int iEndX = intersectionBox.upper(dirX);
-                    int iEndY = intersectionBox.upper(dirY);
-
-                    for (int ix = iStartX; ix <= iEndX; ++ix)
-                    {
-                        for (int iy = iStartY; iy <= iEndY; ++iy)
-                        {
-                            refiner(sourceField, destinationField, {{ix, iy}});
-                        }
-                    }
-                }
-
-
-
-
-                else if constexpr (dimension == 3)
-                {
-                    int iStartX = intersectionBox.lower(dirX);
-                    int iStartY = intersectionBox.lower(dirY);
-                    int iStartZ = intersectionBox.lower(dirZ);
-
-                    int iEndX = intersectionBox.upper(dirX);
-                    int iEndY = intersectionBox.upper(dirY);
-                    int iEndZ = intersectionBox.upper(dirZ);
-
-                    for (int ix = iStartX; ix <= iEndX; ++ix)
-                    {
-                        for (int iy = iStartY; iy <= iEndY; ++iy)
-                        {
-                            for (int iz = iStartZ; iz <= iEndZ; ++iz)
-                            {
-                                refiner(sourceField, destinationField, {{ix, iy, iz}});
-                            }
-                        }
-                    }
-                }
+                refiner.refineBox(sourceField, destinationField, intersectionBox);
             }
         }
     };
@@ -11,6 +11,8 @@
 
 #include <SAMRAI/hier/TimeInterpolateOperator.h>
 
+#include <cstddef>
+
 
 namespace PHARE::amr
 {
@@ -71,6 +73,8 @@ public:
             fieldDataDest.getBox(), qty, layout, withGhost);
 
         auto const finalBox = interpolateBox * ghostBox;
+        if (finalBox.empty())
+            return;
 
         auto srcGhostBox = FieldGeometry<GridLayoutT, PhysicalQuantity>::toFieldBox(
             fieldDataSrcNew.getBox(), qty, fieldDataSrcNew.gridLayout, withGhost);
@@ -78,35 +82,33 @@ public:
         auto const localDestBox = AMRToLocal(finalBox, ghostBox);
         auto const localSrcBox  = AMRToLocal(finalBox, srcGhostBox);
 
+        // rows along the last direction are contiguous in memory for the destination and both
+        // sources, so each of them is interpolated in a single vectorizable loop
+        auto const lastDir = dim - 1;
+        auto const rowSize = static_cast<std::size_t>(localDestBox.upper(lastDir)
+                                                      - localDestBox.lower(lastDir) + 1);
+
         if constexpr (dim == 1)
         {
-            auto const iDestStartX = localDestBox.lower(dirX);
-            auto const iDestEndX   = localDestBox.upper(dirX);
-
-            auto const iSrcStartX = localSrcBox.lower(dirX);
+            auto const iDest = localDestBox.lower(dirX);
+            auto const iSrc  = localSrcBox.lower(dirX);
 
-            for (auto ix = iDestStartX, ixSrc = iSrcStartX; ix <= iDestEndX; ++ix, ++ixSrc)
-            {
-                fieldDest(ix) = (1. - alpha) * fieldSrcOld(ixSrc) + alpha * fieldSrcNew(ixSrc);
-            }
+            interpolateRow_(&fieldDest(iDest), &fieldSrcOld(iSrc), &fieldSrcNew(iSrc), rowSize,
+                            alpha);
         }
         else if constexpr (dim == 2)
         {
             auto const iDestStartX = localDestBox.lower(dirX);
             auto const iDestEndX   = localDestBox.upper(dirX);
-            auto const iDestStartY = localDestBox.lower(dirY);
-            auto const iDestEndY   = localDestBox.upper(dirY);
+            auto const iDestY      = localDestBox.lower(dirY);
 
             auto const iSrcStartX = localSrcBox.lower(dirX);
-            auto const iSrcStartY = localSrcBox.lower(dirY);
+            auto const iSrcY      = localSrcBox.lower(dirY);
 
             for (auto ix = iDestStartX, ixSrc = iSrcStartX; ix <= iDestEndX; ++ix, ++ixSrc)
             {
-                for (auto iy = iDestStartY, iySrc = iSrcStartY; iy <= iDestEndY; ++iy, ++iySrc)
-                {
-                    fieldDest(ix, iy) = (1. - alpha) * fieldSrcOld(ixSrc, iySrc)
-                                        + alpha * fieldSrcNew(ixSrc, iySrc);
-                }
+                interpolateRow_(&fieldDest(ix, iDestY), &fieldSrcOld(ixSrc, iSrcY),
+                                &fieldSrcNew(ixSrc, iSrcY), rowSize, alpha);
             }
         }
         else if constexpr (dim == 3)
@@ -115,26 +117,32 @@ public:
             auto const iDestEndX   = localDestBox.upper(dirX);
             auto const iDestStartY = localDestBox.lower(dirY);
             auto const iDestEndY   = localDestBox.upper(dirY);
-            auto const iDestStartZ = localDestBox.lower(dirZ);
-            auto const iDestEndZ   = localDestBox.upper(dirZ);
+            auto const iDestZ      = localDestBox.lower(dirZ);
 
             auto const iSrcStartX = localSrcBox.lower(dirX);
             auto const iSrcStartY = localSrcBox.lower(dirY);
-            auto const iSrcStartZ = localSrcBox.lower(dirZ);
+            auto const iSrcZ      = localSrcBox.lower(dirZ);
 
             for (auto ix = iDestStartX, ixSrc = iSrcStartX; ix <= iDestEndX; ++ix, ++ixSrc)
             {
                 for (auto iy = iDestStartY, iySrc = iSrcStartY; iy <= iDestEndY; ++iy, ++iySrc)
                 {
-                    for (auto iz = iDestStartZ, izSrc = iSrcStartZ; iz <= iDestEndZ; ++iz, ++izSrc)
-                    {
-                        fieldDest(ix, iy, iz) = (1. - alpha) * fieldSrcOld(ixSrc, iySrc, izSrc)
-                                                + alpha * fieldSrcNew(ixSrc, iySrc, izSrc);
-                    }
+                    interpolateRow_(&fieldDest(ix, iy, iDestZ), &fieldSrcOld(ixSrc, iySrc, iSrcZ),
+                                    &fieldSrcNew(ixSrc, iySrc, iSrcZ), rowSize, alpha);
                 }
             }
         }
     }
+
+
+private:
+    static void interpolateRow_(double* dest, double const* srcOld, double const* srcNew,
+                                std::size_t const size, double const alpha)
+    {
+        double const beta = 1. - alpha;
+        for (std::size_t i = 0; i < size; ++i)
+            dest[i] = beta * srcOld[i] + alpha * srcNew[i];
+    }
 };
 
 } // namespace PHARE::amr
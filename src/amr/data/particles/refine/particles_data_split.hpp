@@ -14,7 +14,9 @@
 #include <SAMRAI/hier/RefineOperator.h>
 #include <SAMRAI/pdat/CellOverlap.h>
 
+#include <algorithm>
 #include <functional>
+#include <vector>
 
 
 namespace PHARE
@@ -73,6 +75,14 @@ namespace amr
             return SAMRAI::hier::IntVector{dimension, ghostWidthForParticles<interpOrder>()};
         }
 
+        /** @brief number of refined particles this operator has put in destination arrays since
+         * the last call to resetRefinedCount()
+         */
+        std::size_t refinedCount() const { return refinedCount_; }
+
+        void resetRefinedCount() { refinedCount_ = 0; }
+
+
         /** @brief perform a split and keep those that are inside a fineOverlap
          *
          */
@@ -134,6 +144,10 @@ namespace amr
         /** @brief given two ParticlesData (destination and source),
          * an overlap , a ratio and the geometry of both patches, perform the
          * splitting of coarse particles onto the destination patch
+         *
+         * Only the particles of the coarse cells that can have refined particles in a destination
+         * box are visited, using the CellMap of the source arrays. Candidates are split together
+         * into a buffer, from which refined particles inside the destination box are copied.
          */
         void refine_(ParticlesData<ParticleArray>& destParticlesData,
                      ParticlesData<ParticleArray> const& srcParticlesData,
@@ -149,22 +163,18 @@ namespace amr
             auto const& srcGhostParticles    = srcParticlesData.patchGhostParticles;
 
             // the particle refine operator's job is to fill either domain (during initialization of
-            // new patches) or coarse to fine boundaries (during advance), so we need references to
-            // these arrays on the destination. We don't fill ghosts with this operator, they are
-            // filled from exchanging with neighbor patches.
-            auto const& destBoxes                = destFieldOverlap.getDestinationBoxContainer();
-            auto& destCoarseBoundaryParticles    = destParticlesData.levelGhostParticles;
-            auto& destDomainParticles            = destParticlesData.domainParticles;
-            auto& destCoarseBoundaryOldParticles = destParticlesData.levelGhostParticlesOld;
-            auto& destCoarseBoundaryNewParticles = destParticlesData.levelGhostParticlesNew;
-
-
-            // We get the source box that contains ghost region in order to get local index later
-            // same for destinationGhostBox and destinationDomainBox the later will allow to get an
-            // index relative to the interior
+            // new patches) or coarse to fine boundaries (during advance), so we need a reference to
+            // the destination array matching the split type. We don't fill ghosts with this
+            // operator, they are filled from exchanging with neighbor patches.
+            auto const& destBoxes = destFieldOverlap.getDestinationBoxContainer();
+            auto& destParticles   = destinationArray_(destParticlesData);
 
             Splitter split;
 
+            // reused from one destination box to the next
+            std::vector<typename ParticleArray::value_type> candidates;
+            std::vector<typename ParticleArray::value_type> refinedParticles;
+
             // The PatchLevelFillPattern had compute boxes that correspond to the expected filling.
             // In case of a coarseBoundary it will most likely give multiple boxes
             // in case of interior, this will be just one box usually
@@ -172,79 +182,93 @@ namespace amr
             {
                 std::array particlesArrays{&srcInteriorParticles, &srcGhostParticles};
 
+                auto const splitBox    = getSplitBox(destinationBox);
+                auto const coarseCells = coarseCellsOf_(phare_box_from<dim>(splitBox));
+
+                candidates.clear();
+                for (auto const& sourceParticlesArray : particlesArrays)
+                {
+                    if (auto cells = coarseCells * sourceParticlesArray->box())
+                        sourceParticlesArray->export_particles(
+                            *cells, candidates,
+                            [](auto const& particle) { return toFineGrid<interpOrder>(particle); });
+                }
+
+                // coarse cells overlapping the split box border have particles outside of it
+                candidates.erase(std::remove_if(std::begin(candidates), std::end(candidates),
+                                                [&splitBox](auto const& particle) {
+                                                    return !isInBox(splitBox, particle);
+                                                }),
+                                 std::end(candidates));
+
+                refinedParticles.resize(candidates.size() * nbRefinedPart);
+                for (std::size_t iCandidate = 0; iCandidate < candidates.size(); ++iCandidate)
+                    split(candidates[iCandidate], refinedParticles, iCandidate * nbRefinedPart);
+
                 auto isInDest = [&destinationBox](auto const& particle) //
                 { return isInBox(destinationBox, particle); };
 
+                destParticles.reserve(
+                    destParticles.size()
+                    + std::count_if(std::begin(refinedParticles), std::end(refinedParticles),
+                                    isInDest));
+
+                auto const sizeBefore = destParticles.size();
+                for (auto const& refinedParticle : refinedParticles)
+                    if (isInDest(refinedParticle))
+                        destParticles.push_back(refinedParticle);
+                refinedCount_ += destParticles.size() - sizeBefore;
+            } // loop on destination box
+        }
 
-                for (auto const& sourceParticlesArray : particlesArrays)
-                {
-                    for (auto const& particle : *sourceParticlesArray)
-                    {
-                        std::array<typename ParticleArray::value_type, nbRefinedPart>
-                            refinedParticles;
-                        auto particleRefinedPos = toFineGrid<interpOrder>(particle);
-
-                        if (isCandidateForSplit_(particleRefinedPos, destinationBox))
-                        {
-                            split(particleRefinedPos, refinedParticles);
-
-
-                            // we need to know in which of interior or levelGhostParticlesXXXX
-                            // arrays we must put particles
-
-                            bool constexpr putParticlesInCoarseBoundary
-                                = splitType == ParticlesDataSplitType::coarseBoundary
-                                  || splitType == ParticlesDataSplitType::coarseBoundaryOld
-                                  || splitType == ParticlesDataSplitType::coarseBoundaryNew;
-
-
-
-                            if constexpr (putParticlesInCoarseBoundary)
-                            {
-                                if constexpr (splitType == ParticlesDataSplitType::coarseBoundary)
-                                {
-                                    /*std::cout << "copying " << refinedParticles.size()
-                                              << " particles into levelGhost\n";*/
-                                    std::copy_if(
-                                        std::begin(refinedParticles), std::end(refinedParticles),
-                                        std::back_inserter(destCoarseBoundaryParticles), isInDest);
-                                }
-                                else if constexpr (splitType
-                                                   == ParticlesDataSplitType::coarseBoundaryOld)
-                                {
-                                    /*std::cout << "copying " << refinedParticles.size()
-                                              << " particles into levelGhostOld\n";*/
-                                    std::copy_if(std::begin(refinedParticles),
-                                                 std::end(refinedParticles),
-                                                 std::back_inserter(destCoarseBoundaryOldParticles),
-                                                 isInDest);
-                                }
-                                else //  splitType is coarseBoundaryNew
-                                {
-                                    /*std::cout << "copying " << refinedParticles.size()
-                                              << " particles into levelGhostNew\n";*/
-                                    std::copy_if(std::begin(refinedParticles),
-                                                 std::end(refinedParticles),
-                                                 std::back_inserter(destCoarseBoundaryNewParticles),
-                                                 isInDest);
-                                }
-                            }
-
-                            else
-                            {
-                                /*std::cout << "copying " << refinedParticles.size()
-                                          << " particles into domain\n";*/
-                                std::copy_if(std::begin(refinedParticles),
-                                             std::end(refinedParticles),
-                                             std::back_inserter(destDomainParticles), isInDest);
-                            }
-                        } // end is candidate for split
-                    }     // end loop on particles
-                }         // end loop on source particle arrays
-            }             // loop on destination box
+
+
+        /** @brief returns the particle array of the destination this operator fills */
+        static ParticleArray& destinationArray_(ParticlesData<ParticleArray>& destParticlesData)
+        {
+            if constexpr (splitType == ParticlesDataSplitType::coarseBoundary)
+                return destParticlesData.levelGhostParticles;
+
+            else if constexpr (splitType == ParticlesDataSplitType::coarseBoundaryOld)
+                return destParticlesData.levelGhostParticlesOld;
+
+            else if constexpr (splitType == ParticlesDataSplitType::coarseBoundaryNew)
+                return destParticlesData.levelGhostParticlesNew;
+
+            else
+                return destParticlesData.domainParticles;
+        }
+
+
+
+        /** @brief returns the box of coarse cells whose particles, once on the fine grid, can be
+         * in the given fine box
+         *
+         * A particle of coarse cell c is in fine cell c*ratio + floor(delta*ratio), that is
+         * between c*ratio and c*ratio + ratio - 1.
+         */
+        static core::Box<int, dim> coarseCellsOf_(core::Box<int, dim> const& fineBox)
+        {
+            constexpr auto ratio = PHARE::amr::refinementRatio;
+
+            auto floorDiv = [](int index) {
+                return index >= 0 ? index / ratio : (index - ratio + 1) / ratio;
+            };
+
+            core::Box<int, dim> coarseBox{fineBox};
+            for (std::size_t iDim = 0; iDim < dim; ++iDim)
+            {
+                coarseBox.lower[iDim] = floorDiv(fineBox.lower[iDim]);
+                coarseBox.upper[iDim] = floorDiv(fineBox.upper[iDim]);
+            }
+            return coarseBox;
         }
 
 
+        // SAMRAI only gives a const operator to refine()
+        mutable std::size_t refinedCount_ = 0;
+
+
         SAMRAI::hier::Box getSplitBox(SAMRAI::hier::Box const& destinationBox) const
         {
             SAMRAI::hier::Box splitBox{destinationBox};
@@ -259,14 +283,6 @@ namespace amr
 
             return splitBox;
         }
-
-        template<typename Particle>
-        bool isCandidateForSplit_(Particle const& particle,
-                                  SAMRAI::hier::Box const& toFillBox) const
-        {
-            auto toSplitBox = getSplitBox(toFillBox);
-            return isInBox(toSplitBox, particle);
-        }
     };
 
 } // namespace amr
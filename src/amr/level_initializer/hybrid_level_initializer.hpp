@@ -60,10 +60,20 @@ namespace solver
             auto& hybMessenger = dynamic_cast<HybridMessenger&>(messenger);
 
 
+            // restarts of the "phareh5" format load the field and the particles of the level
+            // from the restart file, the rest of the state is computed from them
+            bool const fromRestart = static_cast<bool>(hybridModel.restartLoader);
+
             if (isRootLevel(levelNumber))
             {
                 PHARE_LOG_START("hybridLevelInitializer::initialize : root level init");
-                model.initialize(level);
+                if (fromRestart)
+                {
+                    hybridModel.restartLoader(level);
+                    hybridModel.resourcesManager->registerForRestarts(hybridModel);
+                }
+                else
+                    model.initialize(level);
                 messenger.fillRootGhosts(model, level, initDataTime);
                 PHARE_LOG_STOP("hybridLevelInitializer::initialize : root level init");
             }
@@ -78,9 +88,26 @@ namespace solver
                 }
                 else
                 {
+                    // a level the restart covers entirely takes nothing from the coarser level
+                    // but its level ghosts, the costly refinement of its particles is skipped
+                    bool const covered = fromRestart and hybridModel.restartCovers(level);
+
                     PHARE_LOG_START("hybridLevelInitializer::initialize : initlevel");
-                    messenger.initLevel(model, level, initDataTime);
+                    if (covered)
+                        hybMessenger.initLevelGhostParticles(model, level, initDataTime);
+                    else
+                        messenger.initLevel(model, level, initDataTime);
                     PHARE_LOG_STOP("hybridLevelInitializer::initialize : initlevel");
+
+                    if (fromRestart)
+                    {
+                        auto& electromag = hybridModel.state.electromag;
+                        hybridModel.restartLoader(level);
+                        hybMessenger.fillMagneticGhosts(electromag.B, levelNumber, initDataTime);
+                        hybMessenger.fillElectricGhosts(electromag.E, levelNumber, initDataTime);
+                        hybMessenger.fillIonGhostParticles(hybridModel.state.ions, level,
+                                                           initDataTime);
+                    }
                     messenger.prepareStep(model, level, initDataTime);
                 }
             }
@@ -140,8 +167,11 @@ namespace solver
                     auto& Ve = electrons.velocity();
                     auto& Ne = electrons.density();
                     auto& Pe = electrons.pressure();
-                    auto __  = core::SetLayout(&layout, ohm_);
-                    ohm_(Ne, Ve, Pe, B, J, E);
+                    if (!fromRestart) // the electric field of a restart is the saved one
+                    {
+                        auto __ = core::SetLayout(&layout, ohm_);
+                        ohm_(Ne, Ve, Pe, B, J, E);
+                    }
                     hybridModel.resourcesManager->setTime(E, *patch, 0.);
                 }
 
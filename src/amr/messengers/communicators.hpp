@@ -62,6 +62,10 @@ namespace amr
          *
          * This overload is used for communications that involve time interpolation. In PHARE those
          * are only for ghost nodes, which is only for VecField E and B.
+         *
+         * The encoding tells how field values are put on MPI streams by the schedules of this
+         * QuantityCommunicator. Reduced precision (Float) should only be used for quantities that
+         * tolerate it.
          */
         template<typename ResourcesManager>
         void
@@ -69,11 +73,12 @@ namespace amr
             VecFieldDescriptor const& oldModelDescriptor,
             std::shared_ptr<ResourcesManager> const& rm,
             std::shared_ptr<SAMRAI::hier::RefineOperator> const& refineOp,
-            std::shared_ptr<SAMRAI::hier::TimeInterpolateOperator> const& timeOp, std::string key)
+            std::shared_ptr<SAMRAI::hier::TimeInterpolateOperator> const& timeOp, std::string key,
+            FieldStreamEncoding encoding = FieldStreamEncoding::Double)
         {
-            auto const [it, success]
-                = refiners_.insert({key, makeRefiner(ghostDescriptor, modelDescriptor,
-                                                     oldModelDescriptor, rm, refineOp, timeOp)});
+            auto const [it, success] = refiners_.insert(
+                {key, makeRefiner(ghostDescriptor, modelDescriptor, oldModelDescriptor, rm,
+                                  refineOp, timeOp, encoding)});
             if (!success)
                 throw std::runtime_error(key + " is already registered");
         }
@@ -274,6 +279,20 @@ namespace amr
 
 
 
+        /**
+         * @brief streamStats returns, for each key, the bytes packed on MPI streams by the field
+         * schedules of the pool, so that the gain of the stream encoding can be judged.
+         */
+        std::map<std::string, FieldStreamStats> streamStats() const
+        {
+            std::map<std::string, FieldStreamStats> stats;
+            for (auto const& [key, refiner] : refiners_)
+                stats[key] = refiner.streamStats();
+            return stats;
+        }
+
+
+
     private:
         std::map<std::string, Communicator<Refiner>> refiners_;
     };
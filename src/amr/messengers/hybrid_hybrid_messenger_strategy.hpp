@@ -11,12 +11,15 @@
 #include "amr/messengers/messenger_info.hpp"
 #include "amr/messengers/hybrid_messenger_info.hpp"
 #include "amr/messengers/hybrid_messenger_strategy.hpp"
+#include "amr/messengers/particle_migrator.hpp"
 #include "amr/resources_manager/amr_utils.hpp"
 #include "amr/resources_manager/resources_manager_utilities.hpp"
 
 #include "core/numerics/interpolator/interpolator.hpp"
 #include "core/numerics/moments/moments.hpp"
 #include "core/hybrid/hybrid_quantities.hpp"
+#include "core/utilities/mpi_utils.hpp"
+#include "core/logger.hpp"
 
 
 
@@ -26,14 +29,46 @@
 
 #include <iterator>
 #include <optional>
+#include <unordered_map>
 #include <utility>
 #include <iomanip>
+#include <iostream>
 
 
 namespace PHARE
 {
 namespace amr
 {
+    /** \brief ParticleRegridStats counts the domain particles of a regridded level, depending on
+     * whether they were copied from the level before the regrid, or split from the coarser level
+     *
+     * Counts are those of the local patches, the totals over all ranks are printed by rank 0.
+     */
+    struct ParticleRegridStats
+    {
+        std::size_t nbrReused = 0;
+        std::size_t nbrSplit  = 0;
+    };
+
+
+
+    /** @brief returns where afterPushTime is within the coarser time step, from beforeCoarseTime
+     * to afterCoarseTime, that a level is subcycling in: 0 at its start and 1 at its end
+     *
+     * The sum of the substeps may overshoot the coarser time by rounding errors, which is clamped.
+     */
+    inline double subcycleTimeInterpCoef(double const beforeCoarseTime,
+                                         double const afterCoarseTime, double const afterPushTime)
+    {
+        constexpr double tolerance = 1e-10;
+
+        auto const alpha
+            = (afterPushTime - beforeCoarseTime) / (afterCoarseTime - beforeCoarseTime);
+        return alpha > 1 and alpha < 1 + tolerance ? 1. : alpha;
+    }
+
+
+
     /** \brief An HybridMessenger is the specialization of a HybridMessengerStrategy for hybrid to
      * hybrid data communications.
      */
@@ -46,6 +81,7 @@ namespace amr
         using GridLayoutT                        = typename HybridModel::gridlayout_type;
         using FieldT                             = typename VecFieldT::field_type;
         using ResourcesManagerT                  = typename HybridModel::resources_manager_type;
+        using ParticleArrayT                     = typename IonsT::particle_array_type;
         static constexpr std::size_t dimension   = GridLayoutT::dimension;
         static constexpr std::size_t interpOrder = GridLayoutT::interp_order;
         using IPhysicalModel                     = typename HybridModel::Interface;
@@ -60,11 +96,18 @@ namespace amr
         static constexpr std::size_t rootLevelNumber = 0;
 
 
-        HybridHybridMessengerStrategy(std::shared_ptr<ResourcesManagerT> manager,
-                                      int const firstLevel)
+        /** ghostEncoding tells how E and B values are put on MPI streams when their level ghosts
+         * are filled, see FieldStreamEncoding. Ion moment ghosts are deposited from ghost
+         * particles and diagnostics are gathered through HDF5, neither goes through FieldData
+         * streams, so the encoding does not apply to them.
+         */
+        HybridHybridMessengerStrategy(
+            std::shared_ptr<ResourcesManagerT> manager, int const firstLevel,
+            FieldStreamEncoding const ghostEncoding = FieldStreamEncoding::Double)
             : HybridMessengerStrategy<HybridModel>{stratName}
             , resourcesManager_{std::move(manager)}
             , firstLevel_{firstLevel}
+            , ghostEncoding_{ghostEncoding}
         {
             resourcesManager_->registerResources(EM_old_);
             resourcesManager_->registerResources(Jold_);
@@ -149,6 +192,7 @@ namespace amr
             currentGhosts_.registerLevel(hierarchy, level);
 
             patchGhostParticles_.registerLevel(hierarchy, level);
+            particleMigrator_.registerLevel(hierarchy, level);
 
             // root level is not initialized with a schedule using coarser level data
             // so we don't create these schedules if root level
@@ -184,7 +228,14 @@ namespace amr
             auto level = hierarchy->getPatchLevel(levelNumber);
             magneticInit_.regrid(hierarchy, levelNumber, oldLevel, initDataTime);
             electricInit_.regrid(hierarchy, levelNumber, oldLevel, initDataTime);
+
+            // the regrid schedule copies domain particles from oldLevel where it overlaps the new
+            // level, and only splits coarser particles into newly refined cells
+            interiorParticleRefineOp_->resetRefinedCount();
             interiorParticles_.regrid(hierarchy, levelNumber, oldLevel, initDataTime);
+            updateRegridStats_(*level, model);
+            reportStreamStats_();
+
             patchGhostParticles_.fill(levelNumber, initDataTime);
             // we now call only levelGhostParticlesOld.fill() and not .regrid()
             // regrid() would refine from next coarser in regions of level not overlaping
@@ -204,6 +255,16 @@ namespace amr
 
 
 
+        /** @brief returns how many domain particles of the local patches of the given level were
+         * reused from the old level, or split from the coarser level, at its last regrid
+         */
+        ParticleRegridStats const& particleRegridStats(int const levelNumber) const
+        {
+            return particleRegridStats_.at(levelNumber);
+        }
+
+
+
         std::string fineModelName() const override { return HybridModel::model_name; }
 
 
@@ -257,14 +318,21 @@ namespace amr
             PHARE_LOG_STOP("hybhybmessengerStrat::initLevel : patch ghost part fill schedule");
 
 
-            levelGhostParticlesOld_.fill(levelNumber, initDataTime);
+            initLevelGhostParticles(model, level, initDataTime);
+
+            // computeIonMoments_(level, model);
+        }
 
 
+
+        void initLevelGhostParticles(IPhysicalModel& model, SAMRAI::hier::PatchLevel& level,
+                                     double const initDataTime) override
+        {
+            levelGhostParticlesOld_.fill(level.getLevelNumber(), initDataTime);
+
             // levelGhostParticles will be pushed during the advance phase
             // they need to be identical to levelGhostParticlesOld before advance
             copyLevelGhostOldToPushable_(level, model);
-
-            // computeIonMoments_(level, model);
         }
 
 
@@ -317,9 +385,13 @@ namespace amr
         /**
          * @brief fillIonGhostParticles will fill the interior ghost particle array from neighbor
          * patches of the same level. Before doing that, it empties the array for all populations
+         *
+         * This is done at each time step, so rather than going through the patchGhostParticles_
+         * refine schedules, particles are sent directly to neighbor patches by the
+         * particleMigrator_, on routes computed when the level was registered.
          */
         void fillIonGhostParticles(IonsT& ions, SAMRAI::hier::PatchLevel& level,
-                                   double const fillTime) override
+                                   [[maybe_unused]] double const fillTime) override
         {
             PHARE_LOG_SCOPE("HybridHybridMessengerStrategy::fillIonGhostParticles");
 
@@ -332,7 +404,7 @@ namespace amr
                 }
             }
 
-            patchGhostParticles_.fill(level.getLevelNumber(), fillTime);
+            particleMigrator_.fill(level);
         }
 
 
@@ -367,23 +439,25 @@ namespace amr
 
                 for (auto& pop : ions)
                 {
-                    // first thing to do is to project patchGhostParitcles moments
+                    // patchGhostParticles moments are projected as is
                     auto& patchGhosts = pop.patchGhostParticles();
                     auto& density     = pop.density();
                     auto& flux        = pop.flux();
 
-                    interpolate_(makeRange(patchGhosts), density, flux, layout);
-
                     if (level.getLevelNumber() > 0) // no levelGhost on root level
                     {
-                        // then grab levelGhostParticlesOld and levelGhostParticlesNew
-                        // and project them with alpha and (1-alpha) coefs, respectively
+                        // levelGhostParticlesOld and levelGhostParticlesNew are projected
+                        // with (1-alpha) and alpha coefs, respectively, in the same deposit
                         auto& levelGhostOld = pop.levelGhostParticlesOld();
-                        interpolate_(makeRange(levelGhostOld), density, flux, layout, 1. - alpha);
-
                         auto& levelGhostNew = pop.levelGhostParticlesNew();
-                        interpolate_(makeRange(levelGhostNew), density, flux, layout, alpha);
+
+                        interpolate_.depositRanges(
+                            density, flux, layout, std::make_pair(makeRange(patchGhosts), 1.),
+                            std::make_pair(makeRange(levelGhostOld), 1. - alpha),
+                            std::make_pair(makeRange(levelGhostNew), alpha));
                     }
+                    else
+                        interpolate_(makeRange(patchGhosts), density, flux, layout);
                 }
             }
         }
@@ -570,12 +644,12 @@ namespace amr
             fillRefiners_(info->ghostElectric, info->modelElectric, VecFieldDescriptor{Eold},
                           electricSharedNodes_, fieldNodeRefineOp_);
             fillRefiners_(info->ghostElectric, info->modelElectric, VecFieldDescriptor{Eold},
-                          electricGhosts_);
+                          electricGhosts_, ghostEncoding_);
 
             fillRefiners_(info->ghostMagnetic, info->modelMagnetic, VecFieldDescriptor{Bold},
                           magneticSharedNodes_, fieldNodeRefineOp_);
             fillRefiners_(info->ghostMagnetic, info->modelMagnetic, VecFieldDescriptor{Bold},
-                          magneticGhosts_);
+                          magneticGhosts_, ghostEncoding_);
 
             fillRefiners_(info->ghostCurrent, info->modelCurrent, VecFieldDescriptor{Jold_},
                           currentSharedNodes_, fieldNodeRefineOp_);
@@ -616,6 +690,14 @@ namespace amr
 
             fillRefiners_(info->patchGhostParticles, nullptr, patchGhostParticles_,
                           info->patchGhostParticles);
+
+            for (auto const& name : info->patchGhostParticles)
+            {
+                auto id = resourcesManager_->getID(name);
+                if (!id)
+                    throw std::runtime_error(name + " is not registered to the ResourcesManager");
+                particleMigrator_.add(*id);
+            }
         }
 
 
@@ -657,12 +739,13 @@ namespace amr
         void fillRefiners_(std::vector<VecFieldDescriptor> const& ghostVecs,
                            VecFieldDescriptor const& modelVec,
                            VecFieldDescriptor const& oldModelVec, RefinerPool<RefineType>& refiners,
-                           std::shared_ptr<SAMRAI::hier::RefineOperator>& refineOp)
+                           std::shared_ptr<SAMRAI::hier::RefineOperator>& refineOp,
+                           FieldStreamEncoding const encoding = FieldStreamEncoding::Double)
         {
             for (auto const& ghostVec : ghostVecs)
             {
                 refiners.add(ghostVec, modelVec, oldModelVec, resourcesManager_, refineOp,
-                             fieldTimeOp_, ghostVec.vecName);
+                             fieldTimeOp_, ghostVec.vecName, encoding);
             }
         }
 
@@ -670,9 +753,10 @@ namespace amr
         template<typename RefinerT, RefinerT RefineType>
         void fillRefiners_(std::vector<VecFieldDescriptor> const& ghostVecs,
                            VecFieldDescriptor const& modelVec,
-                           VecFieldDescriptor const& oldModelVec, RefinerPool<RefineType>& refiners)
+                           VecFieldDescriptor const& oldModelVec, RefinerPool<RefineType>& refiners,
+                           FieldStreamEncoding const encoding = FieldStreamEncoding::Double)
         {
-            fillRefiners_(ghostVecs, modelVec, oldModelVec, refiners, fieldRefineOp_);
+            fillRefiners_(ghostVecs, modelVec, oldModelVec, refiners, fieldRefineOp_, encoding);
         }
 
 
@@ -714,11 +798,76 @@ namespace amr
 
 
 
-        double timeInterpCoef_(double const beforePushTime, double const afterPushTime,
+        void updateRegridStats_(SAMRAI::hier::PatchLevel& level, IPhysicalModel& model)
+        {
+            auto& hybridModel = static_cast<HybridModel&>(model);
+
+            std::size_t nbrParticles = 0;
+            for (auto& patch : level)
+            {
+                auto& ions       = hybridModel.state.ions;
+                auto dataOnPatch = resourcesManager_->setOnPatch(*patch, ions);
+                for (auto& pop : ions)
+                    nbrParticles += pop.domainParticles().size();
+            }
+
+            auto& stats    = particleRegridStats_[level.getLevelNumber()];
+            stats.nbrSplit = interiorParticleRefineOp_->refinedCount();
+            // split particles are only put in cells that oldLevel did not cover
+            stats.nbrReused = nbrParticles - stats.nbrSplit;
+
+            // regrid is collective over the level, the counts of all ranks are summed
+            auto const total = core::mpi::sum(std::vector<double>{
+                static_cast<double>(stats.nbrReused), static_cast<double>(stats.nbrSplit)});
+
+            if (core::mpi::rank() == 0)
+                std::cout << "regrid level " << level.getLevelNumber() << " : "
+                          << static_cast<std::size_t>(total[0])
+                          << " particles reused from old level, "
+                          << static_cast<std::size_t>(total[1]) << " split from coarser level\n";
+        }
+
+
+
+
+        /** @brief logs on rank 0 how many bytes the encoding of E and B level ghosts has put on
+         * MPI streams so far, summed over ranks, compared to what double values would have cost
+         */
+        void reportStreamStats_() const
+        {
+            if (ghostEncoding_ == FieldStreamEncoding::Double)
+                return;
+
+            FieldStreamStats local;
+            for (auto const* ghosts : {&electricGhosts_, &magneticGhosts_})
+                for (auto const& [key, stats] : ghosts->streamStats())
+                    local += stats;
+
+            auto const total = core::mpi::sum(std::vector<double>{
+                static_cast<double>(local.rawBytes), static_cast<double>(local.wireBytes)});
+
+            if (core::mpi::rank() == 0)
+            {
+                PHARE_LOG_LINE_STR("E/B ghost streams ("
+                                   << to_string(ghostEncoding_) << " encoding) : "
+                                   << static_cast<std::size_t>(total[1]) << " bytes sent for "
+                                   << static_cast<std::size_t>(total[0])
+                                   << " bytes of double values");
+            }
+        }
+
+
+
+
+        /** @brief returns where afterPushTime is within the coarser time step the level is
+         * subcycling in, 0 at its start and 1 at its end, whatever the number and the size of the
+         * substeps taken so far
+         */
+        double timeInterpCoef_(double const /*beforePushTime*/, double const afterPushTime,
                                std::size_t levelNumber)
         {
-            return (afterPushTime - beforePushTime)
-                   / (afterPushCoarseTime_[levelNumber] - beforePushCoarseTime_[levelNumber]);
+            return subcycleTimeInterpCoef(beforePushCoarseTime_[levelNumber],
+                                          afterPushCoarseTime_[levelNumber], afterPushTime);
         }
 
 
@@ -736,6 +885,7 @@ namespace amr
 
 
         int const firstLevel_;
+        FieldStreamEncoding const ghostEncoding_;
         std::unordered_map<std::size_t, double> beforePushCoarseTime_;
         std::unordered_map<std::size_t, double> afterPushCoarseTime_;
 
@@ -774,6 +924,9 @@ namespace amr
         // keys : model particles (initialization and 2nd push), temporaryParticles (firstPush)
         RefinerPool<RefinerType::InteriorGhostParticles> patchGhostParticles_;
 
+        //! refills patch ghost particles at each time step, without refine schedules
+        ParticleMigrator<ParticleArrayT> particleMigrator_;
+
         SynchronizerPool<dimension> densitySynchronizers_;
 
         SynchronizerPool<dimension> ionBulkVelSynchronizers_;
@@ -795,9 +948,11 @@ namespace amr
             std::make_shared<FieldLinearTimeInterpolate<GridLayoutT, FieldT>>()};
 
 
-        std::shared_ptr<SAMRAI::hier::RefineOperator> interiorParticleRefineOp_{
+        std::shared_ptr<InteriorParticleRefineOp> interiorParticleRefineOp_{
             std::make_shared<InteriorParticleRefineOp>()};
 
+        std::unordered_map<int, ParticleRegridStats> particleRegridStats_;
+
         std::shared_ptr<SAMRAI::hier::RefineOperator> levelGhostParticlesOldOp_{
             std::make_shared<CoarseToFineRefineOpOld>()};
 
@@ -145,6 +145,18 @@ namespace amr
         }
 
 
+
+        /**
+         * @brief initLevelGhostParticles fills the level ghost particles of a new level from the
+         * coarser one, for levels whose domain is not initialized by initLevel (restarts)
+         */
+        void initLevelGhostParticles(IPhysicalModel& model, SAMRAI::hier::PatchLevel& level,
+                                     double const initDataTime)
+        {
+            strat_->initLevelGhostParticles(model, level, initDataTime);
+        }
+
+
         /**
          * @brief see IMessenger::firstStep
          * @param model
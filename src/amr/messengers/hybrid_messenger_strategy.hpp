@@ -64,6 +64,11 @@ namespace amr
                                double const initDataTime)
             = 0;
 
+        // used during the creation of a level whose domain is not filled from coarser data
+        virtual void initLevelGhostParticles(IPhysicalModel& model, SAMRAI::hier::PatchLevel& level,
+                                             double const initDataTime)
+            = 0;
+
         // ghost filling
 
         // used during solver advance
@@ -46,8 +46,12 @@ public:
                   "MHDModel::dimension != HybridModel::dimension");
 
 
-    MessengerFactory(std::vector<MessengerDescriptor> messengerDescriptors)
+    /** ghostEncoding is how hybrid messengers put E and B on MPI streams to fill level ghosts
+     */
+    MessengerFactory(std::vector<MessengerDescriptor> messengerDescriptors,
+                     FieldStreamEncoding const ghostEncoding = FieldStreamEncoding::Double)
         : descriptors_{messengerDescriptors}
+        , ghostEncoding_{ghostEncoding}
     {
     }
 
@@ -86,7 +90,7 @@ public:
             auto resourcesManager = dynamic_cast<HybridModel const&>(coarseModel).resourcesManager;
 
             auto messengerStrategy = std::make_unique<HybridHybridMessengerStrategy_t>(
-                std::move(resourcesManager), firstLevel);
+                std::move(resourcesManager), firstLevel, ghostEncoding_);
 
             return std::make_unique<HybridMessenger<HybridModel>>(std::move(messengerStrategy));
         }
@@ -124,6 +128,7 @@ public:
 
 private:
     std::vector<MessengerDescriptor> descriptors_;
+    FieldStreamEncoding const ghostEncoding_;
 };
 
 } // namespace PHARE::amr
@@ -93,6 +93,12 @@ namespace amr
         {
         }
 
+        void initLevelGhostParticles(IPhysicalModel& /*model*/,
+                                     SAMRAI::hier::PatchLevel& /*level*/,
+                                     double const /*initDataTime*/) override
+        {
+        }
+
         virtual ~MHDHybridMessengerStrategy() = default;
 
 
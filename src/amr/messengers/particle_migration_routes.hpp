@@ -0,0 +1,137 @@
+#ifndef PHARE_AMR_MESSENGERS_PARTICLE_MIGRATION_ROUTES_HPP
+#define PHARE_AMR_MESSENGERS_PARTICLE_MIGRATION_ROUTES_HPP
+
+#include "core/utilities/box/box.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <tuple>
+#include <vector>
+
+namespace PHARE::amr
+{
+/** \brief MigrationPatch describes a patch of a level for the particle migration, it is
+ * identified by the rank owning it and its local id on that rank
+ */
+template<std::size_t dim>
+struct MigrationPatch
+{
+    int rank;
+    int localId;
+    core::Box<int, dim> box;
+};
+
+
+
+/** \brief MigrationRoute tells that the domain particles of the source patch found in the
+ * selection box (in the source index space) go to the patch ghost particles of the destination
+ * patch, after their iCell has been shifted by offset (non zero for periodic neighbors)
+ */
+template<std::size_t dim>
+struct MigrationRoute
+{
+    int srcRank;
+    int srcLocalId;
+    int destRank;
+    int destLocalId;
+    core::Box<int, dim> selectionBox;
+    std::array<int, dim> offset;
+};
+
+
+
+/** \brief MigrationNeighbor is a patch found in the overlap connector of a level as a neighbor of
+ * a local patch. patch.box is where the neighbor is seen from the local patch: for a periodic
+ * image, the neighbor patch box shifted by shift, which is zero otherwise.
+ */
+template<std::size_t dim>
+struct MigrationNeighbor
+{
+    MigrationPatch<dim> patch;
+    std::array<int, dim> shift;
+};
+
+
+
+/** \brief MigrationNeighborhood is a local patch with its neighbors, those of its periodic
+ * images included, whose box overlaps its ghost layer
+ */
+template<std::size_t dim>
+struct MigrationNeighborhood
+{
+    MigrationPatch<dim> patch;
+    std::vector<MigrationNeighbor<dim>> neighbors;
+};
+
+
+
+/** @brief computes the routes by which the domain particles of a patch of the level are copied
+ * into the ghost layer of its neighbors, periodic neighbors included, for routes where rank owns
+ * the source or the destination patch
+ *
+ * neighborhoods are those of the local patches of rank, the cost is thus proportional to the
+ * number of local patches and of their neighbors. A route between two ranks is found by both,
+ * the sending rank from the neighborhood of its source patch and the receiving rank from that of
+ * its destination patch, with the same values. Routes are ordered by source, destination and
+ * offset, two ranks therefore know without further communication which routes they share and in
+ * which order particles are streamed between them.
+ */
+template<std::size_t dim>
+std::vector<MigrationRoute<dim>>
+makeMigrationRoutes(int const rank, std::vector<MigrationNeighborhood<dim>> const& neighborhoods,
+                    int const ghostWidth)
+{
+    auto shifted = [](core::Box<int, dim> box, std::array<int, dim> const& shift, int sign) {
+        for (std::size_t iDim = 0; iDim < dim; ++iDim)
+        {
+            box.lower[iDim] += sign * shift[iDim];
+            box.upper[iDim] += sign * shift[iDim];
+        }
+        return box;
+    };
+
+    std::vector<MigrationRoute<dim>> routes;
+    for (auto const& [local, neighbors] : neighborhoods)
+    {
+        auto const localGhostBox = core::grow(local.box, ghostWidth);
+
+        for (auto const& [neighbor, shift] : neighbors)
+        {
+            bool const isZeroShift = shift == std::array<int, dim>{};
+            if (isZeroShift and neighbor.rank == local.rank and neighbor.localId == local.localId)
+                continue;
+
+            // neighbor to local: selected in the neighbor index space, shifted into the local one
+            if (auto overlap = neighbor.box * localGhostBox)
+                routes.push_back({neighbor.rank, neighbor.localId, local.rank, local.localId,
+                                  shifted(*overlap, shift, -1), shift});
+
+            // local to neighbor: routes between local patches are found once, as a destination
+            if (neighbor.rank == rank)
+                continue;
+
+            if (auto overlap = local.box * core::grow(neighbor.box, ghostWidth))
+            {
+                std::array<int, dim> offset;
+                for (std::size_t iDim = 0; iDim < dim; ++iDim)
+                    offset[iDim] = -shift[iDim];
+                routes.push_back(
+                    {local.rank, local.localId, neighbor.rank, neighbor.localId, *overlap, offset});
+            }
+        }
+    }
+
+    auto key = [](auto const& route) {
+        return std::tie(route.srcRank, route.srcLocalId, route.destRank, route.destLocalId,
+                        route.offset);
+    };
+    std::sort(std::begin(routes), std::end(routes),
+              [&](auto const& r1, auto const& r2) { return key(r1) < key(r2); });
+    return routes;
+}
+
+
+} // namespace PHARE::amr
+
+#endif
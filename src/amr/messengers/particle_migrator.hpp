@@ -0,0 +1,366 @@
+#ifndef PHARE_AMR_MESSENGERS_PARTICLE_MIGRATOR_HPP
+#define PHARE_AMR_MESSENGERS_PARTICLE_MIGRATOR_HPP
+
+#include "amr/data/particles/particles_data.hpp"
+#include "amr/messengers/particle_migration_routes.hpp"
+#include "amr/utilities/box/amr_box.hpp"
+
+#include "core/logger.hpp"
+
+#include <SAMRAI/hier/BoxLevel.h>
+#include <SAMRAI/hier/Connector.h>
+#include <SAMRAI/hier/PeriodicShiftCatalog.h>
+#include <SAMRAI/hier/PatchHierarchy.h>
+#include <SAMRAI/hier/PatchLevel.h>
+
+#include "mpi.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace PHARE::amr
+{
+/** \brief ParticleMigrator copies the domain particles of each patch of a level into the patch
+ * ghost particle arrays of its neighbors, without SAMRAI refine schedules
+ *
+ * Routes between neighbor patches (see makeMigrationRoutes) are computed once in registerLevel(),
+ * that is every time the level is created or regridded, from the neighborhoods of the local
+ * patches in the overlap connector of the level. Each fill() then:
+ *  - selects the particles of each route with the CellMap of the source domain particle array
+ *  - copies them directly into the destination patch ghost array if the destination is local
+ *  - otherwise buffers them per neighbor rank. Per route particle counts are exchanged with
+ *    persistent MPI requests set up at registerLevel(), and particles are then sent in one
+ *    message per neighbor rank, split if larger than MPI int counts allow. Messages of a level
+ *    go on its own duplicate of the level communicator.
+ *
+ * As for the InteriorGhostParticles refiners it replaces, destination patch ghost arrays are
+ * expected to have been emptied before fill().
+ */
+template<typename ParticleArray>
+class ParticleMigrator
+{
+    static constexpr auto dim = ParticleArray::dimension;
+    using Particle_t          = typename ParticleArray::Particle_t;
+    using ParticlesData_t     = ParticlesData<ParticleArray>;
+    using Count               = std::uint64_t;
+
+    static_assert(std::is_trivially_copyable_v<Particle_t>,
+                  "particles are sent as raw bytes and need to be trivially copyable");
+
+    // messages go on a communicator duplicated per level, so these tags can not match messages
+    // posted by SAMRAI or by other levels
+    static constexpr int countTag    = 0;
+    static constexpr int particleTag = 1;
+
+
+    struct Peer
+    {
+        int rank;
+        std::vector<MigrationRoute<dim>> routes; //! in the same order on both ranks
+        std::vector<Count> counts;               //! one per route and particle data id
+        std::vector<Particle_t> particles;
+    };
+
+
+    struct LevelRoutes
+    {
+        MPI_Comm comm = MPI_COMM_NULL;
+        std::vector<MigrationRoute<dim>> localRoutes;
+        std::vector<Peer> sendPeers;
+        std::vector<Peer> recvPeers;
+        std::vector<MPI_Request> countRequests;
+
+        LevelRoutes() = default;
+
+        LevelRoutes(LevelRoutes const&) = delete;
+        LevelRoutes& operator=(LevelRoutes const&) = delete;
+
+        ~LevelRoutes()
+        {
+            int finalized = 0;
+            MPI_Finalized(&finalized);
+            if (finalized)
+                return;
+
+            for (auto& request : countRequests)
+                MPI_Request_free(&request);
+
+            if (comm != MPI_COMM_NULL)
+                MPI_Comm_free(&comm);
+        }
+    };
+
+
+public:
+    ParticleMigrator() = default;
+
+    ParticleMigrator(ParticleMigrator const&) = delete;
+    ParticleMigrator& operator=(ParticleMigrator const&) = delete;
+
+
+    /** @brief adds the ParticlesData (typically one per population) for which patch ghost
+     * particles are to be filled. Must be called before levels are registered.
+     */
+    void add(int const particlesDataId) { dataIds_.push_back(particlesDataId); }
+
+
+
+    /** @brief computes the routes of the given level and sets up the persistent requests used to
+     * exchange particle counts with neighbor ranks. This is collective over the ranks of the
+     * level.
+     */
+    void registerLevel(std::shared_ptr<SAMRAI::hier::PatchHierarchy> const& hierarchy,
+                       std::shared_ptr<SAMRAI::hier::PatchLevel> const& level)
+    {
+        PHARE_LOG_SCOPE("ParticleMigrator::registerLevel");
+
+        if (dataIds_.empty())
+            return;
+
+        auto const& boxLevel = *level->getBoxLevel();
+        auto const& mpi      = boxLevel.getMPI();
+        int const myRank     = mpi.getRank();
+
+        auto const ghostWidth = level->getPatchDescriptor()
+                                    ->getPatchDataFactory(dataIds_[0])
+                                    ->getGhostCellWidth()[0];
+
+        // neighbors of the local patches are those of the level overlap connector, periodic
+        // images included, so that routes cost no more than the local neighborhoods
+        auto const& connector = boxLevel.findConnector(
+            boxLevel, SAMRAI::hier::IntVector{SAMRAI::tbox::Dimension{dim}, ghostWidth},
+            SAMRAI::hier::CONNECTOR_IMPLICIT_CREATION_RULE);
+        auto const& shiftCatalog = hierarchy->getGridGeometry()->getPeriodicShiftCatalog();
+        auto const& ratio        = level->getRatioToLevelZero();
+
+        std::vector<MigrationNeighborhood<dim>> neighborhoods;
+        for (auto base = connector.begin(); base != connector.end(); ++base)
+        {
+            auto const& localBox = *boxLevel.getBoxStrict(*base);
+            auto& neighborhood   = neighborhoods.emplace_back();
+            neighborhood.patch
+                = {myRank, localBox.getLocalId().getValue(), phare_box_from<dim>(localBox)};
+
+            for (auto nbr = connector.begin(base); nbr != connector.end(base); ++nbr)
+            {
+                std::array<int, dim> shift{};
+                if (nbr->isPeriodicImage())
+                {
+                    auto const distance
+                        = shiftCatalog.shiftNumberToShiftDistance(nbr->getPeriodicId()) * ratio;
+                    for (std::size_t iDim = 0; iDim < dim; ++iDim)
+                        shift[iDim] = distance[iDim];
+                }
+                neighborhood.neighbors.push_back({{nbr->getOwnerRank(),
+                                                   nbr->getLocalId().getValue(),
+                                                   phare_box_from<dim>(*nbr)},
+                                                  shift});
+            }
+        }
+
+        auto levelRoutes = std::make_unique<LevelRoutes>();
+        MPI_Comm_dup(mpi.getCommunicator(), &levelRoutes->comm);
+
+        std::map<int, Peer> sendPeers, recvPeers;
+        for (auto const& route : makeMigrationRoutes(myRank, neighborhoods, ghostWidth))
+        {
+            if (route.srcRank == myRank and route.destRank == myRank)
+                levelRoutes->localRoutes.push_back(route);
+            else if (route.srcRank == myRank)
+                sendPeers[route.destRank].routes.push_back(route);
+            else if (route.destRank == myRank)
+                recvPeers[route.srcRank].routes.push_back(route);
+        }
+
+        auto makePeers = [&](auto& peers) {
+            std::vector<Peer> peerList;
+            for (auto& [rank, peer] : peers)
+            {
+                peer.rank = rank;
+                peer.counts.resize(peer.routes.size() * dataIds_.size());
+                peerList.push_back(std::move(peer));
+            }
+            return peerList;
+        };
+        levelRoutes->sendPeers = makePeers(sendPeers);
+        levelRoutes->recvPeers = makePeers(recvPeers);
+
+        // count buffers are not resized until the level is registered again, so requests can be
+        // persistent
+        for (auto& peer : levelRoutes->recvPeers)
+        {
+            auto& request = levelRoutes->countRequests.emplace_back();
+            MPI_Recv_init(peer.counts.data(), static_cast<int>(peer.counts.size()), MPI_UINT64_T,
+                          peer.rank, countTag, levelRoutes->comm, &request);
+        }
+        for (auto& peer : levelRoutes->sendPeers)
+        {
+            auto& request = levelRoutes->countRequests.emplace_back();
+            MPI_Send_init(peer.counts.data(), static_cast<int>(peer.counts.size()), MPI_UINT64_T,
+                          peer.rank, countTag, levelRoutes->comm, &request);
+        }
+
+        levels_[level->getLevelNumber()] = std::move(levelRoutes);
+    }
+
+
+
+    /** @brief fills the patch ghost particles of all registered ParticlesData on the level */
+    void fill(SAMRAI::hier::PatchLevel& level)
+    {
+        PHARE_LOG_SCOPE("ParticleMigrator::fill");
+
+        if (dataIds_.empty())
+            return;
+
+        auto it = levels_.find(level.getLevelNumber());
+        if (it == levels_.end())
+            throw std::runtime_error("ParticleMigrator: level "
+                                     + std::to_string(level.getLevelNumber())
+                                     + " is not registered");
+        auto& levelRoutes = *it->second;
+
+        std::unordered_map<int, SAMRAI::hier::Patch*> patches;
+        for (auto& patch : level)
+            patches[patch->getBox().getLocalId().getValue()] = patch.get();
+
+        auto particlesData = [&](int localId, int dataId) -> ParticlesData_t& {
+            return dynamic_cast<ParticlesData_t&>(*patches.at(localId)->getPatchData(dataId));
+        };
+
+        for (auto& peer : levelRoutes.sendPeers)
+            pack_(peer, particlesData);
+
+        if (!levelRoutes.countRequests.empty())
+        {
+            MPI_Startall(static_cast<int>(levelRoutes.countRequests.size()),
+                         levelRoutes.countRequests.data());
+        }
+
+        // routes between local patches are done while counts are on the wire
+        for (auto const& route : levelRoutes.localRoutes)
+            for (auto const& dataId : dataIds_)
+            {
+                auto const& src = particlesData(route.srcLocalId, dataId).domainParticles;
+                auto& dest      = particlesData(route.destLocalId, dataId).patchGhostParticles;
+                src.export_particles(route.selectionBox, dest, offseter_(route));
+            }
+
+        if (!levelRoutes.countRequests.empty())
+        {
+            MPI_Waitall(static_cast<int>(levelRoutes.countRequests.size()),
+                        levelRoutes.countRequests.data(), MPI_STATUSES_IGNORE);
+        }
+
+        std::vector<MPI_Request> requests;
+        for (auto& peer : levelRoutes.recvPeers)
+        {
+            Count nbrParticles = 0;
+            for (auto const& count : peer.counts)
+                nbrParticles += count;
+            peer.particles.resize(nbrParticles);
+
+            forEachMessage_(peer.particles, [&](auto* data, int nbrBytes) {
+                MPI_Irecv(data, nbrBytes, MPI_BYTE, peer.rank, particleTag, levelRoutes.comm,
+                          &requests.emplace_back());
+            });
+        }
+        for (auto& peer : levelRoutes.sendPeers)
+        {
+            forEachMessage_(peer.particles, [&](auto* data, int nbrBytes) {
+                MPI_Isend(data, nbrBytes, MPI_BYTE, peer.rank, particleTag, levelRoutes.comm,
+                          &requests.emplace_back());
+            });
+        }
+        MPI_Waitall(static_cast<int>(requests.size()), requests.data(), MPI_STATUSES_IGNORE);
+
+        for (auto& peer : levelRoutes.recvPeers)
+            unpack_(peer, particlesData);
+    }
+
+
+
+private:
+    /** @brief calls post(data, nbrBytes) for consecutive slices of the particles, each of at most
+     * INT_MAX bytes as MPI counts are int. Messages between two ranks on the same communicator
+     * and tag are matched in order, so both sides slice the same number of particles alike.
+     */
+    template<typename Post>
+    static void forEachMessage_(std::vector<Particle_t>& particles, Post&& post)
+    {
+        std::size_t constexpr maxParticles
+            = static_cast<std::size_t>(std::numeric_limits<int>::max()) / sizeof(Particle_t);
+
+        for (std::size_t first = 0; first < particles.size(); first += maxParticles)
+        {
+            auto const nbrParticles = std::min(maxParticles, particles.size() - first);
+            post(particles.data() + first, static_cast<int>(nbrParticles * sizeof(Particle_t)));
+        }
+    }
+
+
+    static auto offseter_(MigrationRoute<dim> const& route)
+    {
+        return [&offset = route.offset](auto const& particle) {
+            auto shiftedParticle{particle};
+            for (std::size_t iDim = 0; iDim < dim; ++iDim)
+                shiftedParticle.iCell[iDim] += offset[iDim];
+            return shiftedParticle;
+        };
+    }
+
+
+
+    template<typename GetData>
+    void pack_(Peer& peer, GetData&& particlesData) const
+    {
+        peer.particles.clear();
+
+        auto count = std::begin(peer.counts);
+        for (auto const& route : peer.routes)
+            for (auto const& dataId : dataIds_)
+            {
+                auto const& src = particlesData(route.srcLocalId, dataId).domainParticles;
+                auto const before = peer.particles.size();
+                src.export_particles(route.selectionBox, peer.particles, offseter_(route));
+                *count++ = peer.particles.size() - before;
+            }
+    }
+
+
+
+    template<typename GetData>
+    void unpack_(Peer const& peer, GetData&& particlesData) const
+    {
+        auto particle = std::begin(peer.particles);
+        auto count    = std::begin(peer.counts);
+        for (auto const& route : peer.routes)
+            for (auto const& dataId : dataIds_)
+            {
+                auto& dest = particlesData(route.destLocalId, dataId).patchGhostParticles;
+                dest.reserve(dest.size() + *count);
+                for (Count i = 0; i < *count; ++i)
+                    dest.push_back(*particle++);
+                ++count;
+            }
+    }
+
+
+
+    std::vector<int> dataIds_;
+    std::unordered_map<int, std::unique_ptr<LevelRoutes>> levels_;
+};
+
+} // namespace PHARE::amr
+
+#endif
@@ -63,6 +63,9 @@ namespace amr
     public:
         std::vector<std::unique_ptr<Algorithm>> algos;
 
+        //! field fill patterns used by the algorithms, kept to report their stream statistics
+        std::vector<std::shared_ptr<FieldFillPattern>> fieldFillPatterns;
+
         auto& add_algorithm()
         {
             if constexpr (is_refiner<ComType>)
@@ -109,6 +112,20 @@ namespace amr
         {
             add(algo, schedule, levelNumber);
         }
+
+
+
+        /**
+         * @brief streamStats returns the bytes packed by FieldData on streams for all the
+         * schedules of this communicator using a FieldFillPattern
+         */
+        FieldStreamStats streamStats() const
+        {
+            FieldStreamStats stats;
+            for (auto const& fillPattern : fieldFillPatterns)
+                stats += fillPattern->streamStats();
+            return stats;
+        }
     };
 
 
@@ -130,6 +147,7 @@ namespace amr
      * @param rm is the ResourcesManager
      * @param refineOp is the spatial refinement operator
      * @param timeOp is the time interpolator
+     * @param encoding is how field values are put on the MPI streams of the schedules
      *
      * @return the function returns a QuantityRefiner which may be stored in a RefinerPool and to
      * which later schedules will be added.
@@ -139,11 +157,13 @@ namespace amr
     makeRefiner(VecFieldDescriptor const& ghost, VecFieldDescriptor const& model,
                 VecFieldDescriptor const& oldModel, std::shared_ptr<ResourcesManager> const& rm,
                 std::shared_ptr<SAMRAI::hier::RefineOperator> refineOp,
-                std::shared_ptr<SAMRAI::hier::TimeInterpolateOperator> timeOp)
+                std::shared_ptr<SAMRAI::hier::TimeInterpolateOperator> timeOp,
+                FieldStreamEncoding encoding = FieldStreamEncoding::Double)
     {
-        auto variableFillPattern = FieldFillPattern::make_shared(refineOp);
+        auto variableFillPattern = FieldFillPattern::make_shared(refineOp, encoding);
 
         Communicator<Refiner> com;
+        com.fieldFillPatterns.push_back(variableFillPattern);
 
         auto registerRefine
             = [&rm, &com, &refineOp, &timeOp](std::string const& ghost_, std::string const& model_,
@@ -225,8 +245,12 @@ namespace amr
 
 
     /**
-     * @brief makeInitRefiner is similar to makeGhostRefiner except the registerRefine() that is
-     * called is the one that allows initialization of a vector field quantity.
+     * @brief makeSynchronizer creates a Communicator coarsening the three components of a vector
+     * field, each with its own CoarsenAlgorithm.
+     *
+     * Components must not share an algorithm: their patch data factories are equivalent for
+     * SAMRAI, which then computes the overlaps of the first component only and uses them for the
+     * others, whatever their centering.
      */
     template<typename ResourcesManager, std::size_t dimension>
     Communicator<Synchronizer, dimension>
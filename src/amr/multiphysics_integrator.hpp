@@ -2,6 +2,8 @@
 #ifndef PHARE_MULTIPHYSICS_INTEGRATOR_HPP
 #define PHARE_MULTIPHYSICS_INTEGRATOR_HPP
 
+#include <algorithm>
+#include <limits>
 #include <map>
 #include <memory>
 #include <string>
@@ -30,6 +32,7 @@
 #include "amr/solvers/solver_ppc.hpp"
 
 #include "core/utilities/algorithm.hpp"
+#include "core/utilities/mpi_utils.hpp"
 
 #include "phare_core.hpp"
 
@@ -112,6 +115,15 @@ namespace solver
 
             //@TODO - chaque modele utilisé doit register ses variables aupres du ResourcesManager
             //@TODO - chaque solveur utilisé doit register ses variables aupres du ResourcesManager
+
+            if (dict["AMR"].contains("time_refinement"))
+            {
+                auto const& timeRefinement = dict["AMR"]["time_refinement"];
+                adaptiveTimeRefinement_
+                    = timeRefinement["mode"].template to<std::string>() == "adaptive";
+                if (timeRefinement.contains("cfl"))
+                    timeRefinementCfl_ = timeRefinement["cfl"].template to<double>();
+            }
         }
 
 
@@ -211,6 +223,7 @@ namespace solver
 
             auto& model = getModel_(coarsestLevel);
             solver->registerResources(model);
+            solver->enableStableTimeStep(adaptiveTimeRefinement_);
 
 
             addSolver_(std::move(solver), coarsestLevel, finestLevel);
@@ -259,6 +272,45 @@ namespace solver
 
 
 
+
+        /**
+         * @brief solvers only estimate stable time steps if adaptive time stepping or adaptive time
+         * refinement uses them
+         */
+        void enableStableTimeStep(bool const adaptiveTimeStepping)
+        {
+            for (auto& solver : solvers_)
+                solver->enableStableTimeStep(adaptiveTimeStepping or adaptiveTimeRefinement_);
+        }
+
+
+
+
+        /**
+         * @brief returns the largest stable time step of the coarsest level over all ranks, given
+         * the stable time step of each level as estimated by its solver, and that finer levels are
+         * advanced with the time steps of getMaxFinerLevelDt(). With an adaptive time refinement,
+         * finer levels take as many substeps as they need and only the coarsest level matters.
+         * This is collective.
+         */
+        double stableTimeStep(SAMRAI::hier::PatchHierarchy const& hierarchy) const
+        {
+            double stableDt = std::numeric_limits<double>::max();
+
+            auto const nbrLevels = adaptiveTimeRefinement_ ? 1 : hierarchy.getNumberOfLevels();
+            for (auto iLevel = 0; iLevel < nbrLevels; ++iLevel)
+            {
+                auto const levelDt = getSolver_(iLevel).stableTimeStep(iLevel);
+                auto const ratio   = hierarchy.getPatchLevel(iLevel)->getRatioToLevelZero().max();
+                if (levelDt < std::numeric_limits<double>::max())
+                    stableDt = std::min(stableDt, levelDt * ratio * ratio);
+            }
+
+            return core::mpi::min(stableDt);
+        }
+
+
+
         // -----------------------------------------------------------------------------------------------
         //
         //                          SAMRAI StandardTagAndInitStrategy interface
@@ -303,6 +355,7 @@ namespace solver
             auto& levelInitializer = getLevelInitializer(model.name());
 
             bool const isRegridding = oldLevel != nullptr;
+            bool const hasTagger    = existTaggerOnRange_(levelNumber, levelNumber);
             auto level              = hierarchy->getPatchLevel(levelNumber);
 
             std::cout << "init level " << levelNumber << " with regriding = " << isRegridding
@@ -315,6 +368,8 @@ namespace solver
                     model.allocate(*patch, initDataTime);
                     solver.allocate(model, *patch, initDataTime);
                     messenger.allocate(*patch, initDataTime);
+                    if (hasTagger)
+                        getTagger_(levelNumber).allocate(*patch, initDataTime);
                 }
             }
 
@@ -331,6 +386,9 @@ namespace solver
                 {
                     messenger.registerLevel(hierarchy, ilvl);
                 }
+
+                if (hasTagger)
+                    getTagger_(levelNumber).regrid(hierarchy, levelNumber, oldLevel, initDataTime);
             }
             else
             {
@@ -394,16 +452,34 @@ namespace solver
         {
         }
 
-        double getLevelDt(std::shared_ptr<SAMRAI::hier::PatchLevel> const& /*level*/,
+        /**
+         * With an adaptive time refinement, the time step of a refined level is bounded by its
+         * stable time step, see levelDt_()
+         */
+        double getLevelDt(std::shared_ptr<SAMRAI::hier::PatchLevel> const& level,
                           double const dtTime, bool const /*initialTime*/) override
         {
+            if (adaptiveTimeRefinement_ and level->getLevelNumber() > 0)
+                return std::min(dtTime, levelDt_(level->getLevelNumber()));
             return dtTime;
         }
 
 
-        double getMaxFinerLevelDt(int const /*finerLevelNumber*/, double const coarseDt,
+        /**
+         * With an adaptive time refinement, a finer level that has already been advanced takes the
+         * largest time step its stability allows, up to the coarser time step, instead of a fixed
+         * fraction of it. SAMRAI then chooses the number of substeps to reach the coarser time.
+         */
+        double getMaxFinerLevelDt(int const finerLevelNumber, double const coarseDt,
                                   SAMRAI::hier::IntVector const& ratio) override
         {
+            if (adaptiveTimeRefinement_)
+            {
+                auto const levelDt = levelDt_(finerLevelNumber);
+                if (levelDt < std::numeric_limits<double>::max())
+                    return std::min(coarseDt, levelDt);
+            }
+
             // whistler waves require the dt ~ dx^2
             // so dividing the mesh size by ratio means dt
             // needs to be divided by ratio^2.
@@ -495,6 +571,10 @@ namespace solver
                 dump_(iLevel);
             }
 
+            // the returned value bounds the next time step of the level
+            if (adaptiveTimeRefinement_ and iLevel > 0)
+                return (levelDts_[iLevel] = reduceLevelDt_(iLevel));
+
             return newTime;
         }
 
@@ -556,6 +636,11 @@ namespace solver
         int nbrOfLevels_;
         std::unordered_map<std::size_t, double> subcycleEndTimes_;
         std::unordered_map<std::size_t, double> subcycleStartTimes_;
+
+        //! refined levels take a number of substeps given by their stability, not the ratio
+        bool adaptiveTimeRefinement_ = false;
+        double timeRefinementCfl_    = 0.5;
+        std::unordered_map<int, double> levelDts_; // see levelDt_()
         using IMessengerT       = amr::IMessenger<IPhysicalModel<AMR_Types>>;
         using LevelInitializerT = LevelInitializer<AMR_Types>;
         std::vector<LevelDescriptor> levelDescriptors_;
@@ -789,6 +874,28 @@ namespace solver
 
 
 
+        //! timeRefinementCfl_ times the stable time step of the level over all ranks, infinite
+        //! if the solver has no estimate for it yet. This is collective.
+        double reduceLevelDt_(int iLevel) const
+        {
+            auto const stableDt = core::mpi::min(getSolver_(iLevel).stableTimeStep(iLevel));
+            return stableDt < std::numeric_limits<double>::max() ? timeRefinementCfl_ * stableDt
+                                                                 : stableDt;
+        }
+
+
+        /** the time step bound of the level as reduced at the end of its last advance, so that
+         * SAMRAI callbacks, which not all ranks need to call, do not communicate
+         */
+        double levelDt_(int iLevel) const
+        {
+            auto it = levelDts_.find(iLevel);
+            return it != levelDts_.end() ? it->second : std::numeric_limits<double>::max();
+        }
+
+
+
+
         IPhysicalModel<AMR_Types>& getModel_(int iLevel)
         {
             return const_cast<IPhysicalModel<AMR_Types>&>(
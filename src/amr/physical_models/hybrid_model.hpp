@@ -4,6 +4,7 @@
 #ifndef PHARE_HYBRID_MODEL_HPP
 #define PHARE_HYBRID_MODEL_HPP
 
+#include <functional>
 #include <string>
 
 #include "initializer/data_provider.hpp"
@@ -100,6 +101,16 @@ public:
     //-------------------------------------------------------------------------
 
     std::unordered_map<std::string, std::shared_ptr<core::NdArrayVector<dimension, int>>> tags;
+
+    /**
+     * @brief when set, the level initializer fills the electromagnetic field and the domain
+     * particles of new levels from a restart file, instead of the initial conditions for the root
+     * level and after the refinement of the coarser level for the others
+     */
+    std::function<void(level_t&)> restartLoader;
+
+    //! set with restartLoader, true if the restart file has the data of the whole level
+    std::function<bool(level_t&)> restartCovers;
 };
 
 
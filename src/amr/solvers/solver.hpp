@@ -2,6 +2,7 @@
 #ifndef PHARE_SOLVER_HPP
 #define PHARE_SOLVER_HPP
 
+#include <limits>
 #include <string>
 
 #include <SAMRAI/hier/PatchHierarchy.h>
@@ -85,6 +86,26 @@ namespace solver
 
 
 
+        /**
+         * @brief stableTimeStep returns the largest time step at which the given level can be
+         * advanced stably, as estimated on the local patches at the end of its last advance. It is
+         * infinite if the solver has no estimate.
+         */
+        virtual double stableTimeStep(int const /*levelNumber*/) const
+        {
+            return std::numeric_limits<double>::max();
+        }
+
+
+        /**
+         * @brief the stable time step is only estimated once enabled, by adaptive time stepping
+         * or time refinement, since the estimate costs a pass on particles and fields per advance
+         */
+        virtual void enableStableTimeStep(bool /*enable*/) {}
+
+
+
+
         virtual ~ISolver() = default;
 
 
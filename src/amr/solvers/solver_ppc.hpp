@@ -24,13 +24,18 @@
 #include "core/numerics/ampere/ampere.hpp"
 #include "core/numerics/faraday/faraday.hpp"
 #include "core/numerics/ohm/ohm.hpp"
+#include "core/numerics/time_step/stable_time_step.hpp"
 
 #include "core/data/particles/particle_array.hpp"
 #include "core/data/vecfield/vecfield.hpp"
 #include "core/data/grid/gridlayout_utils.hpp"
 
 
+#include <algorithm>
+#include <cmath>
 #include <iomanip>
+#include <limits>
+#include <unordered_map>
 
 namespace PHARE::solver
 {
@@ -63,6 +68,16 @@ private:
     PHARE::core::Ohm<GridLayout> ohm_;
     PHARE::core::IonUpdater<Ions, Electromag, GridLayout> ionUpdater_;
 
+    //! particles are merged on levels from this one, if the ion updater has a merger
+    int mergerMinLevel_ = 1;
+    std::unordered_map<int, core::ParticleMergerStats> mergerStats_;
+
+    bool stableDtEnabled_ = false;
+    std::unordered_map<int, double> stableDt_;
+
+    //! Faraday, Ampere and Ohm are solved in this many substeps per predictor/corrector stage
+    std::size_t nbrFieldSubsteps_ = 1;
+
 
 
 public:
@@ -78,6 +93,17 @@ public:
         , ionUpdater_{dict["ion_updater"]}
 
     {
+        if (dict["ion_updater"].contains("merger")
+            and dict["ion_updater"]["merger"].contains("min_level"))
+            mergerMinLevel_ = dict["ion_updater"]["merger"]["min_level"].template to<int>();
+
+        if (dict.contains("field_substeps"))
+        {
+            auto const nbrSubsteps = dict["field_substeps"].template to<int>();
+            if (nbrSubsteps < 1)
+                throw std::runtime_error("SolverPPC: field_substeps must be at least 1");
+            nbrFieldSubsteps_ = static_cast<std::size_t>(nbrSubsteps);
+        }
     }
 
     virtual ~SolverPPC() = default;
@@ -101,6 +127,30 @@ public:
                               double const currentTime, double const newTime) override;
 
 
+    //! returns what the particle merger did on the local patches of the given level so far
+    core::ParticleMergerStats mergerStats(int const levelNumber) const
+    {
+        auto it = mergerStats_.find(levelNumber);
+        return it != mergerStats_.end() ? it->second : core::ParticleMergerStats{};
+    }
+
+
+    double stableTimeStep(int const levelNumber) const override
+    {
+        auto it = stableDt_.find(levelNumber);
+        return it != stableDt_.end() ? it->second : std::numeric_limits<double>::max();
+    }
+
+
+    void enableStableTimeStep(bool const enable) override
+    {
+        stableDtEnabled_ = enable;
+        ionUpdater_.trackMaxSpeed(enable);
+        if (!enable)
+            stableDt_.clear();
+    }
+
+
 
 private:
     using Messenger = amr::HybridMessenger<HybridModel>;
@@ -118,6 +168,11 @@ private:
                     double const currentTime, double const newTime);
 
 
+    void advanceFields_(level_t& level, HybridModel& model, Messenger& fromCoarser, VecFieldT& B,
+                        VecFieldT& E, Electromag& out, double const currentTime,
+                        double const newTime, bool const lastAmpere);
+
+
     void average_(level_t& level, HybridModel& model);
 
 
@@ -126,6 +181,9 @@ private:
                    core::UpdaterMode mode);
 
 
+    void computeStableTimeStep_(level_t& level, HybridModel& model);
+
+
     void saveState_(level_t& level, Ions& ions, ResourcesManager& rm);
 
     void restoreState_(level_t& level, Ions& ions, ResourcesManager& rm);
@@ -247,6 +305,9 @@ void SolverPPC<HybridModel, AMR_Types>::advanceLevel(std::shared_ptr<hierarchy_t
     auto level             = hierarchy->getPatchLevel(levelNumber);
 
 
+    if (stableDtEnabled_)
+        ionUpdater_.takeMaxSpeed(); // only the particles of this advance matter
+
     predictor1_(*level, hybridModel, fromCoarser, currentTime, newTime);
 
 
@@ -267,6 +328,9 @@ void SolverPPC<HybridModel, AMR_Types>::advanceLevel(std::shared_ptr<hierarchy_t
 
     corrector_(*level, hybridModel, fromCoarser, currentTime, newTime);
 
+    if (stableDtEnabled_)
+        computeStableTimeStep_(*level, hybridModel);
+
 
     // return newTime;
 }
@@ -274,87 +338,72 @@ void SolverPPC<HybridModel, AMR_Types>::advanceLevel(std::shared_ptr<hierarchy_t
 
 
 
+/**
+ * The stable time step of the level is the smallest of:
+ *  - the time for the fastest particle to cross a cell
+ *  - the time for waves to cross a cell, see core::stableWaveTimeStep
+ * with B the largest magnetic field magnitude and n the smallest non zero ion density of the local
+ * patches (ghost nodes included).
+ */
 template<typename HybridModel, typename AMR_Types>
-void SolverPPC<HybridModel, AMR_Types>::predictor1_(level_t& level, HybridModel& model,
-                                                    Messenger& fromCoarser,
-                                                    double const currentTime, double const newTime)
+void SolverPPC<HybridModel, AMR_Types>::computeStableTimeStep_(level_t& level, HybridModel& model)
 {
-    PHARE_LOG_SCOPE("SolverPPC::predictor1_");
-
-    auto& hybridState      = model.state;
-    auto& resourcesManager = model.resourcesManager;
-    auto dt                = newTime - currentTime;
-    auto& electromag       = hybridState.electromag;
-    auto levelNumber       = level.getLevelNumber();
-
-
-    {
-        PHARE_LOG_SCOPE("SolverPPC::predictor1_.faraday");
-
-        auto& Bpred = electromagPred_.B;
-        auto& B     = electromag.B;
-        auto& E     = electromag.E;
-
-        for (auto& patch : level)
-        {
-            auto _      = resourcesManager->setOnPatch(*patch, Bpred, B, E);
-            auto layout = PHARE::amr::layoutFromPatch<GridLayout>(*patch);
-            auto __     = core::SetLayout(&layout, faraday_);
-            faraday_(B, E, Bpred, dt);
+    PHARE_LOG_SCOPE("SolverPPC::computeStableTimeStep_");
 
+    auto& electromag = model.state.electromag;
+    auto& ions       = model.state.ions;
+    auto& rm         = *model.resourcesManager;
 
-            resourcesManager->setTime(Bpred, *patch, newTime);
-        }
-
-        fromCoarser.fillMagneticGhosts(Bpred, levelNumber, newTime);
-    }
-
+    auto maxAbs = [](auto const& field) {
+        double max = 0;
+        for (std::size_t i = 0; i < field.size(); ++i)
+            max = std::max(max, std::abs(field.data()[i]));
+        return max;
+    };
 
+    auto const maxSpeed = ionUpdater_.takeMaxSpeed();
+    double stableDt     = std::numeric_limits<double>::max();
 
+    for (auto& patch : level)
     {
-        PHARE_LOG_SCOPE("SolverPPC::predictor1_.ampere");
-
-        auto& Bpred = electromagPred_.B;
-        auto& J     = hybridState.J;
-
-
-        for (auto& patch : level)
-        {
-            auto _      = resourcesManager->setOnPatch(*patch, Bpred, J);
-            auto layout = PHARE::amr::layoutFromPatch<GridLayout>(*patch);
-            auto __     = core::SetLayout(&layout, ampere_);
-            ampere_(Bpred, J);
-
-            resourcesManager->setTime(J, *patch, newTime);
-        }
-        fromCoarser.fillCurrentGhosts(J, levelNumber, newTime);
+        auto _           = rm.setOnPatch(*patch, electromag, ions);
+        auto const dl    = PHARE::amr::layoutFromPatch<GridLayout>(*patch).meshSize();
+        auto const minDl = *std::min_element(std::begin(dl), std::end(dl));
+
+        for (std::size_t iDim = 0; iDim < dimension; ++iDim)
+            if (maxSpeed[iDim] > 0)
+                stableDt = std::min(stableDt, dl[iDim] / maxSpeed[iDim]);
+
+        auto const& [Bx, By, Bz] = electromag.B.components();
+        auto const maxBx = maxAbs(Bx), maxBy = maxAbs(By), maxBz = maxAbs(Bz);
+        auto const maxB  = std::sqrt(maxBx * maxBx + maxBy * maxBy + maxBz * maxBz);
+
+        auto const& density = ions.density();
+        double minN         = std::numeric_limits<double>::max();
+        for (std::size_t i = 0; i < density.size(); ++i)
+            if (density.data()[i] > 0)
+                minN = std::min(minN, density.data()[i]);
+
+        auto const waveDt = core::stableWaveTimeStep(minDl, minN, maxB, nbrFieldSubsteps_);
+        stableDt          = std::min(stableDt, waveDt);
     }
 
+    stableDt_[level.getLevelNumber()] = stableDt;
+}
 
 
-    {
-        PHARE_LOG_SCOPE("SolverPPC::predictor1_.ohm");
 
-        auto& electrons = hybridState.electrons;
-        auto& Bpred     = electromagPred_.B;
-        auto& Epred     = electromagPred_.E;
-        auto& J         = hybridState.J;
 
-        for (auto& patch : level)
-        {
-            auto layout = PHARE::amr::layoutFromPatch<GridLayout>(*patch);
-            auto _      = resourcesManager->setOnPatch(*patch, Bpred, Epred, J, electrons);
-            electrons.update(layout);
-            auto& Ve = electrons.velocity();
-            auto& Ne = electrons.density();
-            auto& Pe = electrons.pressure();
-            auto __  = core::SetLayout(&layout, ohm_);
-            ohm_(Ne, Ve, Pe, Bpred, J, Epred);
-            resourcesManager->setTime(Epred, *patch, newTime);
-        }
+template<typename HybridModel, typename AMR_Types>
+void SolverPPC<HybridModel, AMR_Types>::predictor1_(level_t& level, HybridModel& model,
+                                                    Messenger& fromCoarser,
+                                                    double const currentTime, double const newTime)
+{
+    PHARE_LOG_SCOPE("SolverPPC::predictor1_");
 
-        fromCoarser.fillElectricGhosts(Epred, levelNumber, newTime);
-    }
+    auto& electromag = model.state.electromag;
+    advanceFields_(level, model, fromCoarser, electromag.B, electromag.E, electromagPred_,
+                   currentTime, newTime, true);
 }
 
 
@@ -365,77 +414,8 @@ void SolverPPC<HybridModel, AMR_Types>::predictor2_(level_t& level, HybridModel&
 {
     PHARE_LOG_SCOPE("SolverPPC::predictor2_");
 
-    auto& hybridState      = model.state;
-    auto& resourcesManager = model.resourcesManager;
-    auto dt                = newTime - currentTime;
-    auto levelNumber       = level.getLevelNumber();
-
-
-
-    {
-        PHARE_LOG_SCOPE("SolverPPC::predictor2_.faraday");
-
-        auto& Bpred = electromagPred_.B;
-        auto& B     = hybridState.electromag.B;
-        auto& Eavg  = electromagAvg_.E;
-
-        for (auto& patch : level)
-        {
-            auto _      = resourcesManager->setOnPatch(*patch, Bpred, B, Eavg);
-            auto layout = PHARE::amr::layoutFromPatch<GridLayout>(*patch);
-            auto __     = core::SetLayout(&layout, faraday_);
-            faraday_(B, Eavg, Bpred, dt);
-
-            resourcesManager->setTime(Bpred, *patch, newTime);
-        }
-
-        fromCoarser.fillMagneticGhosts(Bpred, levelNumber, newTime);
-    }
-
-
-    {
-        PHARE_LOG_SCOPE("SolverPPC::predictor2_.ampere");
-
-        auto& Bpred = electromagPred_.B;
-        auto& J     = hybridState.J;
-
-
-        for (auto& patch : level)
-        {
-            auto _      = resourcesManager->setOnPatch(*patch, Bpred, J);
-            auto layout = PHARE::amr::layoutFromPatch<GridLayout>(*patch);
-            auto __     = core::SetLayout(&layout, ampere_);
-            ampere_(Bpred, J);
-
-            resourcesManager->setTime(J, *patch, newTime);
-        }
-        fromCoarser.fillCurrentGhosts(J, levelNumber, newTime);
-    }
-
-
-    {
-        PHARE_LOG_SCOPE("SolverPPC::predictor2_.ohm");
-
-        auto& electrons = hybridState.electrons;
-        auto& Bpred     = electromagPred_.B;
-        auto& Epred     = electromagPred_.E;
-        auto& J         = hybridState.J;
-
-        for (auto& patch : level)
-        {
-            auto layout = PHARE::amr::layoutFromPatch<GridLayout>(*patch);
-            auto _      = resourcesManager->setOnPatch(*patch, Bpred, Epred, J, electrons);
-            electrons.update(layout);
-            auto& Ve = electrons.velocity();
-            auto& Ne = electrons.density();
-            auto& Pe = electrons.pressure();
-            auto __  = core::SetLayout(&layout, ohm_);
-            ohm_(Ne, Ve, Pe, Bpred, J, Epred);
-            resourcesManager->setTime(Epred, *patch, newTime);
-        }
-
-        fromCoarser.fillElectricGhosts(Epred, levelNumber, newTime);
-    }
+    advanceFields_(level, model, fromCoarser, model.state.electromag.B, electromagAvg_.E,
+                   electromagPred_, currentTime, newTime, true);
 }
 
 
@@ -448,54 +428,103 @@ void SolverPPC<HybridModel, AMR_Types>::corrector_(level_t& level, HybridModel&
 {
     PHARE_LOG_SCOPE("SolverPPC::corrector_");
 
+    auto& electromag = model.state.electromag;
+    advanceFields_(level, model, fromCoarser, electromag.B, electromagAvg_.E, electromag,
+                   currentTime, newTime, false);
+}
+
+
+
+
+/**
+ * Advances the magnetic field from B to out.B and computes out.E, in nbrFieldSubsteps_ equal
+ * substeps over [currentTime, newTime]. Each substep:
+ *  - solves Faraday, with E for the first substep and out.E for the next ones
+ *  - solves Ampere, except at the last substep if lastAmpere is false. Ohm then uses the current
+ *    density of the previous substep (or stage)
+ *  - solves Ohm with the ion moments, which do not change during the substeps
+ * and fills the ghosts of the fields it computed at the time it reached.
+ *
+ * B and out.B may be the same field.
+ */
+template<typename HybridModel, typename AMR_Types>
+void SolverPPC<HybridModel, AMR_Types>::advanceFields_(level_t& level, HybridModel& model,
+                                                       Messenger& fromCoarser, VecFieldT& B,
+                                                       VecFieldT& E, Electromag& out,
+                                                       double const currentTime,
+                                                       double const newTime, bool const lastAmpere)
+{
     auto& hybridState      = model.state;
     auto& resourcesManager = model.resourcesManager;
-    auto dt                = newTime - currentTime;
     auto levelNumber       = level.getLevelNumber();
+    auto const dt          = (newTime - currentTime) / nbrFieldSubsteps_;
 
+    for (std::size_t iSubstep = 0; iSubstep < nbrFieldSubsteps_; ++iSubstep)
     {
-        PHARE_LOG_SCOPE("SolverPPC::corrector_.faraday");
+        bool const isLast = iSubstep + 1 == nbrFieldSubsteps_;
+        auto const time   = isLast ? newTime : currentTime + (iSubstep + 1) * dt;
 
-        auto& B    = hybridState.electromag.B;
-        auto& Eavg = electromagAvg_.E;
-
-        for (auto& patch : level)
         {
-            auto _      = resourcesManager->setOnPatch(*patch, B, Eavg);
-            auto layout = PHARE::amr::layoutFromPatch<GridLayout>(*patch);
-            auto __     = core::SetLayout(&layout, faraday_);
-            faraday_(B, Eavg, B, dt);
+            PHARE_LOG_SCOPE("SolverPPC::advanceFields_.faraday");
+
+            auto& Bin  = iSubstep == 0 ? B : out.B;
+            auto& Ein  = iSubstep == 0 ? E : out.E;
+            auto& Bout = out.B;
+
+            for (auto& patch : level)
+            {
+                auto _      = resourcesManager->setOnPatch(*patch, Bin, Ein, Bout);
+                auto layout = PHARE::amr::layoutFromPatch<GridLayout>(*patch);
+                auto __     = core::SetLayout(&layout, faraday_);
+                faraday_(Bin, Ein, Bout, dt);
+
+                resourcesManager->setTime(Bout, *patch, time);
+            }
 
-            resourcesManager->setTime(B, *patch, newTime);
+            fromCoarser.fillMagneticGhosts(Bout, levelNumber, time);
         }
 
-        fromCoarser.fillMagneticGhosts(B, levelNumber, newTime);
-    }
 
+        if (!isLast or lastAmpere)
+        {
+            PHARE_LOG_SCOPE("SolverPPC::advanceFields_.ampere");
 
+            auto& J = hybridState.J;
 
-    {
-        PHARE_LOG_SCOPE("SolverPPC::corrector_.ohm");
+            for (auto& patch : level)
+            {
+                auto _      = resourcesManager->setOnPatch(*patch, out.B, J);
+                auto layout = PHARE::amr::layoutFromPatch<GridLayout>(*patch);
+                auto __     = core::SetLayout(&layout, ampere_);
+                ampere_(out.B, J);
+
+                resourcesManager->setTime(J, *patch, time);
+            }
+            fromCoarser.fillCurrentGhosts(J, levelNumber, time);
+        }
 
-        auto& electrons = hybridState.electrons;
-        auto& B         = hybridState.electromag.B;
-        auto& E         = hybridState.electromag.E;
-        auto& J         = hybridState.J;
 
-        for (auto& patch : level)
         {
-            auto layout = PHARE::amr::layoutFromPatch<GridLayout>(*patch);
-            auto _      = resourcesManager->setOnPatch(*patch, B, E, J, electrons);
-            electrons.update(layout);
-            auto& Ve = electrons.velocity();
-            auto& Ne = electrons.density();
-            auto& Pe = electrons.pressure();
-            auto __  = core::SetLayout(&layout, ohm_);
-            ohm_(Ne, Ve, Pe, B, J, E);
-            resourcesManager->setTime(E, *patch, newTime);
+            PHARE_LOG_SCOPE("SolverPPC::advanceFields_.ohm");
+
+            auto& electrons = hybridState.electrons;
+            auto& J         = hybridState.J;
+
+            for (auto& patch : level)
+            {
+                auto layout = PHARE::amr::layoutFromPatch<GridLayout>(*patch);
+                auto _      = resourcesManager->setOnPatch(*patch, out.B, out.E, J, electrons);
+                electrons.update(layout);
+                auto& Ve = electrons.velocity();
+                auto& Ne = electrons.density();
+                auto& Pe = electrons.pressure();
+                auto __  = core::SetLayout(&layout, ohm_);
+                ohm_(Ne, Ve, Pe, out.B, J, out.E);
+                resourcesManager->setTime(out.E, *patch, time);
+            }
+
+            fromCoarser.fillElectricGhosts(out.E, levelNumber, time);
         }
-
-        fromCoarser.fillElectricGhosts(E, levelNumber, newTime);
     }
 }
 
@@ -566,6 +595,9 @@ void SolverPPC<HybridModel, AMR_Types>::moveIons_(level_t& level, Ions& ions,
 
     auto dt = newTime - currentTime;
 
+    auto const levelNumber = level.getLevelNumber();
+    ionUpdater_.enableMerging(mode == core::UpdaterMode::all and levelNumber >= mergerMinLevel_);
+
     for (auto& patch : level)
     {
         auto _ = rm.setOnPatch(*patch, electromag, ions);
@@ -577,6 +609,14 @@ void SolverPPC<HybridModel, AMR_Types>::moveIons_(level_t& level, Ions& ions,
         rm.setTime(ions, *patch, newTime);
     }
 
+    if (auto const merged = ionUpdater_.takeMergerStats(); merged.nbrMergedCells > 0)
+    {
+        mergerStats_[levelNumber] += merged;
+        PHARE_LOG_LINE_STR("level " << levelNumber << " : merged " << merged.nbrParticlesBefore
+                                    << " particles into " << merged.nbrParticlesAfter << " in "
+                                    << merged.nbrMergedCells << " cells");
+    }
+
 
     fromCoarser.fillIonGhostParticles(ions, level, newTime);
     fromCoarser.fillIonMomentGhosts(ions, level, currentTime, newTime);
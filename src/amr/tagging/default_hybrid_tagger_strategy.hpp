@@ -2,10 +2,15 @@
 #define DEFAULT_HYBRID_TAGGER_STRATEGY_H
 
 #include "hybrid_tagger_strategy.hpp"
+#include "tag_hysteresis.hpp"
 #include "core/data/grid/gridlayoutdefs.hpp"
 #include "core/data/vecfield/vecfield_component.hpp"
 #include "core/data/ndarray/ndarray_vector.hpp"
+
+#include <algorithm>
+#include <cmath>
 #include <cstddef>
+#include <vector>
 
 
 namespace PHARE::amr
@@ -17,20 +22,41 @@ class DefaultHybridTaggerStrategy : public HybridTaggerStrategy<HybridModel>
     static auto constexpr dimension = HybridModel::dimension;
 
 public:
-    void tag(HybridModel& model, gridlayout_type const& layout, int* tags) const override;
+    DefaultHybridTaggerStrategy(TaggingParams const& params = {})
+        : useDensity_{params.useDensity}
+        , useCurrent_{params.useCurrent}
+    {
+    }
+
+    void criterion(HybridModel& model, gridlayout_type const& layout,
+                   std::vector<double>& criterion) const override;
+
+private:
+    template<typename Field>
+    static void addRelativeJump_(Field const& F, gridlayout_type const& layout,
+                                 std::vector<double>& criterion);
+
+    bool useDensity_;
+    bool useCurrent_;
 };
 
+
+
+
+/** the criterion is first computed on the magnetic field, and then maxed with the relative jumps
+ * of the optional quantities. Each criterion is computed in its own loop over contiguous cells,
+ * without branches, so that these loops can be vectorized.
+ */
 template<typename HybridModel>
-void DefaultHybridTaggerStrategy<HybridModel>::tag(HybridModel& model,
-                                                   gridlayout_type const& layout, int* tags) const
+void DefaultHybridTaggerStrategy<HybridModel>::criterion(HybridModel& model,
+                                                         gridlayout_type const& layout,
+                                                         std::vector<double>& criterion) const
 {
     auto& Bx = model.state.electromag.B.getComponent(PHARE::core::Component::X);
     auto& By = model.state.electromag.B.getComponent(PHARE::core::Component::Y);
     auto& Bz = model.state.electromag.B.getComponent(PHARE::core::Component::Z);
 
-    auto& N = model.state.ions.density();
-
-    double threshold = 0.1;
+    criterion.assign(core::product(layout.nbrCells()), 0.);
 
     // we loop on cell indexes for all qties regardless of their centering
     auto const& [start_x, _]
@@ -40,29 +66,6 @@ void DefaultHybridTaggerStrategy<HybridModel>::tag(HybridModel& model,
     // and physicalEnd will account for ghost cells
     auto const& end_x = layout.nbrCells()[0] - 1;
 
-    // SAMRAI tags int* buffer is FORTRAN ordering so we set false to the view
-    bool constexpr c_ordering = false;
-    auto tagsv = core::NdArrayView<dimension, int, int*, c_ordering>(tags, layout.nbrCells());
-
-    if constexpr (dimension == 1 and false)
-    {
-        // at interporder 1 we choose not to tag the last patch cell since
-        // the 5 points stencil may go beyond the last ghost node.
-        // for interp order 2 and 3 this is ok
-        for (auto iCell = 0u, ix = start_x; iCell <= end_x; ++ix, ++iCell)
-        {
-            auto crit_by_x = (By(ix + 2) - By(ix)) / (1 + By(ix + 1) - By(ix));
-            auto crit_bz_x = (Bz(ix + 2) - Bz(ix)) / (1 + Bz(ix + 1) - Bz(ix));
-            auto criter    = std::max(crit_by_x, crit_bz_x);
-
-            if (criter > threshold)
-            {
-                tagsv(iCell) = 1;
-            }
-            else
-                tagsv(iCell) = 0;
-        }
-    }
     if constexpr (dimension == 1)
     {
         // at interporder 1 we choose not to tag the last patch cell since
@@ -78,15 +81,7 @@ void DefaultHybridTaggerStrategy<HybridModel>::tag(HybridModel& model,
             auto Bzavgp1   = 0.2 * (Bz(ix - 1) + Bz(ix) + Bz(ix + 1) + Bz(ix + 2) + Bz(ix + 3));
             auto criter_by = std::abs(Byavgp1 - Byavg) / (1 + std::abs(Byavg));
             auto criter_bz = std::abs(Bzavgp1 - Bzavg) / (1 + std::abs(Bzavg));
-            auto criter_b  = std::sqrt(criter_by * criter_by + criter_bz * criter_bz);
-            auto criter    = criter_b;
-
-            if (criter > threshold)
-            {
-                tagsv(iCell) = 1;
-            }
-            else
-                tagsv(iCell) = 0;
+            criterion[iCell] = std::sqrt(criter_by * criter_by + criter_bz * criter_bz);
         }
     }
     if constexpr (dimension == 2)
@@ -98,6 +93,8 @@ void DefaultHybridTaggerStrategy<HybridModel>::tag(HybridModel& model,
 
         for (auto iTag_x = 0u, ix = start_x; iTag_x <= end_x; ++ix, ++iTag_x)
         {
+            auto* row = criterion.data() + iTag_x * (end_y + 1);
+
             for (auto iTag_y = 0u, iy = start_y; iTag_y <= end_y; ++iy, ++iTag_y)
             {
                 auto field_diff = [&](auto const& F) //
@@ -110,20 +107,59 @@ void DefaultHybridTaggerStrategy<HybridModel>::tag(HybridModel& model,
                 auto const& [Bx_x, Bx_y] = field_diff(Bx);
                 auto const& [By_x, By_y] = field_diff(By);
                 auto const& [Bz_x, Bz_y] = field_diff(Bz);
-                auto crit                = std::max({Bx_x, Bx_y, By_x, By_y, Bz_x, Bz_y});
-
-                if (crit > threshold)
-                {
-                    tagsv(iTag_x, iTag_y) = 1;
-                }
-                else
-                {
-                    tagsv(iTag_x, iTag_y) = 0;
-                }
+                row[iTag_y]              = std::max({Bx_x, Bx_y, By_x, By_y, Bz_x, Bz_y});
             }
         }
     }
+
+    if (useDensity_)
+        addRelativeJump_(model.state.ions.density(), layout, criterion);
+
+    if (useCurrent_)
+        for (auto component : {core::Component::X, core::Component::Y, core::Component::Z})
+            addRelativeJump_(model.state.J.getComponent(component), layout, criterion);
+}
+
+
+
+/** maxes the criterion with the relative jump |F(i+1) - F(i)| / (1 + |F(i)|) of the given field,
+ * taken in each direction
+ */
+template<typename HybridModel>
+template<typename Field>
+void DefaultHybridTaggerStrategy<HybridModel>::addRelativeJump_(Field const& F,
+                                                                gridlayout_type const& layout,
+                                                                std::vector<double>& criterion)
+{
+    auto jump = [](double value, double next) {
+        return std::abs(next - value) / (1 + std::abs(value));
+    };
+
+    auto const& [start_x, _]
+        = layout.physicalStartToEnd(PHARE::core::QtyCentering::dual, PHARE::core::Direction::X);
+    auto const nbrCells = layout.nbrCells();
+
+    if constexpr (dimension == 1)
+    {
+        for (auto iCell = 0u, ix = start_x; iCell < nbrCells[0]; ++ix, ++iCell)
+            criterion[iCell] = std::max(criterion[iCell], jump(F(ix), F(ix + 1)));
+    }
+    if constexpr (dimension == 2)
+    {
+        auto const& [start_y, __]
+            = layout.physicalStartToEnd(PHARE::core::QtyCentering::dual, PHARE::core::Direction::Y);
+
+        for (auto iTag_x = 0u, ix = start_x; iTag_x < nbrCells[0]; ++ix, ++iTag_x)
+        {
+            auto* row = criterion.data() + iTag_x * nbrCells[1];
+
+            for (auto iTag_y = 0u, iy = start_y; iTag_y < nbrCells[1]; ++iy, ++iTag_y)
+                row[iTag_y] = std::max({row[iTag_y], jump(F(ix, iy), F(ix + 1, iy)),
+                                        jump(F(ix, iy), F(ix, iy + 1))});
+        }
+    }
 }
+
 } // namespace PHARE::amr
 
 #endif // DEFAULT_HYBRID_TAGGER_STRATEGY_H
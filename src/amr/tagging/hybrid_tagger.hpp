@@ -4,14 +4,21 @@
 
 #include "tagger.hpp"
 #include "hybrid_tagger_strategy.hpp"
+#include "tag_hysteresis.hpp"
 #include "amr/physical_models/hybrid_model.hpp"
 #include "amr/types/amr_types.hpp"
 
+#include <SAMRAI/hier/PatchDataRestartManager.h>
+#include <SAMRAI/hier/VariableDatabase.h>
 #include <SAMRAI/pdat/CellData.h>
+#include <SAMRAI/pdat/CellVariable.h>
+#include <SAMRAI/xfer/RefineAlgorithm.h>
 
 #include <memory>
+#include <string>
 #include <utility>
 #include <stdexcept>
+#include <vector>
 
 
 
@@ -26,18 +33,77 @@ class HybridTagger : public Tagger
     using IPhysicalModel  = PHARE::solver::IPhysicalModel<amr_t>;
     using gridlayout_type = typename HybridModel::gridlayout_type;
 
+    static constexpr auto dimension = HybridModel::dimension;
+
 
 public:
-    HybridTagger(std::unique_ptr<HybridTaggerStrategy<HybridModel>> strat)
+    HybridTagger(std::unique_ptr<HybridTaggerStrategy<HybridModel>> strat,
+                 TaggingParams const& params = {})
         : Tagger{"HybridTagger"}
         , strat_{std::move(strat)}
+        , params_{params}
+    {
+        params_.validate();
+
+        auto variableDatabase = SAMRAI::hier::VariableDatabase::getDatabase();
+        agesID_               = variableDatabase->registerVariableAndContext(
+            ages_, variableDatabase->getContext(name_),
+            SAMRAI::hier::IntVector::getZero(SAMRAI::tbox::Dimension{dimension}));
+        SAMRAI::hier::PatchDataRestartManager::getManager()->registerPatchDataForRestart(agesID_);
+    }
+
+    ~HybridTagger()
+    {
+        SAMRAI::hier::PatchDataRestartManager::getManager()->unregisterPatchDataForRestart(agesID_);
+        SAMRAI::hier::VariableDatabase::getDatabase()->removeVariable(ages_->getName());
+    }
+
+
+    //! new patches start with untagged cells
+    void allocate(patch_t& patch, double const allocateTime) override
+    {
+        if (!patch.checkAllocated(agesID_))
+            patch.allocatePatchData(agesID_, allocateTime);
+        agesOn_(patch).fillAll(0);
+    }
+
+
+    /** the ages of the cells the old level had are copied to the regridded level, wherever its
+     * patches now are
+     */
+    void regrid(std::shared_ptr<SAMRAI::hier::PatchHierarchy> const& hierarchy,
+                int const levelNumber, std::shared_ptr<SAMRAI::hier::PatchLevel> const& oldLevel,
+                double const initDataTime) override
     {
+        SAMRAI::xfer::RefineAlgorithm algo;
+        algo.registerRefine(agesID_, agesID_, agesID_,
+                            std::shared_ptr<SAMRAI::hier::RefineOperator>{});
+        algo.createSchedule(hierarchy->getPatchLevel(levelNumber), oldLevel)
+            ->fillData(initDataTime);
     }
 
+
     void tag(IPhysicalModel& model, patch_t& patch, int tag_index) override;
 
 private:
+    SAMRAI::pdat::CellData<int>& agesOn_(patch_t& patch) const
+    {
+        return dynamic_cast<SAMRAI::pdat::CellData<int>&>(*patch.getPatchData(agesID_));
+    }
+
+
     std::unique_ptr<HybridTaggerStrategy<HybridModel>> strat_;
+    TaggingParams params_;
+
+    /** tag ages are the number of consecutive tagging steps each cell has been tagged for. As
+     * patch data, they are moved along with the patches at regrid, and saved in restart files
+     */
+    std::shared_ptr<SAMRAI::pdat::CellVariable<int>> ages_
+        = std::make_shared<SAMRAI::pdat::CellVariable<int>>(SAMRAI::tbox::Dimension{dimension},
+                                                            "HybridTagger_tagAges");
+    int agesID_ = -1;
+
+    std::vector<double> criterion_; // reused from one patch to the next
 };
 
 
@@ -61,7 +127,38 @@ void HybridTagger<HybridModel>::tag(PHARE::solver::IPhysicalModel<amr_t>& model,
         auto modelIsOnPatch = hybridModel.setOnPatch(patch);
         auto pd   = dynamic_cast<SAMRAI::pdat::CellData<int>*>(patch.getPatchData(tag_index).get());
         auto tags = pd->getPointer();
-        strat_->tag(hybridModel, layout, tags);
+        strat_->criterion(hybridModel, layout, criterion_);
+
+        // criterion_ is c-ordered while the SAMRAI tags and ages buffers are FORTRAN ordered
+        auto tagsF = core::NdArrayView<HybridModel::dimension, int, int*, false>(tags,
+                                                                                 layout.nbrCells());
+        auto crit  = core::NdArrayView<HybridModel::dimension, double>(criterion_.data(),
+                                                                      layout.nbrCells());
+        auto agesF = core::NdArrayView<HybridModel::dimension, int, int*, false>(
+            agesOn_(patch).getPointer(), layout.nbrCells());
+        auto tagCell = [&](auto... iCell) {
+            tagsF(iCell...) = updateTagAge(crit(iCell...), agesF(iCell...), params_) ? 1 : 0;
+        };
+
+        auto const nbrCells = layout.nbrCells();
+        if constexpr (HybridModel::dimension == 1)
+        {
+            for (auto iTag_x = 0u; iTag_x < nbrCells[0]; ++iTag_x)
+                tagCell(iTag_x);
+        }
+        if constexpr (HybridModel::dimension == 2)
+        {
+            for (auto iTag_x = 0u; iTag_x < nbrCells[0]; ++iTag_x)
+                for (auto iTag_y = 0u; iTag_y < nbrCells[1]; ++iTag_y)
+                    tagCell(iTag_x, iTag_y);
+        }
+        if constexpr (HybridModel::dimension == 3)
+        {
+            for (auto iTag_x = 0u; iTag_x < nbrCells[0]; ++iTag_x)
+                for (auto iTag_y = 0u; iTag_y < nbrCells[1]; ++iTag_y)
+                    for (auto iTag_z = 0u; iTag_z < nbrCells[2]; ++iTag_z)
+                        tagCell(iTag_x, iTag_y, iTag_z);
+        }
 
 
         // These tags will be saved even if they are not used in diags during this advance
@@ -83,18 +180,15 @@ void HybridTagger<HybridModel>::tag(PHARE::solver::IPhysicalModel<amr_t>& model,
                 = std::make_shared<typename Map_value_type::element_type>(layout.nbrCells());
         }
 
-        auto nbrCells = layout.nbrCells();
         auto tagsv = core::NdArrayView<HybridModel::dimension, int>(hybridModel.tags[key]->data(),
                                                                     layout.nbrCells());
-        auto tagsvF
-            = core::NdArrayView<HybridModel::dimension, int, int*, false>(tags, layout.nbrCells());
         if constexpr (HybridModel::dimension == 2)
         {
             for (auto iTag_x = 0u; iTag_x < nbrCells[0]; ++iTag_x)
             {
                 for (auto iTag_y = 0u; iTag_y < nbrCells[1]; ++iTag_y)
                 {
-                    tagsv(iTag_x, iTag_y) = tagsvF(iTag_x, iTag_y);
+                    tagsv(iTag_x, iTag_y) = tagsF(iTag_x, iTag_y);
                 }
             }
         }
@@ -1,6 +1,8 @@
 #ifndef HYBRID_TAGGER_STRATEGY_HPP
 #define HYBRID_TAGGER_STRATEGY_HPP
 
+#include <vector>
+
 namespace PHARE::amr
 {
 
@@ -10,8 +12,14 @@ class HybridTaggerStrategy
     using gridlayout_type = typename HybridModel::gridlayout_type;
 
 public:
-    virtual void tag(HybridModel& model, gridlayout_type const& layout, int* tags) const = 0;
-    virtual ~HybridTaggerStrategy()                                                      = 0;
+    /** @brief computes the refinement criterion of each cell of the patch, in the c-ordered
+     * criterion vector, sized to the number of cells of the layout. Cells are then tagged by the
+     * HybridTagger depending on this criterion and on the tags of the previous step.
+     */
+    virtual void criterion(HybridModel& model, gridlayout_type const& layout,
+                           std::vector<double>& criterion) const
+        = 0;
+    virtual ~HybridTaggerStrategy() = 0;
 };
 
 template<typename HybridModel>
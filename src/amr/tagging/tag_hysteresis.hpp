@@ -0,0 +1,55 @@
+#ifndef PHARE_TAG_HYSTERESIS_HPP
+#define PHARE_TAG_HYSTERESIS_HPP
+
+#include <stdexcept>
+
+namespace PHARE::amr
+{
+/** \brief TaggingParams configures the HybridTagger
+ *
+ * A cell that is not tagged gets tagged when its criterion exceeds activateThreshold. Once
+ * tagged, it stays tagged as long as its criterion exceeds deactivateThreshold, and at least for
+ * minLifetime tagging steps. Features close to a single threshold thus do not make patches
+ * appear and disappear from one regrid to the next.
+ *
+ * useDensity and useCurrent add the ion density and the current density to the magnetic field
+ * in the refinement criterion.
+ */
+struct TaggingParams
+{
+    double activateThreshold   = 0.1;
+    double deactivateThreshold = 0.1;
+    int minLifetime            = 0;
+    bool useDensity            = false;
+    bool useCurrent            = false;
+
+    void validate() const
+    {
+        if (deactivateThreshold > activateThreshold)
+            throw std::runtime_error("TaggingParams: deactivate threshold must not be greater "
+                                     "than the activate threshold");
+        if (minLifetime < 0)
+            throw std::runtime_error("TaggingParams: min lifetime must not be negative");
+    }
+};
+
+
+
+/** @brief tells if a cell with the given criterion is tagged, given the number of consecutive
+ * tagging steps it has been tagged for so far (0 if it was not tagged at the previous step).
+ * This number is updated accordingly.
+ */
+inline bool updateTagAge(double const criterion, int& age, TaggingParams const& params)
+{
+    bool const tagged = age == 0
+                            ? criterion > params.activateThreshold
+                            : (criterion > params.deactivateThreshold or age < params.minLifetime);
+    age = tagged ? age + 1 : 0;
+    return tagged;
+}
+
+
+
+} // namespace PHARE::amr
+
+#endif
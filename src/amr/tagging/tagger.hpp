@@ -6,6 +6,7 @@
 #include "amr/types/amr_types.hpp"
 
 #include <memory>
+#include <string>
 
 namespace PHARE::amr
 {
@@ -22,6 +23,18 @@ public:
     {
     }
     std::string name() { return name_; }
+
+    //! allocates the data the tagger keeps on the given patch, if any
+    virtual void allocate(patch_t& /*patch*/, double const /*allocateTime*/) {}
+
+    //! moves the data the tagger keeps on the patches of the old level to the regridded level
+    virtual void regrid(std::shared_ptr<SAMRAI::hier::PatchHierarchy> const& /*hierarchy*/,
+                        int const /*levelNumber*/,
+                        std::shared_ptr<SAMRAI::hier::PatchLevel> const& /*oldLevel*/,
+                        double const /*initDataTime*/)
+    {
+    }
+
     virtual void tag(PHARE::solver::IPhysicalModel<amr_t>& model, patch_t& patch, int tag_index)
         = 0;
     virtual ~Tagger(){};
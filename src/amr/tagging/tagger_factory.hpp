@@ -9,6 +9,8 @@
 #include "hybrid_tagger.hpp"
 #include "hybrid_tagger_strategy.hpp"
 #include "default_hybrid_tagger_strategy.hpp"
+#include "tag_hysteresis.hpp"
+#include "initializer/data_provider.hpp"
 
 namespace PHARE::amr
 {
@@ -17,11 +19,45 @@ class TaggerFactory
 {
 public:
     TaggerFactory() = delete;
-    static std::unique_ptr<Tagger> make(std::string modelName, std::string methodName);
+    static std::unique_ptr<Tagger> make(std::string modelName, std::string methodName,
+                                        TaggingParams const& params = {});
 };
 
+
+
+/** @brief reads the tagging parameters from the "simulation/AMR/refinement/tagging" dict,
+ * missing entries keep their default value
+ */
+inline TaggingParams taggingParams(initializer::PHAREDict const& dict)
+{
+    TaggingParams params;
+
+    if (dict.contains("activate_threshold"))
+        params.activateThreshold = dict["activate_threshold"].template to<double>();
+
+    // a single threshold without hysteresis if only the activate one is given
+    params.deactivateThreshold = params.activateThreshold;
+    if (dict.contains("deactivate_threshold"))
+        params.deactivateThreshold = dict["deactivate_threshold"].template to<double>();
+
+    if (dict.contains("min_lifetime"))
+        params.minLifetime = dict["min_lifetime"].template to<int>();
+
+    if (dict.contains("use_density"))
+        params.useDensity = dict["use_density"].template to<int>() != 0;
+
+    if (dict.contains("use_current"))
+        params.useCurrent = dict["use_current"].template to<int>() != 0;
+
+    params.validate();
+    return params;
+}
+
+
+
 template<typename PHARE_T>
-std::unique_ptr<Tagger> TaggerFactory<PHARE_T>::make(std::string modelName, std::string methodName)
+std::unique_ptr<Tagger> TaggerFactory<PHARE_T>::make(std::string modelName, std::string methodName,
+                                                     TaggingParams const& params)
 {
     if (modelName == "HybridModel")
     {
@@ -31,7 +67,7 @@ std::unique_ptr<Tagger> TaggerFactory<PHARE_T>::make(std::string modelName, std:
         if (methodName == "default")
         {
             using HTS = DefaultHybridTaggerStrategy<HybridModel>;
-            return std::make_unique<HT>(std::make_unique<HTS>());
+            return std::make_unique<HT>(std::make_unique<HTS>(params), params);
         }
     }
     return nullptr;
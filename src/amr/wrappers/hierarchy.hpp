@@ -43,7 +43,11 @@ public:
         {
             auto& dict = sim_dict["simulation"]["restarts"];
 
-            if (dict.contains("loadPath"))
+            // "phareh5" restarts are loaded by the restarts manager, see restarts::h5::Loader
+            bool const samraiFormat = !dict.contains("format")
+                                      or dict["format"].template to<std::string>() == "samraih5";
+
+            if (dict.contains("loadPath") and samraiFormat)
             {
                 auto restart_manager = SAMRAI::tbox::RestartManager::getManager();
                 auto pdrm            = SAMRAI::hier::PatchDataRestartManager::getManager();
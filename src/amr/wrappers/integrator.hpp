@@ -134,12 +134,24 @@ getUserRefinementBoxesDatabase(PHARE::initializer::PHAREDict const& amr)
         std::shared_ptr<SAMRAI::tbox::MemoryDatabase> refinementBoxesDatabase
             = std::make_shared<SAMRAI::tbox::MemoryDatabase>("StandardTagAndInitialize");
 
-        // user refinement boxes are always defined at t=0
-        // auto at0db = refinementBoxesDatabase->putDatabase("at_0");
-        // at0db->putInteger("cycle", 0);
-        // auto tag0db = at0db->putDatabase("tag_0");
+        // restarted simulations refined by tagging rebuild the levels of the restart from their
+        // boxes at the first cycle, tagging takes over from the next one
+        std::shared_ptr<SAMRAI::tbox::Database> boxesDB = refinementBoxesDatabase;
+        if (refinement.contains("tagging")
+            and refinement["tagging"]["method"].template to<std::string>() == "auto")
+        {
+            auto at0db = refinementBoxesDatabase->putDatabase("at_0");
+            at0db->putInteger("cycle", 0);
+            boxesDB = at0db->putDatabase("tag_0");
+
+            auto at1db = refinementBoxesDatabase->putDatabase("at_1");
+            at1db->putInteger("cycle", 1);
+            at1db->putDatabase("tag_0")->putString("tagging_method", "GRADIENT_DETECTOR");
+            std::cout << "tagging method is set to GRADIENT_DETECTOR after the first cycle\n";
+        }
+
         std::cout << "tagging method is set to REFINE_BOXES\n";
-        refinementBoxesDatabase->putString("tagging_method", "REFINE_BOXES");
+        boxesDB->putString("tagging_method", "REFINE_BOXES");
 
 
         for (int levelNumber = 0; levelNumber < maxLevelNumber; ++levelNumber)
@@ -152,8 +164,7 @@ getUserRefinementBoxesDatabase(PHARE::initializer::PHAREDict const& amr)
                 auto& levelDict = refDict[levelString];
                 auto samraiDim  = SAMRAI::tbox::Dimension{dimension};
                 auto nbrBoxes   = levelDict["nbr_boxes"].template to<int>();
-                auto levelDB
-                    = refinementBoxesDatabase->putDatabase("level_" + std::to_string(levelNumber));
+                auto levelDB    = boxesDB->putDatabase("level_" + std::to_string(levelNumber));
 
                 std::vector<SAMRAI::tbox::DatabaseBox> dbBoxes;
                 for (int iBox = 0; iBox < nbrBoxes; ++iBox)
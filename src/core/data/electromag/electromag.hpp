@@ -3,6 +3,7 @@
 #ifndef PHARE_CORE_DATA_ELECTROMAG_ELECTROMAG_HPP
 #define PHARE_CORE_DATA_ELECTROMAG_ELECTROMAG_HPP
 
+#include <optional>
 #include <string>
 #include <tuple>
 
@@ -24,7 +25,6 @@ namespace core
         explicit Electromag(std::string name)
             : E{name + "_E", HybridQuantity::Vector::E}
             , B{name + "_B", HybridQuantity::Vector::B}
-            , Binit_{}
         {
         }
 
@@ -35,8 +35,10 @@ namespace core
             , B{dict["name"].template to<std::string>() + "_"
                     + dict["magnetic"]["name"].template to<std::string>(),
                 HybridQuantity::Vector::B}
-            , Binit_{dict["magnetic"]["initializer"]}
         {
+            // restarts loading B from a file have no initializer, initialize leaves B as it is
+            if (dict["magnetic"].contains("initializer"))
+                Binit_.emplace(dict["magnetic"]["initializer"]);
         }
 
         using vecfield_type = VecFieldT;
@@ -45,7 +47,8 @@ namespace core
         template<typename GridLayout>
         void initialize(GridLayout const& layout)
         {
-            Binit_.initialize(B, layout);
+            if (Binit_)
+                Binit_->initialize(B, layout);
         }
 
 
@@ -76,7 +79,7 @@ namespace core
         VecFieldT B;
 
     private:
-        VecFieldInitializer<dimension> Binit_;
+        std::optional<VecFieldInitializer<dimension>> Binit_;
     };
 } // namespace core
 } // namespace PHARE
@@ -151,6 +151,13 @@ public:
 
     auto nbr_particles_in(box_t const& box) const { return cellMap_.size(box); }
 
+    //! indexes of the particles mapped in the given cell
+    template<typename Cell>
+    auto const& indexes_in(Cell const& cell) const
+    {
+        return cellMap_(cell);
+    }
+
     void export_particles(box_t const& box, ParticleArray<dim>& dest) const
     {
         PHARE_LOG_SCOPE("ParticleArray::export_particles");
@@ -230,6 +237,9 @@ public:
     auto& vector() { return particles_; }
     auto& vector() const { return particles_; }
 
+    //! box of the cells mapped by the CellMap
+    auto const& box() const { return box_; }
+
 private:
     Vector particles_;
     box_t box_;
@@ -2,6 +2,7 @@
 #define PHARE_CORE_DATA_PARTICLE_PACKER_HPP
 
 
+#include <algorithm>
 #include <cstddef>
 #include <vector>
 
@@ -19,6 +20,13 @@ public:
     {
     }
 
+    //! packs only the particles of the given indexes, in that order
+    ParticlePacker(ParticleArray<dim> const& particles, std::vector<std::size_t> const& selection)
+        : particles_{particles}
+        , selection_{&selection}
+    {
+    }
+
     static auto get(Particle<dim> const& particle)
     {
         return std::forward_as_tuple(particle.weight, particle.charge, particle.iCell,
@@ -37,17 +45,36 @@ public:
 
     static auto& keys() { return keys_; }
 
-    auto get(std::size_t i) const { return get(particles_[i]); }
-    bool hasNext() const { return it_ < particles_.size(); }
+    auto get(std::size_t i) const { return get(particles_[selection_ ? (*selection_)[i] : i]); }
+    bool hasNext() const { return it_ < size(); }
     auto next() { return get(it_++); }
 
-    void pack(ContiguousParticles<dim>& copy)
+    //! number of particles to pack
+    std::size_t size() const { return selection_ ? selection_->size() : particles_.size(); }
+
+    //! copies the particles into copy, from its particle of index idx
+    void pack(ContiguousParticles<dim>& copy, std::size_t idx = 0)
+    {
+        pack_(copy, idx, size());
+    }
+
+    /** @brief copies at most the next maxCount particles at the beginning of copy, which needs
+     * room for them, and returns how many were copied. Allows packing particles chunk by chunk.
+     */
+    std::size_t pack_next(ContiguousParticles<dim>& copy, std::size_t maxCount)
+    {
+        auto const count = std::min(maxCount, size() - it_);
+        pack_(copy, 0, count);
+        return count;
+    }
+
+private:
+    void pack_(ContiguousParticles<dim>& copy, std::size_t idx, std::size_t count)
     {
         auto copyTo = [](auto& a, auto& idx, auto size, auto& v) {
             std::copy(a.begin(), a.begin() + size, v.begin() + (idx * size));
         };
-        std::size_t idx = 0;
-        while (this->hasNext())
+        for (std::size_t i = 0; i < count and this->hasNext(); ++i)
         {
             auto next        = this->next();
             copy.weight[idx] = std::get<0>(next);
@@ -59,9 +86,9 @@ public:
         }
     }
 
-private:
     ParticleArray<dim> const& particles_;
-    std::size_t it_ = 0;
+    std::vector<std::size_t> const* selection_ = nullptr;
+    std::size_t it_                            = 0;
     static inline std::array<std::string, 5> keys_{"weight", "charge", "iCell", "delta", "v"};
 };
 
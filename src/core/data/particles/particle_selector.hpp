@@ -0,0 +1,135 @@
+#ifndef PHARE_CORE_DATA_PARTICLES_PARTICLE_SELECTOR_HPP
+#define PHARE_CORE_DATA_PARTICLES_PARTICLE_SELECTOR_HPP
+
+#include "core/data/particles/particle_array.hpp"
+#include "core/utilities/box/box.hpp"
+#include "core/utilities/point/point.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+
+namespace PHARE::core
+{
+/** \brief ParticleSelector selects the particles of an array to be written, by index, so that the
+ * array does not need to be copied
+ *
+ * A particle is a candidate if it is in one of the boxes, when there are any, and if each of its
+ * velocity components is within [vMin, vMax]. Boxes are given in the AMR index space of level 0
+ * and are refined for finer levels. Of the candidates:
+ *  - every stride-th one is kept, in the order of the array
+ *  - a fraction of them is kept, based on a hash of the particle state. A particle in a given
+ *    state is thus selected or not whatever the array, patch or rank it is found on.
+ */
+template<std::size_t dim>
+class ParticleSelector
+{
+    static constexpr int refinementRatio = 2;
+    static constexpr double infinity     = std::numeric_limits<double>::max();
+
+public:
+    std::size_t stride = 1;
+    double fraction    = 1.;
+    std::vector<Box<int, dim>> boxes;
+    std::array<double, 3> vMin{-infinity, -infinity, -infinity};
+    std::array<double, 3> vMax{infinity, infinity, infinity};
+
+
+    bool selectsAll() const
+    {
+        auto const unbounded = [](auto const& v, double limit) {
+            return std::all_of(std::begin(v), std::end(v), [=](auto vi) { return vi == limit; });
+        };
+        return stride == 1 and fraction >= 1. and boxes.empty() and unbounded(vMin, -infinity)
+               and unbounded(vMax, infinity);
+    }
+
+
+    //! returns the indexes of the selected particles of an array of the given level
+    std::vector<std::size_t> select(ParticleArray<dim> const& particles,
+                                    std::size_t const level) const
+    {
+        auto const levelBoxes = boxesAt_(level);
+
+        std::vector<std::size_t> selection;
+        std::size_t nbrCandidates = 0;
+        for (std::size_t index = 0; index < particles.size(); ++index)
+        {
+            auto const& particle = particles[index];
+
+            if (!levelBoxes.empty() and !isIn(Point<int, dim>{particle.iCell}, levelBoxes))
+                continue;
+            if (!inVelocityRange_(particle.v))
+                continue;
+            if (nbrCandidates++ % stride != 0)
+                continue;
+            if (fraction < 1. and !sampled_(particle))
+                continue;
+
+            selection.push_back(index);
+        }
+        return selection;
+    }
+
+
+private:
+    std::vector<Box<int, dim>> boxesAt_(std::size_t const level) const
+    {
+        int ratio = 1;
+        for (std::size_t iLevel = 0; iLevel < level; ++iLevel)
+            ratio *= refinementRatio;
+
+        auto levelBoxes = boxes;
+        for (auto& box : levelBoxes)
+            for (std::size_t iDim = 0; iDim < dim; ++iDim)
+            {
+                box.lower[iDim] *= ratio;
+                box.upper[iDim] = (box.upper[iDim] + 1) * ratio - 1;
+            }
+        return levelBoxes;
+    }
+
+
+    bool inVelocityRange_(std::array<double, 3> const& v) const
+    {
+        for (std::size_t iComp = 0; iComp < 3; ++iComp)
+            if (v[iComp] < vMin[iComp] or v[iComp] > vMax[iComp])
+                return false;
+        return true;
+    }
+
+
+    template<typename Particle>
+    bool sampled_(Particle const& particle) const
+    {
+        std::uint64_t hash = 0x9e3779b97f4a7c15;
+        auto mix           = [&hash](auto const value) {
+            std::uint64_t bits = 0;
+            std::memcpy(&bits, &value, sizeof(value));
+            hash ^= bits + 0x9e3779b97f4a7c15 + (hash << 6) + (hash >> 2);
+        };
+
+        mix(particle.weight);
+        for (auto const& iCell : particle.iCell)
+            mix(iCell);
+        for (auto const& delta : particle.delta)
+            mix(delta);
+        for (auto const& v : particle.v)
+            mix(v);
+
+        // splitmix64 finalizer, the 53 high bits then give a uniform number in [0, 1)
+        hash = (hash ^ (hash >> 30)) * 0xbf58476d1ce4e5b9;
+        hash = (hash ^ (hash >> 27)) * 0x94d049bb133111eb;
+        hash = hash ^ (hash >> 31);
+        return static_cast<double>(hash >> 11) * 0x1.0p-53 < fraction;
+    }
+};
+
+} // namespace PHARE::core
+
+#endif
@@ -0,0 +1,152 @@
+#ifndef PHARE_CORE_DATA_PARTICLES_VELOCITY_HISTOGRAM_HPP
+#define PHARE_CORE_DATA_PARTICLES_VELOCITY_HISTOGRAM_HPP
+
+#include "core/data/particles/particle_array.hpp"
+#include "core/utilities/box/box.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+
+namespace PHARE::core
+{
+/** \brief VelocityHistogram bins the weights of particles in velocity space, one histogram per
+ * space box
+ *
+ * Boxes are given in the AMR index space of level 0 and are refined for finer levels. Each
+ * histogram has nbrBins[i] regular bins over [vMin[i], vMax[i]) for the velocity component i, a
+ * component with a single bin is thus integrated over. Particles out of the velocity range are not
+ * counted. Particles of a box are found with the CellMap of the array, only the cells of the box
+ * are visited.
+ *
+ * Counts are c-ordered as (box, vx, vy, vz).
+ */
+template<std::size_t dim>
+class VelocityHistogram
+{
+    static constexpr int refinementRatio = 2;
+
+public:
+    VelocityHistogram(std::vector<Box<int, dim>> boxes, std::array<std::size_t, 3> nbrBins,
+                      std::array<double, 3> vMin, std::array<double, 3> vMax)
+        : boxes_{std::move(boxes)}
+        , nbrBins_{nbrBins}
+        , vMin_{vMin}
+        , vMax_{vMax}
+    {
+        if (boxes_.empty())
+            throw std::runtime_error("VelocityHistogram: no box");
+
+        for (std::size_t iComp = 0; iComp < 3; ++iComp)
+            if (nbrBins_[iComp] == 0 or !(vMin_[iComp] < vMax_[iComp]))
+                throw std::runtime_error("VelocityHistogram: invalid bins for component "
+                                         + std::to_string(iComp));
+
+        counts_.assign(boxes_.size() * binsPerBox_(), 0.);
+    }
+
+
+    //! adds the particles of the array, of the given level, that are in the cells of patchBox
+    void accumulate(ParticleArray<dim> const& particles, Box<int, dim> const& patchBox,
+                    std::size_t const level)
+    {
+        auto const ratio = levelRatio_(level);
+
+        for (std::size_t iBox = 0; iBox < boxes_.size(); ++iBox)
+        {
+            auto const overlap = refine_(boxes_[iBox], ratio) * patchBox;
+            if (!overlap)
+                continue;
+
+            auto* counts = counts_.data() + iBox * binsPerBox_();
+            for (auto const& cell : *overlap)
+                for (auto const& index : particles.indexes_in(cell))
+                {
+                    auto const& particle = particles[index];
+                    if (auto const bin = bin_(particle.v); bin < binsPerBox_())
+                        counts[bin] += particle.weight;
+                }
+        }
+    }
+
+
+    void reset() { std::fill(std::begin(counts_), std::end(counts_), 0.); }
+
+    auto& counts() { return counts_; }
+    auto const& counts() const { return counts_; }
+
+    std::vector<std::size_t> shape() const
+    {
+        return {boxes_.size(), nbrBins_[0], nbrBins_[1], nbrBins_[2]};
+    }
+
+    //! edges of the bins of the given velocity component
+    std::vector<double> edges(std::size_t const iComp) const
+    {
+        std::vector<double> edges(nbrBins_[iComp] + 1);
+        for (std::size_t iBin = 0; iBin < edges.size(); ++iBin)
+            edges[iBin] = vMin_[iComp] + iBin * binWidth_(iComp);
+        return edges;
+    }
+
+
+private:
+    std::size_t binsPerBox_() const { return nbrBins_[0] * nbrBins_[1] * nbrBins_[2]; }
+
+    double binWidth_(std::size_t const iComp) const
+    {
+        return (vMax_[iComp] - vMin_[iComp]) / nbrBins_[iComp];
+    }
+
+
+    //! returns binsPerBox_() if the velocity is out of range
+    std::size_t bin_(std::array<double, 3> const& v) const
+    {
+        std::size_t bin = 0;
+        for (std::size_t iComp = 0; iComp < 3; ++iComp)
+        {
+            if (v[iComp] < vMin_[iComp] or !(v[iComp] < vMax_[iComp]))
+                return binsPerBox_();
+            auto const iBin = std::min(
+                static_cast<std::size_t>((v[iComp] - vMin_[iComp]) / binWidth_(iComp)),
+                nbrBins_[iComp] - 1);
+            bin = bin * nbrBins_[iComp] + iBin;
+        }
+        return bin;
+    }
+
+
+    static int levelRatio_(std::size_t const level)
+    {
+        int ratio = 1;
+        for (std::size_t iLevel = 0; iLevel < level; ++iLevel)
+            ratio *= refinementRatio;
+        return ratio;
+    }
+
+    static Box<int, dim> refine_(Box<int, dim> box, int const ratio)
+    {
+        for (std::size_t iDim = 0; iDim < dim; ++iDim)
+        {
+            box.lower[iDim] *= ratio;
+            box.upper[iDim] = (box.upper[iDim] + 1) * ratio - 1;
+        }
+        return box;
+    }
+
+
+    std::vector<Box<int, dim>> boxes_;
+    std::array<std::size_t, 3> nbrBins_;
+    std::array<double, 3> vMin_;
+    std::array<double, 3> vMax_;
+    std::vector<double> counts_;
+};
+
+} // namespace PHARE::core
+
+#endif
@@ -3,8 +3,13 @@
 
 
 
+#include <algorithm>
 #include <array>
 #include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <tuple>
+#include <vector>
 
 #include "core/data/grid/gridlayout.hpp"
 #include "core/data/vecfield/vecfield_component.hpp"
@@ -349,11 +354,12 @@ public: /** Performs the 2D interpolation
             {
                 auto x = xStartIndex + ix;
                 auto y = yStartIndex + iy;
+                auto w = xWeights[ix] * yWeights[iy];
 
-                density(x, y) += partRho * xWeights[ix] * yWeights[iy];
-                xFlux(x, y) += xPartFlux * xWeights[ix] * yWeights[iy];
-                yFlux(x, y) += yPartFlux * xWeights[ix] * yWeights[iy];
-                zFlux(x, y) += zPartFlux * xWeights[ix] * yWeights[iy];
+                density(x, y) += partRho * w;
+                xFlux(x, y) += xPartFlux * w;
+                yFlux(x, y) += yPartFlux * w;
+                zFlux(x, y) += zPartFlux * w;
             }
         }
     }
@@ -395,16 +401,19 @@ public: /** Performs the 3D interpolation
         {
             for (auto iy = 0u; iy < order_size; ++iy)
             {
+                auto const xyWeight = xWeights[ix] * yWeights[iy];
+
                 for (auto iz = 0u; iz < order_size; ++iz)
                 {
                     auto x = xStartIndex + ix;
                     auto y = yStartIndex + iy;
                     auto z = zStartIndex + iz;
+                    auto w = xyWeight * zWeights[iz];
 
-                    density(x, y, z) += partRho * xWeights[ix] * yWeights[iy] * zWeights[iz];
-                    xFlux(x, y, z) += xPartFlux * xWeights[ix] * yWeights[iy] * zWeights[iz];
-                    yFlux(x, y, z) += yPartFlux * xWeights[ix] * yWeights[iy] * zWeights[iz];
-                    zFlux(x, y, z) += zPartFlux * xWeights[ix] * yWeights[iy] * zWeights[iz];
+                    density(x, y, z) += partRho * w;
+                    xFlux(x, y, z) += xPartFlux * w;
+                    yFlux(x, y, z) += yPartFlux * w;
+                    zFlux(x, y, z) += zPartFlux * w;
                 }
             }
         }
@@ -414,6 +423,123 @@ public: /** Performs the 3D interpolation
 
 
 
+/** \brief MomentCombiner is a write-combining buffer for the deposit of several particle ranges
+ * onto the same density and flux
+ *
+ * The density and the three flux components of a node are stored next to each other, so that a
+ * particle contribution touches consecutive values instead of four fields. The nodes touched by
+ * the particles are tracked with their bounding box, which is added to the moment fields in a
+ * single pass, and then reset to zero so that the buffer can be reused without clearing it.
+ */
+template<std::size_t dim>
+class MomentCombiner
+{
+public:
+    using Moments = std::array<double, 4>; // density, x, y and z flux
+
+    template<typename Field>
+    void reset(Field const& density)
+    {
+        std::size_t size = 1;
+        for (std::size_t iDim = 0; iDim < dim; ++iDim)
+        {
+            shape_[iDim] = density.shape()[iDim];
+            size *= shape_[iDim];
+        }
+        if (values_.size() < size)
+            values_.resize(size, Moments{0., 0., 0., 0.});
+
+        lower_.fill(std::numeric_limits<std::uint32_t>::max());
+        upper_.fill(0);
+    }
+
+
+    template<typename Indexes, typename Weights>
+    void add(Indexes const& startIndex, Weights const& weights, Moments const& moments)
+    {
+        auto const order_size = weights[0].size();
+        for (std::size_t iDim = 0; iDim < dim; ++iDim)
+        {
+            lower_[iDim] = std::min(lower_[iDim], startIndex[iDim]);
+            upper_[iDim] = std::max(upper_[iDim],
+                                    startIndex[iDim] + static_cast<std::uint32_t>(order_size) - 1);
+        }
+
+        auto addNode = [&](std::size_t node, double w) {
+            auto& values = values_[node];
+            for (std::size_t i = 0; i < moments.size(); ++i)
+                values[i] += moments[i] * w;
+        };
+
+        if constexpr (dim == 1)
+            for (auto ix = 0u; ix < order_size; ++ix)
+                addNode(startIndex[0] + ix, weights[0][ix]);
+
+        if constexpr (dim == 2)
+            for (auto ix = 0u; ix < order_size; ++ix)
+            {
+                auto const row = (startIndex[0] + ix) * shape_[1] + startIndex[1];
+                for (auto iy = 0u; iy < order_size; ++iy)
+                    addNode(row + iy, weights[0][ix] * weights[1][iy]);
+            }
+
+        if constexpr (dim == 3)
+            for (auto ix = 0u; ix < order_size; ++ix)
+                for (auto iy = 0u; iy < order_size; ++iy)
+                {
+                    auto const xyWeight = weights[0][ix] * weights[1][iy];
+                    auto const row
+                        = ((startIndex[0] + ix) * shape_[1] + startIndex[1] + iy) * shape_[2]
+                          + startIndex[2];
+                    for (auto iz = 0u; iz < order_size; ++iz)
+                        addNode(row + iz, xyWeight * weights[2][iz]);
+                }
+    }
+
+
+    template<typename Field, typename VecField>
+    void scatter(Field& density, VecField& flux)
+    {
+        if (lower_[0] > upper_[0]) // nothing was added
+            return;
+
+        auto const& [xFlux, yFlux, zFlux] = flux();
+        auto scatterNode = [&](std::size_t node, auto... index) {
+            auto& values = values_[node];
+            density(index...) += values[0];
+            xFlux(index...) += values[1];
+            yFlux(index...) += values[2];
+            zFlux(index...) += values[3];
+            values = Moments{0., 0., 0., 0.};
+        };
+
+        for (auto x = lower_[0]; x <= upper_[0]; ++x)
+        {
+            if constexpr (dim == 1)
+                scatterNode(x, x);
+
+            if constexpr (dim == 2)
+                for (auto y = lower_[1]; y <= upper_[1]; ++y)
+                    scatterNode(x * shape_[1] + y, x, y);
+
+            if constexpr (dim == 3)
+                for (auto y = lower_[1]; y <= upper_[1]; ++y)
+                    for (auto z = lower_[2]; z <= upper_[2]; ++z)
+                        scatterNode((x * shape_[1] + y) * shape_[2] + z, x, y, z);
+        }
+    }
+
+
+private:
+    std::array<std::size_t, dim> shape_;
+    std::array<std::uint32_t, dim> lower_;
+    std::array<std::uint32_t, dim> upper_;
+    std::vector<Moments> values_;
+};
+
+
+
+
 /** \brief Interpolator is used to perform particle-mesh interpolations using
  * 1st, 2nd or 3rd order interpolation in 1D, 2D or 3D, on a given layout.
  */
@@ -523,11 +649,6 @@ public:
     inline void operator()(ParticleRange&& particleRange, Field& density, VecField& flux,
                            GridLayout const& layout, double coef = 1.)
     {
-        auto begin        = particleRange.begin();
-        auto end          = particleRange.end();
-        auto& startIndex_ = primal_startIndex_;
-        auto& weights_    = primal_weights_;
-
         // for each particle, first calculate the startIndex and weights
         // for dual and primal quantities.
         // then, knowing the centering (primal or dual) of each electromagnetic
@@ -536,16 +657,31 @@ public:
         // twice, and not for each E,B component.
 
         PHARE_LOG_START("ParticleToMesh::operator()");
+        deposit_(particleRange, density, flux, layout, coef);
+        PHARE_LOG_STOP("ParticleToMesh::operator()");
+    }
 
-        for (auto currPart = begin; currPart != end; ++currPart)
-        {
-            // TODO #3375
-            indexAndWeights_<QtyCentering, QtyCentering::primal>(layout, currPart->iCell,
-                                                                 currPart->delta);
 
-            particleToMesh_(density, flux, *currPart, startIndex_, weights_, coef);
-        }
-        PHARE_LOG_STOP("ParticleToMesh::operator()");
+
+    /**\brief project the density and flux of several particle ranges, each weighted by its
+     * own coefficient, onto the same moment fields
+     *
+     * each of the rangeCoefs is a (particle range, coef) pair, e.g. built with std::make_pair.
+     * The weights of the particles of all ranges are computed in a single loop and their
+     * contributions are accumulated in a write-combining buffer (see MomentCombiner), which is
+     * then added once to the moment fields. Ranges with a null coefficient are skipped. This is
+     * typically used to project patch ghost particles together with the old and new level ghost
+     * particles and their time interpolation coefficients.
+     */
+    template<typename VecField, typename GridLayout, typename Field, typename... RangeCoefs>
+    inline void depositRanges(Field& density, VecField& flux, GridLayout const& layout,
+                              RangeCoefs&&... rangeCoefs)
+    {
+        PHARE_LOG_START("ParticleToMesh::depositRanges");
+        combiner_.reset(density);
+        (combine_(std::get<0>(rangeCoefs), layout, std::get<1>(rangeCoefs)), ...);
+        combiner_.scatter(density, flux);
+        PHARE_LOG_STOP("ParticleToMesh::depositRanges");
     }
 
 
@@ -587,6 +723,47 @@ public:
 
 
 private:
+    template<typename ParticleRange, typename VecField, typename GridLayout, typename Field>
+    inline void deposit_(ParticleRange const& particleRange, Field& density, VecField& flux,
+                         GridLayout const& layout, double coef)
+    {
+        // ranges with a null coefficient do not contribute, skip computing their weights
+        if (coef == 0.)
+            return;
+
+        auto& startIndex_ = primal_startIndex_;
+        auto& weights_    = primal_weights_;
+
+        for (auto currPart = particleRange.begin(); currPart != particleRange.end(); ++currPart)
+        {
+            // TODO #3375
+            indexAndWeights_<QtyCentering, QtyCentering::primal>(layout, currPart->iCell,
+                                                                 currPart->delta);
+
+            particleToMesh_(density, flux, *currPart, startIndex_, weights_, coef);
+        }
+    }
+
+
+    template<typename ParticleRange, typename GridLayout>
+    inline void combine_(ParticleRange const& particleRange, GridLayout const& layout, double coef)
+    {
+        if (coef == 0.)
+            return;
+
+        for (auto currPart = particleRange.begin(); currPart != particleRange.end(); ++currPart)
+        {
+            indexAndWeights_<QtyCentering, QtyCentering::primal>(layout, currPart->iCell,
+                                                                 currPart->delta);
+
+            auto const weight = currPart->weight * coef;
+            combiner_.add(primal_startIndex_, primal_weights_,
+                          {weight, currPart->v[0] * weight, currPart->v[1] * weight,
+                           currPart->v[2] * weight});
+        }
+    }
+
+
     static_assert(dimension <= 3 && dimension > 0 && interpOrder >= 1 && interpOrder <= 3, "error");
 
     using Starts  = std::array<std::uint32_t, dimension>;
@@ -595,6 +772,7 @@ private:
     Weighter<interpOrder> weightComputer_;
     MeshToParticle<dimension> meshToParticle_;
     ParticleToMesh<dimension> particleToMesh_;
+    MomentCombiner<dimension> combiner_;
 
     Starts dual_startIndex_;
     Weights dual_weights_;
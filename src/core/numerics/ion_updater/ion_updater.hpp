@@ -9,6 +9,7 @@
 #include "core/numerics/pusher/pusher_factory.hpp"
 #include "core/numerics/boundary_condition/boundary_condition.hpp"
 #include "core/numerics/moments/moments.hpp"
+#include "core/numerics/particle_merger/particle_merger.hpp"
 #include "core/data/ions/ions.hpp"
 
 #include "initializer/data_provider.hpp"
@@ -17,6 +18,7 @@
 
 #include <cstddef>
 #include <memory>
+#include <optional>
 
 
 namespace PHARE::core
@@ -48,11 +50,16 @@ private:
 
     std::unique_ptr<Pusher> pusher_;
     Interpolator interpolator_;
+    std::optional<ParticleMerger<ParticleArray>> merger_;
+    bool mergeEnabled_ = false;
 
 public:
     IonUpdater(PHARE::initializer::PHAREDict const& dict)
         : pusher_{makePusher(dict["pusher"]["name"].template to<std::string>())}
     {
+        if (dict.contains("merger"))
+            merger_.emplace(dict["merger"]["max_ppc"].template to<int>(),
+                            dict["merger"]["target_ppc"].template to<int>());
     }
 
     void updatePopulations(Ions& ions, Electromag const& em, GridLayout const& layout, double dt,
@@ -62,6 +69,33 @@ public:
     void updateIons(Ions& ions, GridLayout const& layout);
 
 
+    /** @brief if a merger is configured, domain particles of crowded cells are merged after being
+     * pushed in UpdaterMode::all, and before they are deposited, until disabled
+     */
+    void enableMerging(bool enable) { mergeEnabled_ = enable and merger_.has_value(); }
+
+    //! returns what was merged since the previous call
+    ParticleMergerStats takeMergerStats()
+    {
+        if (!merger_)
+            return {};
+        auto stats = merger_->stats();
+        merger_->resetStats();
+        return stats;
+    }
+
+    //! particle speeds are tracked only once enabled, see takeMaxSpeed()
+    void trackMaxSpeed(bool track) { pusher_->trackMaxSpeed(track); }
+
+    //! returns the largest particle velocity, per direction, pushed since the previous call
+    std::array<double, dimension> takeMaxSpeed()
+    {
+        auto maxSpeed = pusher_->maxSpeed();
+        pusher_->resetMaxSpeed();
+        return maxSpeed;
+    }
+
+
 private:
     void updateAndDepositDomain_(Ions& ions, Electromag const& em, GridLayout const& layout);
 
@@ -259,6 +293,10 @@ void IonUpdater<Ions, Electromag, GridLayout>::updateAndDepositAll_(Ions& ions,
         pushAndCopyInDomain(makeIndexRange(pop.patchGhostParticles()));
         pushAndCopyInDomain(makeIndexRange(pop.levelGhostParticles()));
 
+        // before deposit, so moments and patch ghost particles are those of merged particles
+        if (mergeEnabled_)
+            merger_->merge(domainParticles, domainBox);
+
         interpolator_(makeIndexRange(domainParticles), pop.density(), pop.flux(), layout);
     }
 }
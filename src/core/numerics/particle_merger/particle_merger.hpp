@@ -0,0 +1,268 @@
+#ifndef PHARE_CORE_NUMERICS_PARTICLE_MERGER_HPP
+#define PHARE_CORE_NUMERICS_PARTICLE_MERGER_HPP
+
+#include "core/utilities/box/box.hpp"
+#include "core/logger.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+
+namespace PHARE::core
+{
+/** \brief ParticleMergerStats accumulates what a ParticleMerger did */
+struct ParticleMergerStats
+{
+    std::size_t nbrMergedCells     = 0;
+    std::size_t nbrParticlesBefore = 0; //! in merged cells, before merging
+    std::size_t nbrParticlesAfter  = 0; //! in merged cells, after merging
+
+    ParticleMergerStats& operator+=(ParticleMergerStats const& that)
+    {
+        nbrMergedCells += that.nbrMergedCells;
+        nbrParticlesBefore += that.nbrParticlesBefore;
+        nbrParticlesAfter += that.nbrParticlesAfter;
+        return *this;
+    }
+};
+
+
+
+/** \brief ParticleMerger reduces the number of particles of cells having more than maxPerCell
+ * particles, to about targetPerCell
+ *
+ * Particles of such a cell are binned in velocity space, by octant around the mean velocity of
+ * the cell, and sorted by distance to it. Consecutive particles of a bin are then grouped, and
+ * each group of N >= 3 particles is replaced by 2 particles such that:
+ *  - each has half the weight of the group
+ *  - both are at the weighted mean position of the group
+ *  - their velocities are V +/- s n, with V the weighted mean velocity of the group, n the
+ *    direction of the velocity of the group the furthest from V, and s the velocity spread that
+ *    conserves the kinetic energy of the group
+ *
+ * Weight, charge, momentum and kinetic energy are thus conserved in each cell. Cells are found
+ * with the CellMap of the particle array, which is rebuilt if particles were merged.
+ */
+template<typename ParticleArray>
+class ParticleMerger
+{
+    static constexpr auto dim = ParticleArray::dimension;
+    using Particle_t          = typename ParticleArray::Particle_t;
+    using Vec3                = std::array<double, 3>;
+
+    static constexpr std::size_t minGroupSize = 3;
+
+public:
+    ParticleMerger(std::size_t maxPerCell, std::size_t targetPerCell)
+        : maxPerCell_{maxPerCell}
+        , targetPerCell_{targetPerCell}
+    {
+        if (targetPerCell_ < 2 or targetPerCell_ > maxPerCell_)
+            throw std::runtime_error("ParticleMerger: invalid target ("
+                                     + std::to_string(targetPerCell) + ") and max ("
+                                     + std::to_string(maxPerCell) + ") particles per cell");
+    }
+
+
+    //! merges the particles of the cells of the given box that have too many of them
+    void merge(ParticleArray& particles, Box<int, dim> const& box)
+    {
+        PHARE_LOG_SCOPE("ParticleMerger::merge");
+
+        removed_.assign(particles.size(), false);
+        bool merged = false;
+
+        for (auto const& cell : box)
+        {
+            auto const& indexes = particles.indexes_in(cell);
+            if (indexes.size() <= maxPerCell_)
+                continue;
+
+            cellIndexes_.assign(std::begin(indexes), std::end(indexes));
+            mergeCell_(particles);
+            merged = true;
+        }
+
+        if (merged)
+            compact_(particles);
+    }
+
+
+    ParticleMergerStats const& stats() const { return stats_; }
+
+    void resetStats() { stats_ = ParticleMergerStats{}; }
+
+
+private:
+    void mergeCell_(ParticleArray& particles)
+    {
+        auto const nbrBefore = cellIndexes_.size();
+
+        // each group of groupSize particles becomes 2 particles
+        auto const groupSize
+            = std::max(minGroupSize, (2 * nbrBefore + targetPerCell_ - 1) / targetPerCell_);
+
+        Vec3 const cellV
+            = meanVelocity_(particles, std::begin(cellIndexes_), std::end(cellIndexes_));
+
+        auto octant = [&](std::size_t index) {
+            auto const& v = particles[index].v;
+            return (v[0] > cellV[0] ? 1 : 0) + (v[1] > cellV[1] ? 2 : 0)
+                   + (v[2] > cellV[2] ? 4 : 0);
+        };
+        auto distance = [&](std::size_t index) {
+            auto const& v = particles[index].v;
+            return norm2_({v[0] - cellV[0], v[1] - cellV[1], v[2] - cellV[2]});
+        };
+
+        std::sort(std::begin(cellIndexes_), std::end(cellIndexes_),
+                  [&](std::size_t i1, std::size_t i2) {
+                      auto const o1 = octant(i1), o2 = octant(i2);
+                      return o1 != o2 ? o1 < o2 : distance(i1) < distance(i2);
+                  });
+
+        std::size_t nbrAfter = 0;
+        auto binStart        = std::begin(cellIndexes_);
+        while (binStart != std::end(cellIndexes_))
+        {
+            auto const binOctant = octant(*binStart);
+            auto const binEnd    = std::find_if(binStart, std::end(cellIndexes_), [&](auto index) {
+                return octant(index) != binOctant;
+            });
+
+            for (auto groupStart = binStart; groupStart != binEnd;)
+            {
+                auto const left     = static_cast<std::size_t>(std::distance(groupStart, binEnd));
+                auto const groupEnd = groupStart + std::min(groupSize, left);
+
+                if (left >= minGroupSize)
+                {
+                    mergeGroup_(particles, groupStart, groupEnd);
+                    nbrAfter += 2;
+                }
+                else
+                    nbrAfter += left;
+
+                groupStart = groupEnd;
+            }
+            binStart = binEnd;
+        }
+
+        stats_.nbrMergedCells++;
+        stats_.nbrParticlesBefore += nbrBefore;
+        stats_.nbrParticlesAfter += nbrAfter;
+    }
+
+
+
+    template<typename Iterator>
+    void mergeGroup_(ParticleArray& particles, Iterator groupStart, Iterator groupEnd)
+    {
+        double weight = 0;
+        double energy = 0; // twice the kinetic energy per unit mass
+        std::array<double, dim> delta{};
+
+        for (auto it = groupStart; it != groupEnd; ++it)
+        {
+            auto const& particle = particles[*it];
+            weight += particle.weight;
+            energy += particle.weight * norm2_(particle.v);
+            for (std::size_t iDim = 0; iDim < dim; ++iDim)
+                delta[iDim] += particle.weight * particle.delta[iDim];
+        }
+
+        Vec3 const V = meanVelocity_(particles, groupStart, groupEnd);
+
+        // the velocity furthest from V gives the direction along which the two merged particles
+        // spread, so that it stays along the main direction of the group dispersion
+        Vec3 direction{1., 0., 0.};
+        double maxDistance = 0;
+        for (auto it = groupStart; it != groupEnd; ++it)
+        {
+            auto const& v = particles[*it].v;
+            Vec3 const dv{v[0] - V[0], v[1] - V[1], v[2] - V[2]};
+            if (auto const distance = norm2_(dv); distance > maxDistance)
+            {
+                maxDistance = distance;
+                direction   = dv;
+            }
+        }
+        if (maxDistance > 0)
+            for (auto& component : direction)
+                component /= std::sqrt(maxDistance);
+
+        auto const spread = std::sqrt(std::max(0., energy / weight - norm2_(V)));
+
+        for (std::size_t iDim = 0; iDim < dim; ++iDim)
+            delta[iDim] /= weight;
+
+        // the first two particles of the group are overwritten, they stay in the same cell so the
+        // CellMap is unchanged for them, the others are removed
+        auto setMerged = [&](Particle_t& particle, double sign) {
+            particle.weight = 0.5 * weight;
+            particle.delta  = delta;
+            for (std::size_t iComp = 0; iComp < 3; ++iComp)
+                particle.v[iComp] = V[iComp] + sign * spread * direction[iComp];
+        };
+        setMerged(particles[*groupStart], 1.);
+        setMerged(particles[*(groupStart + 1)], -1.);
+
+        for (auto it = groupStart + 2; it != groupEnd; ++it)
+            removed_[*it] = true;
+    }
+
+
+
+    template<typename Iterator>
+    static Vec3 meanVelocity_(ParticleArray const& particles, Iterator first, Iterator last)
+    {
+        Vec3 momentum{};
+        double weight = 0;
+        for (auto it = first; it != last; ++it)
+        {
+            auto const& particle = particles[*it];
+            weight += particle.weight;
+            for (std::size_t iComp = 0; iComp < 3; ++iComp)
+                momentum[iComp] += particle.weight * particle.v[iComp];
+        }
+        for (auto& component : momentum)
+            component /= weight;
+        return momentum;
+    }
+
+
+    static double norm2_(Vec3 const& v) { return v[0] * v[0] + v[1] * v[1] + v[2] * v[2]; }
+
+
+    //! removes merged particles from the array, keeping the order of the others
+    void compact_(ParticleArray& particles)
+    {
+        auto& vector        = particles.vector();
+        std::size_t nbrKept = 0;
+        for (std::size_t index = 0; index < vector.size(); ++index)
+            if (!removed_[index])
+                vector[nbrKept++] = vector[index];
+        vector.resize(nbrKept);
+
+        particles.empty_map();
+        particles.map_particles();
+    }
+
+
+    std::size_t maxPerCell_;
+    std::size_t targetPerCell_;
+    ParticleMergerStats stats_;
+
+    // reused from one merge to the next
+    std::vector<std::size_t> cellIndexes_;
+    std::vector<bool> removed_;
+};
+
+} // namespace PHARE::core
+
+#endif
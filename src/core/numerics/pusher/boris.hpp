@@ -116,6 +116,14 @@ public:
 
 
 
+    void trackMaxSpeed(bool track) override { trackMaxSpeed_ = track; }
+
+    std::array<double, dim> maxSpeed() const override { return maxSpeed_; }
+
+    void resetMaxSpeed() override { maxSpeed_.fill(0.); }
+
+
+
 private:
     enum class PushStep { PrePush, PostPush };
 
@@ -245,6 +253,10 @@ private:
             outPart.v[0] = velx1;
             outPart.v[1] = vely1;
             outPart.v[2] = velz1;
+
+            if (trackMaxSpeed_)
+                for (std::size_t iDim = 0; iDim < dim; ++iDim)
+                    maxSpeed_[iDim] = std::max(maxSpeed_[iDim], std::abs(outPart.v[iDim]));
         }
     }
 
@@ -253,6 +265,8 @@ private:
 
     std::array<double, dim> halfDtOverDl_;
     double dt_;
+    bool trackMaxSpeed_ = false;
+    std::array<double, dim> maxSpeed_{};
 };
 
 } // namespace PHARE::core
@@ -1,6 +1,7 @@
 #ifndef PHARE_CORE_NUMERICS_PUSHER_PUSHER_HPP
 #define PHARE_CORE_NUMERICS_PUSHER_PUSHER_HPP
 
+#include <array>
 #include <cstddef>
 #include <type_traits>
 #include <utility>
@@ -34,6 +35,17 @@ namespace core
 
         virtual void setMeshAndTimeStep(std::array<double, dim> ms, double ts) = 0;
 
+
+        /** @brief particle speeds are only tracked if asked, since it costs a few operations per
+         * pushed particle, for maxSpeed() below
+         */
+        virtual void trackMaxSpeed(bool track) = 0;
+
+        //! largest absolute velocity, per direction, of the particles pushed since the last reset
+        virtual std::array<double, dim> maxSpeed() const = 0;
+
+        virtual void resetMaxSpeed() = 0;
+
         virtual ~Pusher() {}
     };
 
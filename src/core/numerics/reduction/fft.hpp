@@ -0,0 +1,152 @@
+#ifndef PHARE_CORE_NUMERICS_REDUCTION_FFT_HPP
+#define PHARE_CORE_NUMERICS_REDUCTION_FFT_HPP
+
+#include <cmath>
+#include <complex>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+
+namespace PHARE::core
+{
+/** @brief in place iterative radix-2 Cooley-Tukey transform, X_k = sum_n x_n exp(-2 i pi k n / N),
+ * N being a power of 2
+ */
+inline void radix2FFT(std::vector<std::complex<double>>& values)
+{
+    auto const size = values.size();
+    if (size < 2)
+        return;
+
+    double const pi = std::acos(-1.);
+
+    // bit reversal permutation
+    for (std::size_t i = 1, j = 0; i < size; ++i)
+    {
+        auto bit = size >> 1;
+        for (; j & bit; bit >>= 1)
+            j ^= bit;
+        j ^= bit;
+        if (i < j)
+            std::swap(values[i], values[j]);
+    }
+
+    for (std::size_t length = 2; length <= size; length <<= 1)
+    {
+        auto const root = std::polar(1., -2. * pi / static_cast<double>(length));
+        for (std::size_t start = 0; start < size; start += length)
+        {
+            std::complex<double> twiddle{1.};
+            for (std::size_t i = 0; i < length / 2; ++i)
+            {
+                auto const even = values[start + i];
+                auto const odd  = values[start + i + length / 2] * twiddle;
+
+                values[start + i]              = even + odd;
+                values[start + i + length / 2] = even - odd;
+                twiddle *= root;
+            }
+        }
+    }
+}
+
+
+
+/** @brief in place Bluestein transform, for any N
+ *
+ * With kn = (k^2 + n^2 - (k - n)^2) / 2, X_k = w_k sum_n (x_n w_n) conj(w_{k-n}), the chirp w_n
+ * being exp(-i pi n^2 / N). The convolution is computed with radix-2 transforms of a power of 2
+ * size M >= 2N - 1, hence in O(N log N).
+ */
+inline void bluesteinFFT(std::vector<std::complex<double>>& values)
+{
+    auto const size = values.size();
+    if (size < 2)
+        return;
+
+    double const pi = std::acos(-1.);
+
+    // n^2 is taken modulo 2N, the chirp being 2N periodic, to keep its phase accurate
+    std::vector<std::complex<double>> chirp(size);
+    for (std::size_t n = 0; n < size; ++n)
+        chirp[n] = std::polar(1., -pi * static_cast<double>((n * n) % (2 * size))
+                                      / static_cast<double>(size));
+
+    std::size_t convolutionSize = 1;
+    while (convolutionSize < 2 * size - 1)
+        convolutionSize <<= 1;
+
+    std::vector<std::complex<double>> signal(convolutionSize), kernel(convolutionSize);
+    for (std::size_t n = 0; n < size; ++n)
+        signal[n] = values[n] * chirp[n];
+
+    kernel[0] = 1.;
+    for (std::size_t n = 1; n < size; ++n)
+        kernel[n] = kernel[convolutionSize - n] = std::conj(chirp[n]);
+
+    radix2FFT(signal);
+    radix2FFT(kernel);
+
+    // inverse transform of the product, as the conjugate of the transform of its conjugate
+    for (std::size_t i = 0; i < convolutionSize; ++i)
+        signal[i] = std::conj(signal[i] * kernel[i]);
+    radix2FFT(signal);
+
+    auto const norm = 1. / static_cast<double>(convolutionSize);
+    for (std::size_t k = 0; k < size; ++k)
+        values[k] = std::conj(signal[k]) * norm * chirp[k];
+}
+
+
+
+/** @brief in place discrete Fourier transform, X_k = sum_n x_n exp(-2 i pi k n / N)
+ *
+ * radix2FFT is used when N is a power of 2, bluesteinFFT otherwise
+ */
+inline void fft(std::vector<std::complex<double>>& values)
+{
+    auto const size = values.size();
+    if ((size & (size - 1)) == 0)
+        radix2FFT(values);
+    else
+        bluesteinFFT(values);
+}
+
+
+
+//! number of values of powerSpectrum for a signal of signalSize values
+inline std::size_t powerSpectrumSize(std::size_t const signalSize)
+{
+    return signalSize / 2 + 1;
+}
+
+
+
+/** @brief one sided power spectrum of a real signal of N values, |X_k|^2 / N^2 for k in [0, N/2]
+ *
+ * Negative frequencies are folded onto positive ones, so that the sum of the spectrum is the mean
+ * of the squared signal (Parseval)
+ */
+inline std::vector<double> powerSpectrum(std::vector<double> const& signal)
+{
+    std::vector<std::complex<double>> values(std::begin(signal), std::end(signal));
+    fft(values);
+
+    auto const size = values.size();
+    std::vector<double> spectrum(powerSpectrumSize(size), 0.);
+    if (size == 0)
+        return spectrum;
+
+    auto const norm = 1. / static_cast<double>(size * size);
+    for (std::size_t k = 0; k < spectrum.size(); ++k)
+    {
+        bool const folded = k != 0 and 2 * k != size;
+        spectrum[k]       = (folded ? 2. : 1.) * std::norm(values[k]) * norm;
+    }
+    return spectrum;
+}
+
+} // namespace PHARE::core
+
+#endif
@@ -0,0 +1,141 @@
+#ifndef PHARE_CORE_NUMERICS_REDUCTION_GLOBAL_FIELD_HPP
+#define PHARE_CORE_NUMERICS_REDUCTION_GLOBAL_FIELD_HPP
+
+#include "core/numerics/reduction/fft.hpp"
+#include "core/numerics/reduction/profile.hpp"
+#include "core/utilities/box/box.hpp"
+
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <numeric>
+#include <vector>
+
+
+namespace PHARE::core
+{
+/** \brief GlobalField holds one value per cell of the whole level 0 domain, c-ordered, the
+ * domain lower cell being 0
+ *
+ * It holds whole lines of the domain, as needed by spectra, and is meant to be assembled by a
+ * single process from the cells of the patches of all processes. A field component is taken at the
+ * node, or cell center, of lower index of each cell, whatever its centering.
+ */
+template<std::size_t dim>
+class GlobalField
+{
+public:
+    explicit GlobalField(std::array<std::size_t, dim> shape)
+        : shape_{shape}
+        , values_(std::accumulate(std::begin(shape), std::end(shape), std::size_t{1},
+                                  std::multiplies<std::size_t>{}),
+                  0.)
+    {
+    }
+
+
+    template<typename Cell>
+    double& operator()(Cell const& cell)
+    {
+        return values_[linear_(cell)];
+    }
+
+    template<typename Cell>
+    double operator()(Cell const& cell) const
+    {
+        return values_[linear_(cell)];
+    }
+
+    auto& values() { return values_; }
+    auto const& values() const { return values_; }
+    auto const& shape() const { return shape_; }
+
+    Box<int, dim> box() const
+    {
+        Box<int, dim> box;
+        for (std::size_t iDim = 0; iDim < dim; ++iDim)
+        {
+            box.lower[iDim] = 0;
+            box.upper[iDim] = static_cast<int>(shape_[iDim]) - 1;
+        }
+        return box;
+    }
+
+
+    /** @brief profile along axis of the values of the box, averaged over the other directions,
+     * one value per cell of the box along axis. Empty if the box is out of the domain.
+     */
+    std::vector<double> profile(Box<int, dim> const& box, std::size_t const axis) const
+    {
+        Profile<dim> profile{box, this->box(), axis};
+        profile.add(this->box(), [&](auto const& cell) { return (*this)(cell); });
+        return profile.averages();
+    }
+
+
+    //! number of values of profile(box, axis)
+    std::size_t profileSize(Box<int, dim> const& box, std::size_t const axis) const
+    {
+        return Profile<dim>{box, this->box(), axis}.size();
+    }
+
+
+    //! number of values of spectrum(axis)
+    std::size_t spectrumSize(std::size_t const axis) const
+    {
+        return powerSpectrumSize(shape_[axis]);
+    }
+
+
+    /** @brief power spectrum (see powerSpectrum) of the values along axis, averaged over all the
+     * lines of the domain along axis
+     */
+    std::vector<double> spectrum(std::size_t const axis) const
+    {
+        std::vector<double> spectrum(spectrumSize(axis), 0.);
+
+        // the lines along axis start at the cells of the domain face normal to axis
+        auto face         = box();
+        face.upper[axis]  = 0;
+        std::size_t lines = 0;
+
+        std::vector<double> line(shape_[axis]);
+        for (auto const& start : face)
+        {
+            auto cell = start;
+            for (std::size_t i = 0; i < line.size(); ++i)
+            {
+                cell[axis] = static_cast<int>(i);
+                line[i]    = (*this)(cell);
+            }
+
+            auto const lineSpectrum = powerSpectrum(line);
+            for (std::size_t k = 0; k < spectrum.size(); ++k)
+                spectrum[k] += lineSpectrum[k];
+            ++lines;
+        }
+
+        for (auto& value : spectrum)
+            value /= static_cast<double>(lines);
+        return spectrum;
+    }
+
+
+private:
+    template<typename Cell>
+    std::size_t linear_(Cell const& cell) const
+    {
+        std::size_t index = 0;
+        for (std::size_t iDim = 0; iDim < dim; ++iDim)
+            index = index * shape_[iDim] + static_cast<std::size_t>(cell[iDim]);
+        return index;
+    }
+
+
+    std::array<std::size_t, dim> shape_;
+    std::vector<double> values_;
+};
+
+} // namespace PHARE::core
+
+#endif
@@ -0,0 +1,78 @@
+#ifndef PHARE_CORE_NUMERICS_REDUCTION_PROFILE_HPP
+#define PHARE_CORE_NUMERICS_REDUCTION_PROFILE_HPP
+
+#include "core/utilities/box/box.hpp"
+
+#include <cstddef>
+#include <optional>
+#include <vector>
+
+
+namespace PHARE::core
+{
+/** \brief Profile sums the values of the cells of a box, clipped to the domain, per slice normal
+ * to axis. The average of each slice is the profile.
+ *
+ * Each process adds the cells of its own patches, the sums of the whole domain are thus the sums
+ * over processes of the sums of each process, one value per slice.
+ */
+template<std::size_t dim>
+class Profile
+{
+public:
+    Profile(Box<int, dim> const& box, Box<int, dim> const& domain, std::size_t const axis)
+        : overlap_{box * domain}
+        , axis_{axis}
+    {
+        if (overlap_)
+        {
+            auto const nbrSlices = overlap_->upper[axis] - overlap_->lower[axis] + 1;
+            sums_.assign(static_cast<std::size_t>(nbrSlices), 0.);
+        }
+    }
+
+
+    //! adds the values of the cells of the box which are in the profile box
+    template<typename Values>
+    void add(Box<int, dim> const& box, Values&& valueAt)
+    {
+        if (!overlap_)
+            return;
+
+        if (auto const overlap = box * *overlap_)
+            for (auto const& cell : *overlap)
+                sums_[static_cast<std::size_t>(cell[axis_] - overlap_->lower[axis_])]
+                    += valueAt(cell);
+    }
+
+
+    //! number of values of the profile, 0 if the box is out of the domain
+    std::size_t size() const { return sums_.size(); }
+
+    auto& sums() { return sums_; }
+    auto const& sums() const { return sums_; }
+
+
+    //! sums averaged over each slice
+    std::vector<double> averages() const
+    {
+        if (sums_.empty())
+            return {};
+
+        auto averages          = sums_;
+        auto const nbrPerSlice = static_cast<double>(overlap_->size() / sums_.size());
+        for (auto& average : averages)
+            average /= nbrPerSlice;
+        return averages;
+    }
+
+
+private:
+    std::optional<Box<int, dim>> overlap_;
+    std::size_t axis_;
+    std::vector<double> sums_;
+};
+
+} // namespace PHARE::core
+
+#endif
@@ -0,0 +1,37 @@
+#ifndef PHARE_CORE_NUMERICS_TIME_STEP_STABLE_TIME_STEP_HPP
+#define PHARE_CORE_NUMERICS_TIME_STEP_STABLE_TIME_STEP_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+
+
+namespace PHARE::core
+{
+/** @brief the largest time step at which waves do not cross more than a cell, given the smallest
+ * mesh size, the smallest non zero ion density and the largest magnetic field magnitude
+ *
+ * - whistler waves, dl^2 n / (pi B), are carried by the fields, so the constraint applies to each
+ *   of the nbrFieldSubsteps substeps of field solves
+ * - Alfven waves, dl sqrt(n) / B, are carried by the ions, which are pushed once per time step
+ *
+ * The time step is infinite without magnetic field or ions.
+ */
+inline double stableWaveTimeStep(double const minDl, double const minDensity, double const maxB,
+                                  std::size_t const nbrFieldSubsteps = 1)
+{
+    constexpr double pi = 3.14159265358979323846;
+
+    if (maxB <= 0 or minDensity <= 0 or minDensity == std::numeric_limits<double>::max())
+        return std::numeric_limits<double>::max();
+
+    auto const whistlerDt = minDl * minDl * minDensity / (pi * maxB);
+    auto const alfvenDt   = minDl * std::sqrt(minDensity) / maxB;
+    return std::min(nbrFieldSubsteps * whistlerDt, alfvenDt);
+}
+
+
+} // namespace PHARE::core
+
+#endif
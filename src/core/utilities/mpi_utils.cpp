@@ -1,5 +1,8 @@
 #include "mpi_utils.hpp"
 
+#include <algorithm>
+#include <limits>
+
 namespace PHARE::core::mpi
 {
 int size()
@@ -27,6 +30,70 @@ std::size_t max(std::size_t const local, int mpi_size)
 
 
 
+double min(double const local)
+{
+    double global;
+    MPI_Allreduce(&local, &global, 1, MPI_DOUBLE, MPI_MIN, MPI_COMM_WORLD);
+    return global;
+}
+
+
+
+// MPI counts are int, larger buffers are reduced in chunks of at most INT_MAX values
+template<typename Reduce>
+void reduceInChunks_(std::size_t const size, Reduce&& reduce)
+{
+    std::size_t constexpr maxCount = std::numeric_limits<int>::max();
+    for (std::size_t offset = 0; offset < size; offset += maxCount)
+        reduce(offset, static_cast<int>(std::min(maxCount, size - offset)));
+}
+
+
+
+std::vector<double> sum(std::vector<double> const& local)
+{
+    std::vector<double> global(local.size());
+    reduceInChunks_(local.size(), [&](std::size_t offset, int count) {
+        MPI_Allreduce(local.data() + offset, global.data() + offset, count, MPI_DOUBLE, MPI_SUM,
+                      MPI_COMM_WORLD);
+    });
+    return global;
+}
+
+
+
+void sumOnRoot(std::vector<double>& values)
+{
+    bool const root = rank() == 0;
+    reduceInChunks_(values.size(), [&](std::size_t offset, int count) {
+        auto* data = values.data() + offset;
+        MPI_Reduce(root ? MPI_IN_PLACE : data, root ? data : nullptr, count, MPI_DOUBLE, MPI_SUM,
+                   0, MPI_COMM_WORLD);
+    });
+}
+
+
+
+std::vector<double> gatherOnRoot(std::vector<double> const& local)
+{
+    bool const root = rank() == 0;
+    int const count = static_cast<int>(local.size());
+
+    std::vector<int> counts(root ? size() : 0);
+    MPI_Gather(&count, 1, MPI_INT, counts.data(), 1, MPI_INT, 0, MPI_COMM_WORLD);
+
+    std::vector<int> displs(counts.size(), 0);
+    for (std::size_t i = 1; i < counts.size(); ++i)
+        displs[i] = displs[i - 1] + counts[i - 1];
+
+    std::vector<double> global(root ? displs.back() + counts.back() : 0);
+    MPI_Gatherv(local.data(), count, MPI_DOUBLE, global.data(), counts.data(), displs.data(),
+                MPI_DOUBLE, 0, MPI_COMM_WORLD);
+    return global;
+}
+
+
+
 bool any(bool b)
 {
     int global_sum, local_sum = static_cast<int>(b);
@@ -26,6 +26,18 @@ std::vector<Data> collect(Data const& data, int mpi_size = 0);
 
 std::size_t max(std::size_t const local, int mpi_size = 0);
 
+double min(double const local);
+
+//! element wise sum over all processes
+std::vector<double> sum(std::vector<double> const& local);
+
+//! element wise sum over all processes into the values of the first process, the values of the
+//! other processes are left untouched
+void sumOnRoot(std::vector<double>& values);
+
+//! values of all processes, one after the other by rank, on the first process, empty on the others
+std::vector<double> gatherOnRoot(std::vector<double> const& local);
+
 bool any(bool);
 
 int size();
@@ -113,7 +125,7 @@ std::vector<Vector> collectVector(Vector const& sendBuff, int mpi_size = 0)
     std::vector<Vector> collected;
     for (int i = 0; i < mpi_size; i++)
     {
-        collected.emplace_back(&rcvBuff[offset], &rcvBuff[offset] + perMPISize[i]);
+        collected.emplace_back(rcvBuff.data() + offset, rcvBuff.data() + offset + perMPISize[i]);
         offset += perMPISize[i];
     }
     return collected;
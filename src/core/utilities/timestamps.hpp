@@ -2,18 +2,55 @@
 #define PHARE_CORE_UTILITIES_TIMESTAMPS_HPP
 
 #include <string>
+#include <vector>
 #include <cassert>
+#include <cmath>
 #include <cstdint>
+#include <limits>
+#include <memory>
+#include <algorithm>
+#include <stdexcept>
 
 #include "core/logger.hpp"
 #include "initializer/data_provider.hpp"
 
 namespace PHARE::core
 {
+//! rounding errors under which a time is considered to be on a landmark time
+inline double landmarkTolerance(double const time)
+{
+    return 1e-12 * std::max(1., std::abs(time));
+}
+
+
+/** @brief tells if the given time is the given landmark time. Adaptive time steps land on
+ * landmarks, constant ones reach the landmarks that are multiples of the time step
+ */
+inline bool isOnLandmark(double const time, double const landmark)
+{
+    return std::abs(landmark - time) <= landmarkTolerance(time);
+}
+
+
+
 struct ITimeStamper
 {
     virtual double operator+=(double const& new_dt) noexcept = 0;
 
+    //! the time step to take next
+    virtual double timeStep() const noexcept = 0;
+
+    /** @brief updates and returns the time step to take next, given the largest stable time step
+     * over the whole simulation, as estimated after the previous step
+     */
+    virtual double updateTimeStep(double const /*stableDt*/) { return timeStep(); }
+
+    //! false if the time step never changes, the stable time step then needs not be computed
+    virtual bool adaptive() const noexcept { return false; }
+
+    //! the time step to save in restarts, a simulation restarted from them starts with it
+    virtual double restartTimeStep() const noexcept { return timeStep(); }
+
     virtual ~ITimeStamper() {}
 };
 
@@ -33,20 +70,142 @@ public:
         return dt_ * ++idx_;
     }
 
+    double timeStep() const noexcept override { return dt_; }
+
 private:
     double dt_       = 0;
     std::size_t idx_ = 0;
 };
 
+
+
+struct AdaptiveTimeStepParams
+{
+    double cfl   = 0.5; //! fraction of the stable time step actually taken
+    double minDt = 0;   //! the simulation stops if the time step needs to go below this
+    double maxDt = std::numeric_limits<double>::max();
+};
+
+
+
+/** \brief AdaptiveTimeStamper takes time steps that are a fraction (the CFL number) of the
+ * largest stable time step, as estimated from the state of the simulation after each step
+ *
+ * A step is never more than twice the previous one, nor greater than maxDt. Steps are then
+ * shortened so that the simulation lands on each landmark time (typically diagnostic and restart
+ * timestamps, and the final time), taking two equal steps rather than a full and a tiny one when
+ * the next landmark is less than two steps away.
+ *
+ * Landmarks and the returned times are relative to the start time of the simulation.
+ */
+class AdaptiveTimeStamper : public ITimeStamper
+{
+    static constexpr double maxGrowth = 2.;
+
+public:
+    AdaptiveTimeStamper(double const initDt, AdaptiveTimeStepParams const& params,
+                        std::vector<double> landmarks)
+        : params_{params}
+        , dt_{std::min(initDt, params.maxDt)}
+        , landmarks_{std::move(landmarks)}
+    {
+        if (params_.cfl <= 0 or params_.minDt > params_.maxDt)
+            throw std::runtime_error("AdaptiveTimeStamper: invalid cfl or time step bounds");
+
+        std::sort(std::begin(landmarks_), std::end(landmarks_));
+        nextDt_ = landAt_(dt_);
+    }
+
+    double operator+=(double const& new_dt) noexcept override { return (elapsed_ += new_dt); }
+
+
+    double timeStep() const noexcept override { return nextDt_; }
+
+
+    double updateTimeStep(double const stableDt) override
+    {
+        dt_ = std::min({params_.cfl * stableDt, maxGrowth * dt_, params_.maxDt});
+
+        if (dt_ < params_.minDt)
+            throw std::runtime_error("AdaptiveTimeStamper: time step " + std::to_string(dt_)
+                                     + " is below the minimum " + std::to_string(params_.minDt));
+
+        return (nextDt_ = landAt_(dt_));
+    }
+
+
+    bool adaptive() const noexcept override { return true; }
+
+
+    //! the last time step before it was shortened to land on a landmark, the landmarks being
+    //! relative to the start time, a restarted stamper only needs it to take the same steps
+    double restartTimeStep() const noexcept override { return dt_; }
+
+
+private:
+    //! shortens dt so that the next landmark is hit exactly
+    double landAt_(double const dt)
+    {
+        // landmarks reached up to rounding errors are passed
+        while (nextLandmark_ < landmarks_.size()
+               and landmarks_[nextLandmark_] - elapsed_ <= landmarkTolerance(elapsed_))
+            ++nextLandmark_;
+
+        if (nextLandmark_ == landmarks_.size())
+            return dt;
+
+        auto const untilLandmark = landmarks_[nextLandmark_] - elapsed_;
+        if (untilLandmark <= dt)
+            return untilLandmark;
+        if (untilLandmark < 2 * dt)
+            return 0.5 * untilLandmark;
+        return dt;
+    }
+
+
+    AdaptiveTimeStepParams params_;
+    double dt_; //! before it is shortened to land on a landmark
+    double nextDt_;
+    double elapsed_ = 0;
+    std::vector<double> landmarks_;
+    std::size_t nextLandmark_ = 0;
+};
+
+
+
 struct TimeStamperFactory
 {
-    static std::unique_ptr<ITimeStamper> create(initializer::PHAREDict const& dict)
+    /** @brief makes the time stamper configured in the simulation dict, landmarks are the
+     * times, relative to the start time, that the simulation has to land on. An adaptive time
+     * stepping restarted from a restart with a saved time step (restarts/time_step) starts with it.
+     */
+    static std::unique_ptr<ITimeStamper> create(initializer::PHAREDict const& dict,
+                                                std::vector<double> landmarks = {})
     {
         assert(dict.contains("time_step"));
-        auto time_step  = dict["time_step"].template to<double>();
-        std::size_t idx = 0;
+        auto time_step = dict["time_step"].template to<double>();
+
+        if (dict.contains("time_stepping")
+            and dict["time_stepping"]["mode"].template to<std::string>() == "adaptive")
+        {
+            auto const& params = dict["time_stepping"];
+            AdaptiveTimeStepParams adaptiveParams;
+            if (params.contains("cfl"))
+                adaptiveParams.cfl = params["cfl"].template to<double>();
+            if (params.contains("min_dt"))
+                adaptiveParams.minDt = params["min_dt"].template to<double>();
+            if (params.contains("max_dt"))
+                adaptiveParams.maxDt = params["max_dt"].template to<double>();
 
-        // only option for the moment https://github.com/PHAREHUB/PHARE/issues/475
+            if (dict.contains("restarts") and dict["restarts"].contains("time_step"))
+                time_step = dict["restarts"]["time_step"].template to<double>();
+
+            return std::make_unique<AdaptiveTimeStamper>(time_step, adaptiveParams,
+                                                         std::move(landmarks));
+        }
+
+        // see https://github.com/PHAREHUB/PHARE/issues/475
+        std::size_t idx = 0;
         return std::make_unique<ConstantTimeStamper>(time_step, idx);
     }
 };
@@ -1,10 +1,14 @@
 #ifndef HIGHFIVEDIAGNOSTICWRITER_HPP
 #define HIGHFIVEDIAGNOSTICWRITER_HPP
 
+#include <map>
+#include <set>
 #include <string>
+#include <vector>
 #include <algorithm>
 #include <unordered_map>
 
+#include "core/data/vecfield/vecfield_component.hpp"
 #include "core/utilities/mpi_utils.hpp"
 
 #include "diagnostic/diagnostic_writer.hpp"
@@ -112,6 +116,118 @@ protected:
         h5Writer_.writeAttributeDict(file, fileAttributes, "/");
     }
 
+    /*
+     * In the "aggregated" layout, a diagnostic has a single dataset per quantity, level and time,
+     * concatenating the data of all the patches of the level, rather than one dataset per patch.
+     * Fields are flattened, particles are rows. Patches are described by the index table of the
+     * level:
+     *
+     * /t#/pl#/patches/(lower, upper, origin)     one row per patch
+     * /t#/pl#/patches/<dataset>_(offset, shape)  first row and shape of the patch data
+     *
+     * write() only buffers the data of the patches of the current process, each process then
+     * writes its part of the level datasets in writeAggregated_()
+     */
+    static bool aggregated_(DiagnosticProperties const& diagnostic)
+    {
+        return diagnostic.params.contains("layout")
+               and diagnostic.param<std::string>("layout") == "aggregated";
+    }
+
+    template<typename Field>
+    void aggregate_(DiagnosticProperties const& diagnostic, std::string const& name,
+                    Field const& field)
+    {
+        using GridLayout = typename Writer::GridLayout;
+
+        auto& dataSet = aggregatedData_[diagnostic.quantity][h5Writer_.patchLevel()][name];
+        dataSet.offsets.push_back(dataSet.data.size());
+        for (auto const& n : field.shape())
+            dataSet.shapes.push_back(n);
+        dataSet.data.insert(std::end(dataSet.data), std::begin(field), std::end(field));
+        dataSet.ghosts = GridLayout::nDNbrGhosts(field.physicalQuantity())[0];
+    }
+
+    template<typename VecField>
+    void aggregateVecField_(DiagnosticProperties const& diagnostic, std::string const& name,
+                            VecField const& vecField)
+    {
+        for (auto& [id, type] : core::Components::componentMap)
+            aggregate_(diagnostic, name + "_" + id, vecField.getComponent(type));
+    }
+
+    void writeAggregated_(
+        DiagnosticProperties& diagnostic, HighFiveFile& file, Attributes& fileAttributes,
+        std::unordered_map<std::size_t, std::vector<std::pair<std::string, Attributes>>>&
+            patchAttributes,
+        std::size_t maxLevel)
+    {
+        auto& levels = aggregatedData_[diagnostic.quantity];
+
+        // a process without patches on a level writes nothing in its datasets, but still takes
+        // part in their collective creation and writes
+        std::vector<std::pair<std::string, Attributes>> noPatches;
+
+        for (std::size_t lvl = h5Writer_.minLevel; lvl <= maxLevel; lvl++)
+        {
+            auto const levelPath = h5Writer_.getLevelPathAddTimestamp(lvl);
+            auto levelPatches    = patchAttributes.find(lvl);
+            writePatchTable_(file, levelPath,
+                             levelPatches != patchAttributes.end() ? levelPatches->second
+                                                                   : noPatches);
+
+            auto& dataSets = levels[lvl];
+            for (auto const& name : collectNames_(dataSets))
+            {
+                auto& dataSet       = dataSets[name];
+                auto const dataPath = levelPath + "/" + name;
+                auto const first    = file.write_data_set_concatenated(dataPath, dataSet.data);
+
+                for (auto& offset : dataSet.offsets)
+                    offset += first;
+                file.write_data_set_concatenated(levelPath + "/patches/" + name + "_offset",
+                                                 dataSet.offsets);
+                file.write_data_set_concatenated(levelPath + "/patches/" + name + "_shape",
+                                                 dataSet.shapes, dimension);
+                file.write_data_set_attribute(dataPath, "ghosts", core::mpi::max(dataSet.ghosts));
+            }
+        }
+        aggregatedData_.erase(diagnostic.quantity);
+
+        writeAggregatedFileAttributes_(diagnostic, file, fileAttributes);
+    }
+
+    void writePatchTable_(HighFiveFile& file, std::string const& levelPath,
+                          std::vector<std::pair<std::string, Attributes>>& patches)
+    {
+        std::vector<int> lower, upper;
+        std::vector<double> origin;
+        for (auto& [patch, attr] : patches)
+        {
+            auto append = [](auto& to, auto const& from) {
+                to.insert(std::end(to), std::begin(from), std::end(from));
+            };
+            append(lower, attr["lower"].template to<std::vector<int>>());
+            append(upper, attr["upper"].template to<std::vector<int>>());
+            append(origin, attr["origin"].template to<std::vector<double>>());
+        }
+        file.write_data_set_concatenated(levelPath + "/patches/lower", lower, dimension);
+        file.write_data_set_concatenated(levelPath + "/patches/upper", upper, dimension);
+        file.write_data_set_concatenated(levelPath + "/patches/origin", origin, dimension,
+                                         /*exact=*/true);
+    }
+
+    void writeAggregatedFileAttributes_(DiagnosticProperties& diagnostic, HighFiveFile& file,
+                                        Attributes& fileAttributes)
+    {
+        if (diagnostic.nAttributes > 0)
+            h5Writer_.writeAttributeDict(file, diagnostic.fileAttributes, "/py_attrs");
+
+        auto attributes      = fileAttributes;
+        attributes["layout"] = std::string{"aggregated"};
+        h5Writer_.writeAttributeDict(file, attributes, "/");
+    }
+
     template<typename ParticlePopulation>
     void writeIonPopAttributes_(HighFiveFile& file, ParticlePopulation const& pop)
     {
@@ -142,6 +258,52 @@ protected:
 
     Writer& h5Writer_;
     std::unordered_map<std::string, std::unique_ptr<HighFiveFile>> fileData_;
+
+
+private:
+    struct AggregatedDataSet
+    {
+        std::vector<double> data;
+        std::vector<std::size_t> offsets; //! one per patch
+        std::vector<std::size_t> shapes;  //! dimension values per patch
+        std::size_t ghosts = 0;
+    };
+
+    using AggregatedLevel = std::map<std::string, AggregatedDataSet>;
+
+
+    // processes may lack patches on a level, and so the datasets, which all have to create
+    static std::set<std::string> collectNames_(AggregatedLevel const& dataSets)
+    {
+        // names are sent as their lengths and concatenated characters, so that any character
+        // may appear in a name
+        std::vector<int> localLengths;
+        std::vector<char> localChars;
+        for (auto const& [name, _] : dataSets)
+        {
+            localLengths.push_back(static_cast<int>(name.size()));
+            localChars.insert(localChars.end(), name.begin(), name.end());
+        }
+
+        auto const rankLengths = core::mpi::collectVector(localLengths);
+        auto const rankChars   = core::mpi::collectVector(localChars);
+
+        std::set<std::string> names;
+        for (std::size_t rank = 0; rank < rankLengths.size(); ++rank)
+        {
+            auto start = rankChars[rank].begin();
+            for (auto const length : rankLengths[rank])
+            {
+                names.emplace(start, start + length);
+                start += length;
+            }
+        }
+        return names;
+    }
+
+
+    //! per diagnostic quantity, per level
+    std::unordered_map<std::string, std::map<std::size_t, AggregatedLevel>> aggregatedData_;
 };
 
 } // namespace PHARE::diagnostic::h5
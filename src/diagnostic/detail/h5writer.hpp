@@ -14,10 +14,7 @@
 #include "diagnostic/diagnostic_manager.hpp"
 #include "diagnostic/diagnostic_props.hpp"
 
-
-#if !defined(PHARE_DIAG_DOUBLES)
-#error // PHARE_DIAG_DOUBLES not defined
-#endif
+#include <stdexcept>
 
 
 namespace PHARE::diagnostic::h5
@@ -32,14 +29,16 @@ template<typename H5Writer>
 class ParticlesDiagnosticWriter;
 template<typename H5Writer>
 class MetaDiagnosticWriter;
+template<typename H5Writer>
+class DistributionDiagnosticWriter;
+template<typename H5Writer>
+class ReductionDiagnosticWriter;
 
 
 
 template<typename ModelView>
 class Writer
 {
-    using FloatType = std::conditional_t<PHARE_DIAG_DOUBLES, double, float>;
-
     static constexpr std::size_t timestamp_precision = 10;
 
 public:
@@ -101,23 +100,58 @@ public:
 
     auto makeFile(DiagnosticProperties const& diagnostic)
     {
-        return makeFile(fileString(diagnostic.quantity),
-                        file_flags[diagnostic.type + diagnostic.quantity]);
+        auto file = makeFile(fileString(diagnostic.quantity),
+                             file_flags[diagnostic.type + diagnostic.quantity]);
+        file->filters()   = filters(diagnostic);
+        file->precision() = precision(diagnostic);
+        return file;
+    }
+
+    // floating point data is written in single precision unless the diagnostic asks for double
+    static Precision precision(DiagnosticProperties const& diagnostic)
+    {
+        if (diagnostic.params.contains("precision")
+            and diagnostic.param<std::string>("precision") == "double")
+            return Precision::Double;
+        return Precision::Single;
+    }
+
+    static DataSetFilters filters(DiagnosticProperties const& diagnostic)
+    {
+        DataSetFilters filters;
+        if (!diagnostic.params.contains("chunk_size"))
+            return filters;
+
+        filters.chunkSize      = diagnostic.param<std::size_t>("chunk_size");
+        filters.shuffle        = diagnostic.param<std::size_t>("shuffle") > 0;
+        filters.deflate        = diagnostic.param<std::size_t>("deflate");
+        filters.quantizeDigits = diagnostic.param<std::size_t>("quantize_digits");
+
+        // filtered datasets need collective writes, per patch datasets are written by one rank
+        if (filters.enabled() and core::mpi::size() > 1
+            and diagnostic.param<std::string>("layout") != "aggregated")
+            throw std::runtime_error("diagnostic " + diagnostic.quantity
+                                     + ": compression with several MPI processes requires the "
+                                       "aggregated layout");
+        return filters;
     }
 
 
+    static std::string getFullLevelPath(std::string timestamp, int iLevel)
+    {
+        return "/t/" + timestamp + "/pl" + std::to_string(iLevel);
+    }
+
     static std::string getFullPatchPath(std::string timestamp, int iLevel, std::string globalCoords)
     {
-        return "/t/" + timestamp + "/pl" + std::to_string(iLevel) + "/p" + globalCoords;
+        return getFullLevelPath(timestamp, iLevel) + "/p" + globalCoords;
     }
 
+    // floating point datasets are stored in the precision of the file
     template<typename Type, typename Size>
     static void createDataSet(HighFiveFile& h5, std::string const& path, Size const& size)
     {
-        if constexpr (std::is_same_v<Type, double>) // force doubles for floats for storage
-            h5.create_data_set_per_mpi<FloatType>(path, size);
-        else
-            h5.create_data_set_per_mpi<Type>(path, size);
+        h5.create_data_set_per_mpi<Type>(path, size);
     }
 
 
@@ -158,6 +192,7 @@ private:
     double timestamp_ = 0;
     std::string filePath_;
     std::string patchPath_; // is passed around as "virtual write()" has no parameters
+    std::size_t patchLevel_ = 0;
     ModelView modelView_;
     Attributes fileAttributes_;
 
@@ -167,7 +202,9 @@ private:
         {"info", make_writer<MetaDiagnosticWriter<This>>()},
         {"fluid", make_writer<FluidDiagnosticWriter<This>>()},
         {"electromag", make_writer<ElectromagDiagnosticWriter<This>>()},
-        {"particle", make_writer<ParticlesDiagnosticWriter<This>>()} //
+        {"particle", make_writer<ParticlesDiagnosticWriter<This>>()},
+        {"distribution", make_writer<DistributionDiagnosticWriter<This>>()},
+        {"reduction", make_writer<ReductionDiagnosticWriter<This>>()} //
     };
 
     template<typename Writer>
@@ -192,6 +229,8 @@ private:
     friend class ElectromagDiagnosticWriter<This>;
     friend class ParticlesDiagnosticWriter<This>;
     friend class MetaDiagnosticWriter<This>;
+    friend class DistributionDiagnosticWriter<This>;
+    friend class ReductionDiagnosticWriter<This>;
     friend class H5TypeWriter<This>;
 
     // used by friends start
@@ -201,8 +240,15 @@ private:
                                 iLevel, globalCoords);
     }
 
+    std::string getLevelPathAddTimestamp(int iLevel)
+    {
+        return getFullLevelPath(core::to_string_with_precision(timestamp_, timestamp_precision),
+                                iLevel);
+    }
+
 
     auto& patchPath() const { return patchPath_; }
+    auto patchLevel() const { return patchLevel_; }
     // used by friends end
 };
 
@@ -305,7 +351,8 @@ void Writer<ModelView>::writeDatasets_(std::vector<DiagnosticProperties*> const&
     auto writePatch = [&](GridLayout& gridLayout, std::string patchID, std::size_t iLevel) {
         if (!patchAttributes.count(iLevel))
             patchAttributes.emplace(iLevel, std::vector<std::pair<std::string, Attributes>>{});
-        patchPath_ = getPatchPathAddTimestamp(iLevel, patchID);
+        patchPath_  = getPatchPathAddTimestamp(iLevel, patchID);
+        patchLevel_ = iLevel;
         patchAttributes[iLevel].emplace_back(patchID,
                                              modelView_.getPatchProperties(patchID, gridLayout));
         for (auto* diagnostic : diagnostics)
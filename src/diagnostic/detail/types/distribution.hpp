@@ -0,0 +1,228 @@
+#ifndef PHARE_DIAGNOSTIC_DETAIL_TYPES_DISTRIBUTION_HPP
+#define PHARE_DIAGNOSTIC_DETAIL_TYPES_DISTRIBUTION_HPP
+
+#include "diagnostic/detail/h5typewriter.hpp"
+
+#include "core/data/particles/velocity_histogram.hpp"
+#include "core/utilities/mpi_utils.hpp"
+
+#include <algorithm>
+#include <array>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace PHARE::diagnostic::h5
+{
+/*
+ * Possible outputs
+ *
+ * /t#/histogram     (box, vx, vy, vz), one per compute timestamp
+ *
+ * with the edges of the velocity bins as root attributes (edges_vx, edges_vy, edges_vz), as well
+ * as the boxes and the level of the particles binned.
+ *
+ * The domain particles of the population are binned by a core::VelocityHistogram during compute(),
+ * on the patches of the requested level only. Level 0 covering the whole domain, the default
+ * level gives the distribution of all the particles in the boxes. Histograms are summed over all
+ * processes and are kept until the next write timestamp, they are then all written by the first
+ * process. Compute timestamps past the last write timestamp are rejected by pyphare, as their
+ * histograms would never be written. Nothing is written per patch.
+ */
+template<typename H5Writer>
+class DistributionDiagnosticWriter : public H5TypeWriter<H5Writer>
+{
+public:
+    using Super = H5TypeWriter<H5Writer>;
+    using Super::checkCreateFileFor_;
+    using Super::fileData_;
+    using Super::h5Writer_;
+    static constexpr auto dimension = H5Writer::dimension;
+    using Attributes                = typename Super::Attributes;
+    using GridLayout                = typename H5Writer::GridLayout;
+    using Histogram                 = core::VelocityHistogram<dimension>;
+
+    DistributionDiagnosticWriter(H5Writer& h5Writer)
+        : Super{h5Writer}
+    {
+    }
+
+    void write(DiagnosticProperties&) override {}
+
+    void compute(DiagnosticProperties&, double timeStamp) override;
+
+    void createFiles(DiagnosticProperties& diagnostic) override;
+
+    void getDataSetInfo(DiagnosticProperties&, std::size_t /*iLevel*/,
+                        std::string const& /*patchID*/, Attributes&) override
+    {
+    }
+
+    void initDataSets(DiagnosticProperties&,
+                      std::unordered_map<std::size_t, std::vector<std::string>> const&,
+                      Attributes&, std::size_t /*maxLevel*/) override
+    {
+    }
+
+    void writeAttributes(
+        DiagnosticProperties&, Attributes&,
+        std::unordered_map<std::size_t, std::vector<std::pair<std::string, Attributes>>>&,
+        std::size_t maxLevel) override;
+
+
+private:
+    struct Distribution
+    {
+        std::string population;
+        std::size_t level = 0;
+        std::unique_ptr<Histogram> histogram;
+
+        //! computed but not yet written histograms, with their compute timestamp
+        std::vector<std::pair<double, std::vector<double>>> pending;
+    };
+
+    Distribution& distribution_(DiagnosticProperties const& diagnostic);
+
+    //! per diagnostic quantity
+    std::unordered_map<std::string, Distribution> distributions_;
+};
+
+
+
+template<typename H5Writer>
+void DistributionDiagnosticWriter<H5Writer>::createFiles(DiagnosticProperties& diagnostic)
+{
+    for (auto const& pop : this->h5Writer_.modelView().getIons())
+    {
+        std::string tree{"/ions/pop/" + pop.name() + "/"};
+        checkCreateFileFor_(diagnostic, fileData_, tree, "distribution");
+    }
+}
+
+
+
+template<typename H5Writer>
+void DistributionDiagnosticWriter<H5Writer>::compute(DiagnosticProperties& diagnostic,
+                                                     double timeStamp)
+{
+    auto& distribution = distribution_(diagnostic);
+    auto& histogram    = *distribution.histogram;
+    auto& modelView    = h5Writer_.modelView();
+
+    histogram.reset();
+
+    auto binPatch = [&](GridLayout& gridLayout, std::string const&, std::size_t iLevel) {
+        for (auto const& pop : modelView.getIons())
+            if (pop.name() == distribution.population)
+                histogram.accumulate(pop.domainParticles(), gridLayout.AMRBox(), iLevel);
+    };
+    modelView.visitHierarchy(binPatch, distribution.level, distribution.level);
+
+    // only the first process writes the histograms
+    auto counts = histogram.counts();
+    core::mpi::sumOnRoot(counts);
+    distribution.pending.emplace_back(timeStamp, std::move(counts));
+}
+
+
+
+template<typename H5Writer>
+void DistributionDiagnosticWriter<H5Writer>::writeAttributes(
+    DiagnosticProperties& diagnostic, Attributes& fileAttributes,
+    std::unordered_map<std::size_t, std::vector<std::pair<std::string, Attributes>>>&,
+    std::size_t /*maxLevel*/)
+{
+    if (!fileData_.count(diagnostic.quantity))
+        return;
+
+    auto& h5file       = *fileData_.at(diagnostic.quantity);
+    auto& distribution = distribution_(diagnostic);
+    auto& histogram    = *distribution.histogram;
+    bool const writer  = core::mpi::rank() == 0;
+
+    for (auto const& [time, counts] : distribution.pending)
+    {
+        auto const path
+            = "/t/" + core::to_string_with_precision(time, H5Writer::timestamp_precision)
+              + "/histogram";
+
+        // datasets are created by all processes, as required by parallel HDF5
+        h5file.template create_data_set<double>(path, histogram.shape());
+        if (writer)
+            h5file.write_data_set_raw(path, counts.data());
+    }
+    distribution.pending.clear();
+
+    if (diagnostic.nAttributes > 0)
+        h5Writer_.writeAttributeDict(h5file, diagnostic.fileAttributes, "/py_attrs");
+
+    auto attributes = fileAttributes;
+    std::array<std::string, 3> const components{"vx", "vy", "vz"};
+    for (std::size_t iComp = 0; iComp < components.size(); ++iComp)
+        attributes["edges_" + components[iComp]] = histogram.edges(iComp);
+    attributes["boxes"] = diagnostic.param<std::vector<int>>("boxes");
+    attributes["level"] = distribution.level;
+    h5Writer_.writeAttributeDict(h5file, attributes, "/");
+}
+
+
+
+template<typename H5Writer>
+auto DistributionDiagnosticWriter<H5Writer>::distribution_(DiagnosticProperties const& diagnostic)
+    -> Distribution&
+{
+    if (auto it = distributions_.find(diagnostic.quantity); it != distributions_.end())
+        return it->second;
+
+    auto& params = diagnostic.params;
+    for (std::string key : {"boxes", "bins", "v_min", "v_max"})
+        if (!params.contains(key))
+            throw std::runtime_error("distribution diagnostic " + diagnostic.quantity
+                                     + ": missing parameter " + key);
+
+    // lower and upper cells of each box, one after the other
+    std::vector<core::Box<int, dimension>> boxes;
+    auto const& bounds = diagnostic.param<std::vector<int>>("boxes");
+    for (std::size_t i = 0; i + 2 * dimension <= bounds.size(); i += 2 * dimension)
+    {
+        auto& box = boxes.emplace_back();
+        for (std::size_t iDim = 0; iDim < dimension; ++iDim)
+        {
+            box.lower[iDim] = bounds[i + iDim];
+            box.upper[iDim] = bounds[i + dimension + iDim];
+        }
+    }
+
+    auto const& bins = diagnostic.param<std::vector<int>>("bins");
+    auto const& vMin = diagnostic.param<std::vector<double>>("v_min");
+    auto const& vMax = diagnostic.param<std::vector<double>>("v_max");
+    if (bins.size() != 3 or vMin.size() != 3 or vMax.size() != 3)
+        throw std::runtime_error("distribution diagnostic " + diagnostic.quantity
+                                 + ": bins, v_min and v_max need 3 components");
+
+    std::array<std::size_t, 3> nbrBins;
+    std::array<double, 3> lower, upper;
+    for (std::size_t iComp = 0; iComp < 3; ++iComp)
+    {
+        nbrBins[iComp] = static_cast<std::size_t>(std::max(bins[iComp], 0));
+        lower[iComp]   = vMin[iComp];
+        upper[iComp]   = vMax[iComp];
+    }
+
+    // quantity is /ions/pop/<population>/distribution
+    std::string const popTree{"/ions/pop/"};
+    auto const popEnd = diagnostic.quantity.rfind('/');
+
+    auto& distribution      = distributions_[diagnostic.quantity];
+    distribution.population = diagnostic.quantity.substr(popTree.size(), popEnd - popTree.size());
+    distribution.level = params.contains("level") ? diagnostic.param<std::size_t>("level") : 0;
+    distribution.histogram = std::make_unique<Histogram>(std::move(boxes), nbrBins, lower, upper);
+    return distribution;
+}
+
+} // namespace PHARE::diagnostic::h5
+
+#endif
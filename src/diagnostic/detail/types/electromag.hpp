@@ -11,6 +11,10 @@ namespace PHARE::diagnostic::h5
  * Possible outputs
  *
  * /t#/pl#/p#/electromag_(B, E)/(x,y,z)
+ *
+ * or, with the "aggregated" layout (see H5TypeWriter::aggregated_)
+ *
+ * /t#/pl#/electromag_(B, E)/(x,y,z)
  */
 template<typename H5Writer>
 class ElectromagDiagnosticWriter : public H5TypeWriter<H5Writer>
@@ -25,14 +29,13 @@ public:
     using Super::writeGhostsAttr_;
     using Attributes = typename Super::Attributes;
     using GridLayout = typename H5Writer::GridLayout;
-    using FloatType  = typename H5Writer::FloatType;
 
     ElectromagDiagnosticWriter(H5Writer& h5Writer)
         : Super{h5Writer}
     {
     }
     void write(DiagnosticProperties&) override;
-    void compute(DiagnosticProperties&) override {}
+    void compute(DiagnosticProperties&, double) override {}
 
     void createFiles(DiagnosticProperties& diagnostic) override;
 
@@ -99,6 +102,9 @@ void ElectromagDiagnosticWriter<H5Writer>::initDataSets(
     std::unordered_map<std::size_t, std::vector<std::string>> const& patchIDs,
     Attributes& patchAttributes, std::size_t maxLevel)
 {
+    if (this->aggregated_(diagnostic)) // level datasets are created once patches are written
+        return;
+
     auto& h5Writer = this->h5Writer_;
     auto& h5file   = *fileData_.at(diagnostic.quantity);
     auto vecFields = h5Writer.modelView().getElectromagFields();
@@ -107,7 +113,7 @@ void ElectromagDiagnosticWriter<H5Writer>::initDataSets(
         for (auto& [id, type] : core::Components::componentMap)
         {
             auto vFPath = path + "/" + key + "_" + id;
-            h5Writer.template createDataSet<FloatType>(
+            h5Writer.template createDataSet<double>(
                 h5file, vFPath,
                 null ? std::vector<std::size_t>(GridLayout::dimension, 0)
                      : attr[key][id].template to<std::vector<std::size_t>>());
@@ -151,9 +157,14 @@ void ElectromagDiagnosticWriter<H5Writer>::write(DiagnosticProperties& diagnosti
 
     for (auto* vecField : h5Writer.modelView().getElectromagFields())
         if (diagnostic.quantity == "/" + vecField->name())
-            h5Writer.writeVecFieldAsDataset(*fileData_.at(diagnostic.quantity),
-                                            h5Writer.patchPath() + "/" + vecField->name(),
-                                            *vecField);
+        {
+            if (this->aggregated_(diagnostic))
+                this->aggregateVecField_(diagnostic, vecField->name(), *vecField);
+            else
+                h5Writer.writeVecFieldAsDataset(*fileData_.at(diagnostic.quantity),
+                                                h5Writer.patchPath() + "/" + vecField->name(),
+                                                *vecField);
+        }
 }
 
 
@@ -165,8 +176,12 @@ void ElectromagDiagnosticWriter<H5Writer>::writeAttributes(
         patchAttributes,
     std::size_t maxLevel)
 {
-    writeAttributes_(diagnostic, *fileData_.at(diagnostic.quantity), fileAttributes,
-                     patchAttributes, maxLevel);
+    if (this->aggregated_(diagnostic))
+        this->writeAggregated_(diagnostic, *fileData_.at(diagnostic.quantity), fileAttributes,
+                               patchAttributes, maxLevel);
+    else
+        writeAttributes_(diagnostic, *fileData_.at(diagnostic.quantity), fileAttributes,
+                         patchAttributes, maxLevel);
 }
 
 
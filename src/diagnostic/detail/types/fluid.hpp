@@ -16,6 +16,8 @@ namespace PHARE::diagnostic::h5
  * /t#/pl#/p#/ions/bulkVelocity/(x,y,z)
  * /t#/pl#/p#/ions/pop_(1,2,...)/density
  * /t#/pl#/p#/ions/pop_(1,2,...)/bulkVelocity/(x,y,z)
+ *
+ * or, with the "aggregated" layout (see H5TypeWriter::aggregated_), the same without /p#
  */
 template<typename H5Writer>
 class FluidDiagnosticWriter : public H5TypeWriter<H5Writer>
@@ -31,14 +33,13 @@ public:
     using Super::writeIonPopAttributes_;
     using Attributes = typename Super::Attributes;
     using GridLayout = typename H5Writer::GridLayout;
-    using FloatType  = typename H5Writer::FloatType;
 
     FluidDiagnosticWriter(H5Writer& h5Writer)
         : Super{h5Writer}
     {
     }
     void write(DiagnosticProperties&) override;
-    void compute(DiagnosticProperties&) override {}
+    void compute(DiagnosticProperties&, double) override {}
 
     void createFiles(DiagnosticProperties& diagnostic) override;
 
@@ -126,6 +127,9 @@ void FluidDiagnosticWriter<H5Writer>::initDataSets(
     std::unordered_map<std::size_t, std::vector<std::string>> const& patchIDs,
     Attributes& patchAttributes, std::size_t maxLevel)
 {
+    if (this->aggregated_(diagnostic)) // level datasets are created once patches are written
+        return;
+
     auto& h5Writer = this->h5Writer_;
     auto& ions     = h5Writer.modelView().getIons();
     auto& h5file   = *fileData_.at(diagnostic.quantity);
@@ -145,7 +149,7 @@ void FluidDiagnosticWriter<H5Writer>::initDataSets(
 
     auto initDS = [&](auto& path, auto& attr, std::string key, auto null) {
         auto dsPath = path + key;
-        h5Writer.template createDataSet<FloatType>(
+        h5Writer.template createDataSet<double>(
             h5file, dsPath,
             null ? std::vector<std::size_t>(GridLayout::dimension, 0)
                  : attr[key].template to<std::vector<std::size_t>>());
@@ -189,29 +193,39 @@ void FluidDiagnosticWriter<H5Writer>::write(DiagnosticProperties& diagnostic)
     auto& ions     = h5Writer.modelView().getIons();
     auto& h5file   = *fileData_.at(diagnostic.quantity);
 
+    bool const aggregated = this->aggregated_(diagnostic);
+    std::string path      = h5Writer.patchPath() + "/";
+
     auto checkActive = [&](auto& tree, auto var) { return diagnostic.quantity == tree + var; };
-    auto writeDS     = [&](auto path, auto& field) {
-        h5file.template write_data_set_flat<GridLayout::dimension>(path, &(*field.begin()));
+    auto writeDS     = [&](auto name, auto& field) {
+        if (aggregated)
+            this->aggregate_(diagnostic, name, field);
+        else
+            h5file.template write_data_set_flat<GridLayout::dimension>(path + name,
+                                                                       &(*field.begin()));
+    };
+    auto writeVF = [&](auto name, auto& vecF) {
+        if (aggregated)
+            this->aggregateVecField_(diagnostic, name, vecF);
+        else
+            h5Writer.writeVecFieldAsDataset(h5file, path + name, vecF);
     };
-    auto writeVF
-        = [&](auto path, auto& vecF) { h5Writer.writeVecFieldAsDataset(h5file, path, vecF); };
 
-    std::string path = h5Writer.patchPath() + "/";
     for (auto& pop : ions)
     {
         std::string tree{"/ions/pop/" + pop.name() + "/"};
         if (checkActive(tree, "density"))
-            writeDS(path + "density", pop.density());
+            writeDS("density", pop.density());
         if (checkActive(tree, "flux"))
-            writeVF(path + "flux", pop.flux());
+            writeVF("flux", pop.flux());
     }
 
     std::string tree{"/ions/"};
     auto& density = ions.density();
     if (checkActive(tree, "density"))
-        writeDS(path + "density", density);
+        writeDS("density", density);
     if (checkActive(tree, "bulkVelocity"))
-        writeVF(path + "bulkVelocity", ions.velocity());
+        writeVF("bulkVelocity", ions.velocity());
 }
 
 
@@ -237,7 +251,10 @@ void FluidDiagnosticWriter<H5Writer>::writeAttributes(
         checkWrite(tree, "flux", pop);
     }
 
-    writeAttributes_(diagnostic, h5file, fileAttributes, patchAttributes, maxLevel);
+    if (this->aggregated_(diagnostic))
+        this->writeAggregated_(diagnostic, h5file, fileAttributes, patchAttributes, maxLevel);
+    else
+        writeAttributes_(diagnostic, h5file, fileAttributes, patchAttributes, maxLevel);
 }
 
 } // namespace PHARE::diagnostic::h5
@@ -23,7 +23,6 @@ public:
     using Super::writeAttributes_;
     using Attributes = typename Super::Attributes;
     using GridLayout = typename H5Writer::GridLayout;
-    using FloatType  = typename H5Writer::FloatType;
 
     MetaDiagnosticWriter(H5Writer& h5Writer)
         : Super{h5Writer}
@@ -32,7 +31,7 @@ public:
 
     void write(DiagnosticProperties&) override;
 
-    void compute(DiagnosticProperties&) override {}
+    void compute(DiagnosticProperties&, double) override {}
 
     void createFiles(DiagnosticProperties& diagnostic) override;
 
@@ -4,11 +4,16 @@
 #include "diagnostic/detail/h5typewriter.hpp"
 
 #include "core/data/particles/particle_packer.hpp"
+#include "core/data/particles/particle_selector.hpp"
 
 #include "amr/data/particles/particles_data.hpp"
 
 #include "hdf5/writer/particle_writer.hpp"
 
+#include <algorithm>
+#include <array>
+#include <iterator>
+#include <map>
 #include <unordered_map>
 #include <string>
 #include <memory>
@@ -23,6 +28,11 @@ namespace PHARE::diagnostic::h5
  * /t#/pl#/p#/ions/pop_(1,2,...)/domain/(weight, charge, iCell, delta, v)
  * /t#/pl#/p#/ions/pop_(1,2,...)/levelGhost/(weight, charge, iCell, delta, v)
  * /t#/pl#/p#/ions/pop_(1,2,...)/patchGhost/(weight, charge, iCell, delta, v)
+ *
+ * or, with the "aggregated" layout (see H5TypeWriter::aggregated_), the same without /p#
+ *
+ * Particles written can be restricted with a core::ParticleSelector, built from the "stride",
+ * "fraction", "boxes", "v_min" and "v_max" diagnostic parameters
  */
 template<typename H5Writer>
 class ParticlesDiagnosticWriter : public H5TypeWriter<H5Writer>
@@ -40,14 +50,13 @@ public:
     static constexpr auto interpOrder = H5Writer::interpOrder;
     using Attributes                  = typename Super::Attributes;
     using Packer                      = core::ParticlePacker<dimension>;
-    using FloatType                   = typename H5Writer::FloatType;
 
     ParticlesDiagnosticWriter(H5Writer& h5Writer)
         : Super{h5Writer}
     {
     }
     void write(DiagnosticProperties&) override;
-    void compute(DiagnosticProperties&) override {}
+    void compute(DiagnosticProperties&, double) override {}
 
     void createFiles(DiagnosticProperties& diagnostic) override;
 
@@ -62,6 +71,38 @@ public:
         DiagnosticProperties&, Attributes&,
         std::unordered_map<std::size_t, std::vector<std::pair<std::string, Attributes>>>&,
         std::size_t maxLevel) override;
+
+private:
+    struct AggregatedParticles
+    {
+        core::ContiguousParticles<dimension> particles{0};
+        std::vector<std::size_t> offsets; //! first particle of each patch
+    };
+
+    template<typename Particles>
+    void aggregateParticles_(DiagnosticProperties const& diagnostic, Particles const& particles,
+                             std::vector<std::size_t> const* selection);
+
+    core::ParticleSelector<dimension> const& selector_(DiagnosticProperties const& diagnostic);
+
+    //! the selection of the particles of the patch at the given path, null if all are written
+    std::vector<std::size_t> const* selection_(DiagnosticProperties const& diagnostic,
+                                               std::string const& patchPath) const;
+
+    void writeAggregatedParticles_(
+        DiagnosticProperties&, HighFiveFile&, Attributes&,
+        std::unordered_map<std::size_t, std::vector<std::pair<std::string, Attributes>>>&,
+        std::size_t maxLevel);
+
+    //! per diagnostic quantity, per level
+    std::unordered_map<std::string, std::map<std::size_t, AggregatedParticles>>
+        aggregatedParticles_;
+
+    //! per diagnostic quantity
+    std::unordered_map<std::string, core::ParticleSelector<dimension>> selectors_;
+
+    //! selected particles of the patches of the current dump, per diagnostic quantity + patch path
+    std::unordered_map<std::string, std::vector<std::size_t>> selections_;
 };
 
 
@@ -81,20 +122,31 @@ void ParticlesDiagnosticWriter<H5Writer>::getDataSetInfo(DiagnosticProperties& d
                                                          std::string const& patchID,
                                                          Attributes& patchAttributes)
 {
+    auto& h5Writer = this->h5Writer_;
+    auto& selector = selector_(diagnostic);
+    auto patchPath = h5Writer.getPatchPathAddTimestamp(iLevel, patchID);
+
     auto checkInfo = [&](auto& tree, auto pType, auto& attr, auto& ps) {
         std::string active{tree + pType};
         if (diagnostic.quantity == active)
         {
+            auto nbrParticles = ps.size();
+            if (!selector.selectsAll())
+            {
+                auto& selection = selections_[diagnostic.quantity + patchPath];
+                selection       = selector.select(ps, iLevel);
+                nbrParticles    = selection.size();
+            }
+
             std::size_t part_idx = 0;
             core::apply(Packer::empty(), [&](auto const& arg) {
                 attr[pType][Packer::keys()[part_idx++]]
-                    = hdf5::ParticleWriter::size_for<dimension>(arg, ps.size());
+                    = hdf5::ParticleWriter::size_for<dimension>(arg, nbrParticles);
             });
         }
     };
 
 
-    auto& h5Writer         = this->h5Writer_;
     std::string lvlPatchID = std::to_string(iLevel) + "_" + patchID;
     for (auto& pop : h5Writer.modelView().getIons())
     {
@@ -113,6 +165,9 @@ void ParticlesDiagnosticWriter<H5Writer>::initDataSets(
     std::unordered_map<std::size_t, std::vector<std::string>> const& patchIDs,
     Attributes& patchAttributes, std::size_t maxLevel)
 {
+    if (this->aggregated_(diagnostic)) // level datasets are created once patches are written
+        return;
+
     auto& h5Writer = this->h5Writer_;
     auto& h5file   = *fileData_.at(diagnostic.quantity);
 
@@ -170,9 +225,17 @@ void ParticlesDiagnosticWriter<H5Writer>::write(DiagnosticProperties& diagnostic
 
     auto checkWrite = [&](auto& tree, auto pType, auto& ps) {
         std::string active{tree + pType};
-        if (diagnostic.quantity == active && ps.size() > 0)
+        if (diagnostic.quantity != active)
+            return;
+
+        auto const* selection = selection_(diagnostic, h5Writer.patchPath());
+        auto const size       = selection ? selection->size() : ps.size();
+
+        if (this->aggregated_(diagnostic))
+            aggregateParticles_(diagnostic, ps, selection);
+        else if (size > 0)
             hdf5::ParticleWriter::write(*fileData_.at(diagnostic.quantity), ps,
-                                        h5Writer.patchPath() + "/");
+                                        h5Writer.patchPath() + "/", selection);
     };
 
     for (auto& pop : h5Writer.modelView().getIons())
@@ -208,7 +271,143 @@ void ParticlesDiagnosticWriter<H5Writer>::writeAttributes(
         checkWrite(tree, "patchGhost", pop);
     }
 
-    writeAttributes_(diagnostic, h5file, fileAttributes, patchAttributes, maxLevel);
+    if (this->aggregated_(diagnostic))
+        writeAggregatedParticles_(diagnostic, h5file, fileAttributes, patchAttributes, maxLevel);
+    else
+        writeAttributes_(diagnostic, h5file, fileAttributes, patchAttributes, maxLevel);
+
+    for (auto it = selections_.begin(); it != selections_.end();)
+        it = it->first.rfind(diagnostic.quantity, 0) == 0 ? selections_.erase(it) : std::next(it);
+}
+
+
+
+template<typename H5Writer>
+core::ParticleSelector<ParticlesDiagnosticWriter<H5Writer>::dimension> const&
+ParticlesDiagnosticWriter<H5Writer>::selector_(DiagnosticProperties const& diagnostic)
+{
+    if (auto it = selectors_.find(diagnostic.quantity); it != selectors_.end())
+        return it->second;
+
+    auto& selector = selectors_[diagnostic.quantity];
+    auto& params   = diagnostic.params;
+
+    if (params.contains("stride"))
+        selector.stride = std::max(std::size_t{1}, diagnostic.param<std::size_t>("stride"));
+    if (params.contains("fraction"))
+        selector.fraction = diagnostic.param<double>("fraction");
+    if (params.contains("boxes"))
+    {
+        // lower and upper cells of each box, one after the other
+        auto const& bounds = diagnostic.param<std::vector<int>>("boxes");
+        for (std::size_t i = 0; i + 2 * dimension <= bounds.size(); i += 2 * dimension)
+        {
+            auto& box = selector.boxes.emplace_back();
+            for (std::size_t iDim = 0; iDim < dimension; ++iDim)
+            {
+                box.lower[iDim] = bounds[i + iDim];
+                box.upper[iDim] = bounds[i + dimension + iDim];
+            }
+        }
+    }
+    auto setVelocityBound = [&](std::string const& key, auto& bound) {
+        if (params.contains(key))
+        {
+            auto const& values = diagnostic.param<std::vector<double>>(key);
+            std::copy_n(std::begin(values), std::min(values.size(), bound.size()),
+                        std::begin(bound));
+        }
+    };
+    setVelocityBound("v_min", selector.vMin);
+    setVelocityBound("v_max", selector.vMax);
+
+    return selector;
+}
+
+
+
+template<typename H5Writer>
+std::vector<std::size_t> const*
+ParticlesDiagnosticWriter<H5Writer>::selection_(DiagnosticProperties const& diagnostic,
+                                                std::string const& patchPath) const
+{
+    auto it = selections_.find(diagnostic.quantity + patchPath);
+    return it == selections_.end() ? nullptr : &it->second;
+}
+
+
+
+template<typename H5Writer>
+template<typename Particles>
+void ParticlesDiagnosticWriter<H5Writer>::aggregateParticles_(
+    DiagnosticProperties const& diagnostic, Particles const& particles,
+    std::vector<std::size_t> const* selection)
+{
+    auto& level = aggregatedParticles_[diagnostic.quantity][h5Writer_.patchLevel()];
+    auto& copy  = level.particles;
+
+    auto const start = copy.size();
+    level.offsets.push_back(start);
+
+    auto packer     = selection ? Packer{particles, *selection} : Packer{particles};
+    auto const size = start + packer.size();
+    copy.weight.resize(size);
+    copy.charge.resize(size);
+    copy.iCell.resize(size * dimension);
+    copy.delta.resize(size * dimension);
+    copy.v.resize(size * 3);
+
+    packer.pack(copy, start);
+}
+
+
+
+template<typename H5Writer>
+void ParticlesDiagnosticWriter<H5Writer>::writeAggregatedParticles_(
+    DiagnosticProperties& diagnostic, HighFiveFile& h5file, Attributes& fileAttributes,
+    std::unordered_map<std::size_t, std::vector<std::pair<std::string, Attributes>>>&
+        patchAttributes,
+    std::size_t maxLevel)
+{
+    auto& levels = aggregatedParticles_[diagnostic.quantity];
+
+    // values per particle, in the order of Packer::keys()
+    std::array<std::size_t, 5> const rowSizes{1, 1, dimension, dimension, 3};
+    auto const ghosts = static_cast<std::size_t>(core::ghostWidthForParticles<interpOrder>());
+
+    for (std::size_t lvl = h5Writer_.minLevel; lvl <= maxLevel; lvl++)
+    {
+        auto const levelPath = h5Writer_.getLevelPathAddTimestamp(lvl);
+        this->writePatchTable_(h5file, levelPath, patchAttributes.at(lvl));
+
+        auto& level        = levels[lvl];
+        auto const nbrRows = level.particles.size();
+
+        std::size_t part_idx = 0;
+        core::apply(level.particles.as_tuple(), [&](auto const& values) {
+            auto const& key     = Packer::keys()[part_idx];
+            auto const rowSize  = rowSizes[part_idx++];
+            auto const dataPath = levelPath + "/" + key;
+            auto const firstRow = h5file.write_data_set_concatenated(dataPath, values, rowSize);
+            h5file.write_data_set_attribute(dataPath, "ghosts", ghosts);
+
+            std::vector<std::size_t> offsets, shapes;
+            for (std::size_t iPatch = 0; iPatch < level.offsets.size(); ++iPatch)
+            {
+                auto const end = iPatch + 1 < level.offsets.size() ? level.offsets[iPatch + 1]
+                                                                    : nbrRows;
+                offsets.push_back(firstRow + level.offsets[iPatch]);
+                shapes.push_back(end - level.offsets[iPatch]);
+                shapes.push_back(rowSize);
+            }
+            h5file.write_data_set_concatenated(levelPath + "/patches/" + key + "_offset", offsets);
+            h5file.write_data_set_concatenated(levelPath + "/patches/" + key + "_shape", shapes,
+                                               2);
+        });
+    }
+    aggregatedParticles_.erase(diagnostic.quantity);
+
+    this->writeAggregatedFileAttributes_(diagnostic, h5file, fileAttributes);
 }
 
 
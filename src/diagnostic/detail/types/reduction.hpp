@@ -0,0 +1,384 @@
+#ifndef PHARE_DIAGNOSTIC_DETAIL_TYPES_REDUCTION_HPP
+#define PHARE_DIAGNOSTIC_DETAIL_TYPES_REDUCTION_HPP
+
+#include "diagnostic/detail/h5typewriter.hpp"
+
+#include "core/data/vecfield/vecfield_component.hpp"
+#include "core/numerics/reduction/global_field.hpp"
+#include "core/numerics/reduction/profile.hpp"
+#include "core/utilities/mpi_utils.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace PHARE::diagnostic::h5
+{
+/*
+ * Possible outputs, one set per compute timestamp
+ *
+ * /energy:   /t#/(magnetic, electric, kinetic_<pop>)
+ * /profile:  /t#/box#/(EM_B_x, EM_B_y, EM_B_z, EM_E_x, EM_E_y, EM_E_z)
+ * /spectrum: /t#/(EM_B_x, EM_B_y, EM_B_z, EM_E_x, EM_E_y, EM_E_z)
+ *
+ * Reductions are computed from level 0, which covers the whole domain and holds the coarsened data
+ * of the finer levels once they are synchronized.
+ *  - energies are sums over the domain of B^2/2, E^2/2 and, for each population, of m w v^2/2 over
+ *    its particles, times the cell volume. The electric energy thus misses the (V_A/c)^2 factor of
+ *    the normalized units.
+ *  - profiles are the field components in each of the "boxes" (level 0 cell indexes), along
+ *    "axis", averaged over the other directions
+ *  - spectra are power spectra (see core::powerSpectrum) of the field components along "axis",
+ *    averaged over the other directions. Wavenumbers are a root attribute.
+ *
+ * Profiles are summed per slice on each process, only these sums are reduced into the first
+ * process. Spectra need whole lines of the domain, the first process gathers the cells of all the
+ * patches, one component at a time, and computes them.
+ * Results are kept until the next write timestamp, they are then all written by the first
+ * process. Nothing is written per patch.
+ */
+template<typename H5Writer>
+class ReductionDiagnosticWriter : public H5TypeWriter<H5Writer>
+{
+public:
+    using Super = H5TypeWriter<H5Writer>;
+    using Super::checkCreateFileFor_;
+    using Super::fileData_;
+    using Super::h5Writer_;
+    static constexpr auto dimension = H5Writer::dimension;
+    using Attributes                = typename Super::Attributes;
+    using GridLayout                = typename H5Writer::GridLayout;
+    using GlobalField               = core::GlobalField<dimension>;
+
+    ReductionDiagnosticWriter(H5Writer& h5Writer)
+        : Super{h5Writer}
+    {
+    }
+
+    void write(DiagnosticProperties&) override {}
+
+    void compute(DiagnosticProperties&, double timeStamp) override;
+
+    void createFiles(DiagnosticProperties& diagnostic) override;
+
+    void getDataSetInfo(DiagnosticProperties&, std::size_t /*iLevel*/,
+                        std::string const& /*patchID*/, Attributes&) override
+    {
+    }
+
+    void initDataSets(DiagnosticProperties&,
+                      std::unordered_map<std::size_t, std::vector<std::string>> const&,
+                      Attributes&, std::size_t /*maxLevel*/) override
+    {
+    }
+
+    void writeAttributes(
+        DiagnosticProperties&, Attributes&,
+        std::unordered_map<std::size_t, std::vector<std::pair<std::string, Attributes>>>&,
+        std::size_t maxLevel) override;
+
+
+private:
+    //! results of one compute timestamp, per dataset name
+    using Results = std::map<std::string, std::vector<double>>;
+
+    Results energies_();
+    Results fieldReductions_(DiagnosticProperties const& diagnostic);
+
+    //! spectrum along axis of the patch cells gathered by fieldReductions_
+    std::vector<double> spectrum_(std::vector<double> const& cells,
+                                  std::array<std::size_t, dimension> const& shape,
+                                  std::size_t axis);
+
+    double cellVolume_();
+    std::size_t axis_(DiagnosticProperties const& diagnostic);
+    std::vector<core::Box<int, dimension>> boxes_(DiagnosticProperties const& diagnostic);
+
+    //! computed but not yet written results with their compute timestamp, per diagnostic quantity
+    std::unordered_map<std::string, std::vector<std::pair<double, Results>>> pending_;
+};
+
+
+
+template<typename H5Writer>
+void ReductionDiagnosticWriter<H5Writer>::createFiles(DiagnosticProperties& diagnostic)
+{
+    checkCreateFileFor_(diagnostic, fileData_, "/", "energy", "profile", "spectrum");
+}
+
+
+
+template<typename H5Writer>
+void ReductionDiagnosticWriter<H5Writer>::compute(DiagnosticProperties& diagnostic,
+                                                  double timeStamp)
+{
+    if (diagnostic.quantity == "/energy")
+        pending_[diagnostic.quantity].emplace_back(timeStamp, energies_());
+    else if (diagnostic.quantity == "/profile" or diagnostic.quantity == "/spectrum")
+        pending_[diagnostic.quantity].emplace_back(timeStamp, fieldReductions_(diagnostic));
+    else
+        throw std::runtime_error("reduction diagnostic: unknown quantity " + diagnostic.quantity);
+}
+
+
+
+template<typename H5Writer>
+auto ReductionDiagnosticWriter<H5Writer>::energies_() -> Results
+{
+    auto& modelView = h5Writer_.modelView();
+    auto& ions      = modelView.getIons();
+
+    // magnetic, electric, then one per population
+    std::vector<double> sums(2 + ions.nbrPopulations(), 0.);
+
+    auto sumPatch = [&](GridLayout& gridLayout, std::string const&, std::size_t) {
+        std::size_t iSum = 0;
+        for (auto* vecField : modelView.getElectromagFields())
+        {
+            for (auto& [id, type] : core::Components::componentMap)
+            {
+                auto& field = vecField->getComponent(type);
+                for (auto const& cell : gridLayout.AMRBox())
+                {
+                    auto const value = field(gridLayout.AMRToLocal(cell).toArray());
+                    sums[iSum] += value * value;
+                }
+            }
+            ++iSum;
+        }
+
+        for (auto const& pop : ions)
+        {
+            double sum = 0;
+            for (auto const& particle : pop.domainParticles())
+                for (auto const& v : particle.v)
+                    sum += particle.weight * v * v;
+            sums[iSum++] += pop.mass() * sum;
+        }
+    };
+    modelView.visitHierarchy(sumPatch, 0, 0);
+
+    // only the first process writes the energies
+    core::mpi::sumOnRoot(sums);
+    auto const factor = 0.5 * cellVolume_();
+
+    Results results;
+    results["magnetic"] = {factor * sums[0]};
+    results["electric"] = {factor * sums[1]};
+    std::size_t iSum    = 2;
+    for (auto const& pop : ions)
+        results["kinetic_" + pop.name()] = {factor * sums[iSum++]};
+    return results;
+}
+
+
+
+template<typename H5Writer>
+auto ReductionDiagnosticWriter<H5Writer>::fieldReductions_(DiagnosticProperties const& diagnostic)
+    -> Results
+{
+    auto& modelView  = h5Writer_.modelView();
+    auto const axis  = axis_(diagnostic);
+    auto const boxes = boxes_(diagnostic);
+
+    core::Box<int, dimension> domain;
+    std::array<std::size_t, dimension> shape;
+    for (std::size_t iDim = 0; iDim < dimension; ++iDim)
+    {
+        domain.lower[iDim] = 0;
+        domain.upper[iDim] = modelView.domainBox()[iDim];
+        shape[iDim]        = static_cast<std::size_t>(domain.upper[iDim] + 1);
+    }
+
+    // results are only computed by the first process which writes them, the others only need
+    // their sizes
+    bool const writer = core::mpi::rank() == 0;
+
+    Results results;
+    for (auto* vecField : modelView.getElectromagFields())
+        for (auto& [id, type] : core::Components::componentMap)
+        {
+            auto const name      = vecField->name() + "_" + id;
+            auto const component = type; // structured bindings cannot be captured
+
+            if (diagnostic.quantity == "/profile")
+            {
+                // slices are summed on each process, only the sums are reduced
+                std::vector<core::Profile<dimension>> profiles;
+                for (auto const& box : boxes)
+                    profiles.emplace_back(box, domain, axis);
+
+                auto sumPatch = [&](GridLayout& gridLayout, std::string const&, std::size_t) {
+                    auto& source = vecField->getComponent(component);
+                    for (auto& profile : profiles)
+                        profile.add(gridLayout.AMRBox(), [&](auto const& cell) {
+                            return source(gridLayout.AMRToLocal(cell).toArray());
+                        });
+                };
+                modelView.visitHierarchy(sumPatch, 0, 0);
+
+                for (std::size_t iBox = 0; iBox < profiles.size(); ++iBox)
+                {
+                    core::mpi::sumOnRoot(profiles[iBox].sums());
+                    results["box" + std::to_string(iBox) + "/" + name]
+                        = writer ? profiles[iBox].averages()
+                                 : std::vector<double>(profiles[iBox].size());
+                }
+            }
+            else
+            {
+                // spectra need whole lines of the domain, the cells of the patches of each process
+                // are gathered by the first process, each patch as its box bounds then its values
+                std::vector<double> cells;
+                auto packPatch = [&](GridLayout& gridLayout, std::string const&, std::size_t) {
+                    auto& source   = vecField->getComponent(component);
+                    auto const box = gridLayout.AMRBox();
+                    cells.insert(std::end(cells), std::begin(box.lower), std::end(box.lower));
+                    cells.insert(std::end(cells), std::begin(box.upper), std::end(box.upper));
+                    for (auto const& cell : box)
+                        cells.push_back(source(gridLayout.AMRToLocal(cell).toArray()));
+                };
+                modelView.visitHierarchy(packPatch, 0, 0);
+
+                auto const gathered = core::mpi::gatherOnRoot(cells);
+                auto const size     = core::powerSpectrumSize(shape[axis]);
+                results[name]
+                    = writer ? spectrum_(gathered, shape, axis) : std::vector<double>(size);
+            }
+        }
+    return results;
+}
+
+
+
+template<typename H5Writer>
+std::vector<double>
+ReductionDiagnosticWriter<H5Writer>::spectrum_(std::vector<double> const& cells,
+                                               std::array<std::size_t, dimension> const& shape,
+                                               std::size_t const axis)
+{
+    GlobalField field{shape};
+    for (std::size_t i = 0; i < cells.size();)
+    {
+        core::Box<int, dimension> box;
+        for (std::size_t iDim = 0; iDim < dimension; ++iDim)
+        {
+            box.lower[iDim] = static_cast<int>(cells[i + iDim]);
+            box.upper[iDim] = static_cast<int>(cells[i + dimension + iDim]);
+        }
+        i += 2 * dimension;
+
+        for (auto const& cell : box)
+            field(cell) = cells[i++];
+    }
+    return field.spectrum(axis);
+}
+
+
+
+template<typename H5Writer>
+void ReductionDiagnosticWriter<H5Writer>::writeAttributes(
+    DiagnosticProperties& diagnostic, Attributes& fileAttributes,
+    std::unordered_map<std::size_t, std::vector<std::pair<std::string, Attributes>>>&,
+    std::size_t /*maxLevel*/)
+{
+    if (!fileData_.count(diagnostic.quantity))
+        return;
+
+    auto& h5file      = *fileData_.at(diagnostic.quantity);
+    bool const writer = core::mpi::rank() == 0;
+
+    for (auto const& [time, results] : pending_[diagnostic.quantity])
+    {
+        auto const timePath
+            = "/t/" + core::to_string_with_precision(time, H5Writer::timestamp_precision) + "/";
+
+        // datasets are created by all processes, as required by parallel HDF5
+        for (auto const& [name, values] : results)
+        {
+            h5file.template create_data_set<double>(timePath + name, values.size());
+            if (writer)
+                h5file.write_data_set_raw(timePath + name, values.data());
+        }
+    }
+    pending_[diagnostic.quantity].clear();
+
+    if (diagnostic.nAttributes > 0)
+        h5Writer_.writeAttributeDict(h5file, diagnostic.fileAttributes, "/py_attrs");
+
+    auto attributes = fileAttributes;
+    if (diagnostic.quantity != "/energy")
+        attributes["axis"] = axis_(diagnostic);
+    if (diagnostic.quantity == "/profile")
+        attributes["boxes"] = diagnostic.param<std::vector<int>>("boxes");
+    if (diagnostic.quantity == "/spectrum")
+    {
+        // the domain is a whole number of wavelengths of mode k
+        auto const axis   = axis_(diagnostic);
+        auto const nCells = static_cast<std::size_t>(h5Writer_.modelView().domainBox()[axis] + 1);
+        auto const length = nCells * h5Writer_.modelView().cellWidth()[axis];
+
+        double const pi = std::acos(-1.);
+        std::vector<double> wavenumbers(nCells / 2 + 1);
+        for (std::size_t k = 0; k < wavenumbers.size(); ++k)
+            wavenumbers[k] = 2. * pi * k / length;
+        attributes["wavenumbers"] = wavenumbers;
+    }
+    h5Writer_.writeAttributeDict(h5file, attributes, "/");
+}
+
+
+
+template<typename H5Writer>
+double ReductionDiagnosticWriter<H5Writer>::cellVolume_()
+{
+    double volume = 1;
+    for (auto const& width : h5Writer_.modelView().cellWidth())
+        volume *= width;
+    return volume;
+}
+
+
+template<typename H5Writer>
+std::size_t ReductionDiagnosticWriter<H5Writer>::axis_(DiagnosticProperties const& diagnostic)
+{
+    auto const axis
+        = diagnostic.params.contains("axis") ? diagnostic.param<std::size_t>("axis") : 0;
+    if (axis >= dimension)
+        throw std::runtime_error("reduction diagnostic " + diagnostic.quantity
+                                 + ": axis out of the simulation dimension");
+    return axis;
+}
+
+
+template<typename H5Writer>
+auto ReductionDiagnosticWriter<H5Writer>::boxes_(DiagnosticProperties const& diagnostic)
+    -> std::vector<core::Box<int, dimension>>
+{
+    std::vector<core::Box<int, dimension>> boxes;
+    if (!diagnostic.params.contains("boxes"))
+        return boxes;
+
+    // lower and upper cells of each box, one after the other
+    auto const& bounds = diagnostic.param<std::vector<int>>("boxes");
+    for (std::size_t i = 0; i + 2 * dimension <= bounds.size(); i += 2 * dimension)
+    {
+        auto& box = boxes.emplace_back();
+        for (std::size_t iDim = 0; iDim < dimension; ++iDim)
+        {
+            box.lower[iDim] = bounds[i + iDim];
+            box.upper[iDim] = bounds[i + dimension + iDim];
+        }
+    }
+    return boxes;
+}
+
+} // namespace PHARE::diagnostic::h5
+
+#endif
@@ -3,12 +3,14 @@
 #define PHARE_DIAGNOSTIC_MANAGER_HPP_
 
 #include "core/data/particles/particle_array.hpp"
+#include "core/utilities/timestamps.hpp"
 #include "initializer/data_provider.hpp"
 #include "diagnostic_props.hpp"
 
 #include <utility>
 #include <cmath>
 #include <memory>
+#include <vector>
 
 namespace PHARE::diagnostic
 {
@@ -19,7 +21,8 @@ enum class Mode { LIGHT, FULL };
 template<typename DiagManager>
 void registerDiagnostics(DiagManager& dMan, initializer::PHAREDict const& diagsParams)
 {
-    std::vector<std::string> const diagTypes = {"fluid", "electromag", "particle", "info"};
+    std::vector<std::string> const diagTypes
+        = {"fluid", "electromag", "particle", "info", "distribution", "reduction"};
 
     for (auto& diagType : diagTypes)
     {
@@ -45,6 +48,10 @@ class IDiagnosticsManager
 public:
     virtual bool dump(double timeStamp, double timeStep)         = 0;
     virtual void dump_level(std::size_t level, double timeStamp) = 0;
+
+    //! all write and compute timestamps of all diagnostics
+    virtual std::vector<double> timestamps() const { return {}; }
+
     inline virtual ~IDiagnosticsManager();
 };
 IDiagnosticsManager::~IDiagnosticsManager() {}
@@ -88,6 +95,20 @@ public:
     auto& diagnostics() const { return diagnostics_; }
 
 
+    std::vector<double> timestamps() const override
+    {
+        std::vector<double> timestamps;
+        for (auto const& diag : diagnostics_)
+        {
+            timestamps.insert(std::end(timestamps), std::begin(diag.writeTimestamps),
+                              std::end(diag.writeTimestamps));
+            timestamps.insert(std::end(timestamps), std::begin(diag.computeTimestamps),
+                              std::end(diag.computeTimestamps));
+        }
+        return timestamps;
+    }
+
+
     Writer& writer() { return *writer_.get(); }
 
 
@@ -97,10 +118,10 @@ public:
     DiagnosticsManager& operator=(DiagnosticsManager&&) = delete;
 
 private:
-    bool needsAction_(double nextTime, double timeStamp, double timeStep)
+    bool needsAction_(double nextTime, double timeStamp, double /*timeStep*/)
     {
-        // casting to float to truncate double to avoid trailing imprecision
-        return static_cast<float>(std::abs(nextTime - timeStamp)) < static_cast<float>(timeStep);
+        // time steps land on timestamps, up to rounding errors
+        return core::isOnLandmark(timeStamp, nextTime);
     }
 
 
@@ -138,6 +159,50 @@ DiagnosticsManager<Writer>::addDiagDict(initializer::PHAREDict const& diagParams
     diagProps.quantity        = diagParams["quantity"].template to<std::string>();
     diagProps.writeTimestamps = diagParams["write_timestamps"].template to<std::vector<double>>();
     diagProps["flush_every"]  = diagParams["flush_every"].template to<std::size_t>();
+    diagProps["layout"]       = diagParams.contains("layout")
+                                    ? diagParams["layout"].template to<std::string>()
+                                    : std::string{"patches"};
+    if (diagParams.contains("precision"))
+        diagProps["precision"] = diagParams["precision"].template to<std::string>();
+
+    if (diagParams.contains("compression"))
+    {
+        auto const& compression = diagParams["compression"];
+        for (std::string key : {"chunk_size", "shuffle", "deflate", "quantize_digits"})
+            diagProps[key] = compression[key].template to<std::size_t>();
+    }
+
+    if (diagParams.contains("selection"))
+    {
+        auto const& selection = diagParams["selection"];
+        if (selection.contains("stride"))
+            diagProps["stride"] = selection["stride"].template to<std::size_t>();
+        if (selection.contains("fraction"))
+            diagProps["fraction"] = selection["fraction"].template to<double>();
+        if (selection.contains("boxes"))
+            diagProps["boxes"] = selection["boxes"].template to<std::vector<int>>();
+        for (std::string key : {"v_min", "v_max"})
+            if (selection.contains(key))
+                diagProps[key] = selection[key].template to<std::vector<double>>();
+    }
+
+    if (diagParams.contains("distribution"))
+    {
+        auto const& distribution = diagParams["distribution"];
+        diagProps["boxes"]       = distribution["boxes"].template to<std::vector<int>>();
+        diagProps["bins"]        = distribution["bins"].template to<std::vector<int>>();
+        diagProps["level"]       = distribution["level"].template to<std::size_t>();
+        for (std::string key : {"v_min", "v_max"})
+            diagProps[key] = distribution[key].template to<std::vector<double>>();
+    }
+
+    if (diagParams.contains("reduction"))
+    {
+        auto const& reduction = diagParams["reduction"];
+        diagProps["axis"]     = reduction["axis"].template to<std::size_t>();
+        if (reduction.contains("boxes"))
+            diagProps["boxes"] = reduction["boxes"].template to<std::vector<int>>();
+    }
 
     diagProps.computeTimestamps
         = diagParams["compute_timestamps"].template to<std::vector<double>>();
@@ -177,8 +242,8 @@ bool DiagnosticsManager<Writer>::dump(double timeStamp, double timeStep)
 
         if (needsCompute_(diag, timeStamp, timeStep))
         {
-            writer_->getDiagnosticWriterForType(diag.type)->compute(diag);
-            nextCompute_[diagID]++;
+            auto const computeTime = diag.computeTimestamps[nextCompute_[diagID]++];
+            writer_->getDiagnosticWriterForType(diag.type)->compute(diag, computeTime);
         }
         if (needsWrite_(diag, timeStamp, timeStep))
         {
@@ -12,8 +12,9 @@ namespace PHARE::diagnostic
 struct DiagnosticProperties
 {
     // Types limited to actual need, no harm to modify
-    using Params         = cppdict::Dict<std::size_t>;
     using FileAttributes = cppdict::Dict<std::string>;
+    using Params
+        = cppdict::Dict<std::size_t, double, std::string, std::vector<int>, std::vector<double>>;
 
     std::vector<double> writeTimestamps, computeTimestamps;
     std::string type, quantity;
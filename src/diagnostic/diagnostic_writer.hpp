@@ -10,8 +10,8 @@ namespace PHARE::diagnostic
 class TypeWriter
 {
 public:
-    virtual void write(DiagnosticProperties&)   = 0;
-    virtual void compute(DiagnosticProperties&) = 0;
+    virtual void write(DiagnosticProperties&)                     = 0;
+    virtual void compute(DiagnosticProperties&, double timeStamp) = 0;
     virtual ~TypeWriter() {}
 };
 
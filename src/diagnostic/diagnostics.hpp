@@ -8,10 +8,6 @@
 #error // PHARE_HAS_HIGHFIVE expected to be defined as bool
 #endif
 
-#if !defined(PHARE_DIAG_DOUBLES)
-#define PHARE_DIAG_DOUBLES false
-#endif
-
 
 #include "hdf5/phare_hdf5.hpp"
 
@@ -29,6 +25,8 @@
 #include "diagnostic/detail/types/particle.hpp"
 #include "diagnostic/detail/types/fluid.hpp"
 #include "diagnostic/detail/types/meta.hpp"
+#include "diagnostic/detail/types/distribution.hpp"
+#include "diagnostic/detail/types/reduction.hpp"
 
 #endif
 
@@ -4,6 +4,12 @@
 #include "highfive/H5File.hpp"
 #include "highfive/H5Easy.hpp"
 
+#include <algorithm>
+#include <functional>
+#include <numeric>
+#include <type_traits>
+#include <vector>
+
 namespace PHARE::hdf5::h5
 {
 using HiFile = HighFive::File;
@@ -57,6 +63,68 @@ auto vector_for_dim()
         return std::vector<std::vector<std::vector<Data>>>();
 }
 
+/*
+  Creation properties of the datasets of a file. Filters only apply to chunked datasets, of
+  about chunkSize elements per chunk, chunks being slices along the first dimension.
+  quantizeDigits > 0 applies the lossy scale-offset filter to floating point datasets, keeping
+  that many decimal digits, the absolute error is then at most 0.5 * 10^-quantizeDigits.
+  With parallel HDF5, filtered datasets must be written collectively.
+*/
+struct DataSetFilters
+{
+    std::size_t chunkSize      = 0; // 0: contiguous datasets
+    bool shuffle               = false;
+    std::size_t deflate        = 0; // compression level in [0, 9], 0: no compression
+    std::size_t quantizeDigits = 0;
+
+    bool enabled() const { return chunkSize > 0; }
+
+    template<typename Type>
+    HighFive::DataSetCreateProps props(std::vector<std::size_t> const& dims) const
+    {
+        HighFive::DataSetCreateProps props;
+
+        // HDF5 cannot chunk empty datasets
+        bool const empty = std::any_of(dims.begin(), dims.end(), [](auto n) { return n == 0; });
+        if (!enabled() or dims.empty() or empty)
+            return props;
+
+        auto const sliceSize
+            = std::accumulate(dims.begin() + 1, dims.end(), std::size_t{1}, std::multiplies<>{});
+        auto chunk = dims;
+        chunk[0]   = std::clamp(chunkSize / sliceSize, std::size_t{1}, dims[0]);
+        props.add(HighFive::Chunking(chunk));
+
+        if constexpr (std::is_floating_point_v<Type>)
+            if (quantizeDigits > 0)
+            {
+                if (!H5Zfilter_avail(H5Z_FILTER_SCALEOFFSET))
+                    throw HighFive::PropertyException("Scale-offset filter unavailable.");
+                if (H5Pset_scaleoffset(props.getId(), H5Z_SO_FLOAT_DSCALE,
+                                       static_cast<int>(quantizeDigits))
+                    < 0)
+                    throw HighFive::PropertyException("Error setting scale-offset property");
+            }
+        if (shuffle)
+            props.add(HighFive::Shuffle());
+        if (deflate > 0)
+            props.add(HighFive::Deflate(static_cast<unsigned>(deflate)));
+
+        return props;
+    }
+};
+
+
+
+/*
+  Storage precision of the floating point datasets of a file. Datasets created in single precision
+  are written from double data by converting it into a staging buffer of the file, reused from one
+  write to the next.
+*/
+enum class Precision { Single, Double };
+
+
+
 class HighFiveFile
 {
 public:
@@ -83,6 +151,10 @@ public:
 
     HiFile& file() { return h5file_; }
 
+    DataSetFilters& filters() { return filters_; }
+
+    Precision& precision() { return precision_; }
+
 
     template<typename T, std::size_t dim = 1>
     auto read_data_set_flat(std::string path) const
@@ -100,6 +172,23 @@ public:
         return data;
     }
 
+    // reads nbrRows rows of rowSize values, from row firstRow of the dataset at path
+    template<typename Type>
+    auto read_data_set_rows(std::string const& path, std::size_t const firstRow,
+                            std::size_t const nbrRows, std::size_t const rowSize = 1) const
+    {
+        std::vector<Type> data(nbrRows * rowSize);
+        if (data.empty())
+            return data;
+
+        auto dataSet = h5file_.getDataSet(path);
+        if (rowSize > 1)
+            dataSet.select({firstRow, 0}, {nbrRows, rowSize}).read_raw(data.data());
+        else
+            dataSet.select({firstRow}, {nbrRows}).read_raw(data.data());
+        return data;
+    }
+
 
     template<std::size_t dim = 1, typename Data>
     auto& write_data_set(std::string path, Data const& data)
@@ -111,16 +200,52 @@ public:
     template<std::size_t dim = 1, typename Data>
     auto& write_data_set_flat(std::string path, Data const& data)
     {
-        h5file_.getDataSet(path).write(pointer_dim_caster<dim>(data));
+        auto dataSet = h5file_.getDataSet(path);
+        if (!write_converted_(dataSet, data, dataSet.getElementCount(),
+                              [&](float const* converted) { dataSet.write_raw(converted); }))
+            dataSet.write(pointer_dim_caster<dim>(data));
+        return *this;
+    }
+
+
+    // writes the whole dataset at path from contiguous c-ordered data, whatever its shape
+    template<typename Type>
+    auto& write_data_set_raw(std::string const& path, Type const* const data)
+    {
+        auto dataSet = h5file_.getDataSet(path);
+        if (!write_converted_(dataSet, data, dataSet.getElementCount(),
+                              [&](float const* converted) { dataSet.write_raw(converted); }))
+            dataSet.write_raw(data);
         return *this;
     }
 
 
+    // writes nbrRows rows of rowSize values, from row firstRow of the 2D dataset at path, or of the
+    // 1D dataset if rowSize is 1
+    template<typename Type>
+    auto& write_data_set_rows(std::string const& path, Type const* const data,
+                              std::size_t const firstRow, std::size_t const nbrRows,
+                              std::size_t const rowSize)
+    {
+        auto dataSet   = h5file_.getDataSet(path);
+        auto selection = dataSet.getSpace().getNumberDimensions() == 1
+                             ? dataSet.select({firstRow}, {nbrRows})
+                             : dataSet.select({firstRow, 0}, {nbrRows, rowSize});
+        if (!write_converted_(dataSet, data, nbrRows * rowSize,
+                              [&](float const* converted) { selection.write_raw(converted); }))
+            selection.write_raw(data);
+        return *this;
+    }
+
+
+    // floating point datasets are created in the precision of the file
     template<typename Type, typename Size>
     void create_data_set(std::string const& path, Size const& dataSetSize)
     {
-        createGroupsToDataSet(path);
-        h5file_.createDataSet<Type>(path, HighFive::DataSpace(dataSetSize));
+        if (std::is_floating_point_v<Type> and precision_ == Precision::Single)
+            create_data_set_as_<float>(path, dataSetSize);
+        else
+            create_data_set_as_<Type>(path, dataSetSize);
     }
 
 
@@ -149,6 +274,68 @@ public:
 
 
 
+    /*
+     * Creates on all MPI processes a dataset concatenating, in rank order, the rows of data of
+     * every process, a row being rowSize values. Each process then writes its own rows as a
+     * hyperslab with a single (collective if HDF5 is parallel) write, even if it has none.
+     * Returns the index of the first row of the current process in the dataset.
+     * Floating point data is stored in the precision of the file, unless exact.
+     */
+    template<typename Type>
+    std::size_t write_data_set_concatenated(std::string const& path, std::vector<Type> const& data,
+                                            std::size_t const rowSize = 1, bool const exact = false)
+    {
+        auto const nbrRows   = data.size() / rowSize;
+        auto const allRows   = core::mpi::collect(nbrRows);
+        auto const rank      = static_cast<std::size_t>(core::mpi::rank());
+        auto const totalRows = std::accumulate(allRows.begin(), allRows.end(), std::size_t{0});
+        auto const firstRow
+            = std::accumulate(allRows.begin(), allRows.begin() + rank, std::size_t{0});
+
+        std::vector<std::size_t> dims{totalRows}, offset{firstRow}, count{nbrRows};
+        if (rowSize > 1)
+        {
+            dims.push_back(rowSize);
+            offset.push_back(0);
+            count.push_back(rowSize);
+        }
+
+        HighFive::DataTransferProps xferProps;
+#if defined(H5_HAVE_PARALLEL)
+        xferProps.add(HighFive::UseCollectiveIO{});
+#endif
+
+        createGroupsToDataSet(path);
+        if constexpr (std::is_same_v<Type, double>)
+            if (!exact and precision_ == Precision::Single)
+            {
+                auto dataSet = h5file_.createDataSet<float>(path, HighFive::DataSpace(dims),
+                                                            filters_.template props<float>(dims));
+                staging_.assign(data.begin(), data.end());
+                write_rows_(dataSet, offset, count, staging_.data(), xferProps);
+                return firstRow;
+            }
+
+        auto dataSet = h5file_.createDataSet<Type>(path, HighFive::DataSpace(dims),
+                                                   filters_.template props<Type>(dims));
+        write_rows_(dataSet, offset, count, data.data(), xferProps);
+
+        return firstRow;
+    }
+
+
+
+    template<typename Data>
+    void write_data_set_attribute(std::string const& path, std::string const& key,
+                                  Data const& value)
+    {
+        h5file_.getDataSet(path)
+            .template createAttribute<Data>(key, HighFive::DataSpace::From(value))
+            .write(value);
+    }
+
+
+
     template<typename Data>
     void write_attribute(std::string const& path, std::string const& key, Data const& value)
     {
@@ -223,6 +410,63 @@ public:
 
 private:
     HiFile h5file_;
+    DataSetFilters filters_;
+    Precision precision_ = Precision::Double;
+    std::vector<float> staging_;
+
+    /** writes the rows of this process at their offset. A process without rows still takes part
+     * in the collective write, with empty selections
+     */
+    template<typename Type>
+    static void write_rows_(HighFive::DataSet& dataSet, std::vector<std::size_t> const& offset,
+                            std::vector<std::size_t> const& count, Type const* data,
+                            HighFive::DataTransferProps const& xferProps)
+    {
+        auto const type = HighFive::create_datatype<Type>();
+        if (count[0] > 0)
+        {
+            dataSet.select(offset, count).write_raw(data, type, xferProps);
+            return;
+        }
+
+        Type const nothing{};
+        auto const space  = H5Dget_space(dataSet.getId());
+        auto const status = H5Sselect_none(space) < 0
+                                ? -1
+                                : H5Dwrite(dataSet.getId(), type.getId(), space, space,
+                                           xferProps.getId(), &nothing);
+        H5Sclose(space);
+        if (status < 0)
+            throw HighFive::DataSetException("HighFiveFile: empty write failed");
+    }
+
+    template<typename Stored, typename Size>
+    void create_data_set_as_(std::string const& path, Size const& dataSetSize)
+    {
+        createGroupsToDataSet(path);
+        h5file_.createDataSet<Stored>(path, HighFive::DataSpace(dataSetSize),
+                                      filters_.template props<Stored>(dims_of(dataSetSize)));
+    }
+
+
+    // if double data goes to a single precision dataset, writes it converted, returns false
+    // otherwise
+    template<typename Data, typename Write>
+    bool write_converted_(HighFive::DataSet const& dataSet, Data const& data,
+                          std::size_t const size, Write&& write)
+    {
+        using Value = std::remove_cv_t<std::remove_pointer_t<std::decay_t<Data>>>;
+        if constexpr (std::is_same_v<Value, double>)
+        {
+            if (!(dataSet.getDataType() == HighFive::AtomicType<float>()))
+                return false;
+            staging_.assign(data, data + size);
+            write(staging_.data());
+            return true;
+        }
+        else
+            return false;
+    }
 
 
     // during attribute/dataset creation, we currently don't require the parents of the group to
@@ -244,6 +488,15 @@ private:
 
 
 
+    template<typename Size>
+    static std::vector<std::size_t> dims_of(Size const& size)
+    {
+        if constexpr (core::is_iterable_v<Size>)
+            return std::vector<std::size_t>(size.begin(), size.end());
+        else
+            return {static_cast<std::size_t>(size)};
+    }
+
     template<typename Size>
     static bool is_zero(Size size)
     {
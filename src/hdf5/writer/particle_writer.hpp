@@ -2,6 +2,13 @@
 #define PHARE_HDF5_PARTICLE_WRITER_HPP
 
 #include <array>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
 #include <vector>
 
 #include "hdf5/detail/hdf5_utils.hpp"
@@ -12,24 +19,146 @@
 
 namespace PHARE::hdf5
 {
+/** \brief PackingThread runs one task at a time on a thread that is started once and lives as
+ * long as the PackingThread, so that packing a chunk does not start a thread
+ */
+class PackingThread
+{
+public:
+    PackingThread()
+        : thread_{[this]() { run_(); }}
+    {
+    }
+
+    ~PackingThread()
+    {
+        {
+            std::lock_guard<std::mutex> lock{mutex_};
+            stop_ = true;
+        }
+        cv_.notify_all();
+        thread_.join();
+    }
+
+    PackingThread(PackingThread const&) = delete;
+    PackingThread& operator=(PackingThread const&) = delete;
+
+
+    //! the previous task must have been waited for
+    void start(std::function<void()> task)
+    {
+        {
+            std::lock_guard<std::mutex> lock{mutex_};
+            task_ = std::move(task);
+            done_ = false;
+        }
+        cv_.notify_all();
+    }
+
+    //! waits for the task to be done, and rethrows what it threw
+    void wait()
+    {
+        std::unique_lock<std::mutex> lock{mutex_};
+        cv_.wait(lock, [this]() { return done_; });
+        if (error_)
+            std::rethrow_exception(std::exchange(error_, nullptr));
+    }
+
+
+private:
+    void run_()
+    {
+        std::unique_lock<std::mutex> lock{mutex_};
+        while (true)
+        {
+            cv_.wait(lock, [this]() { return stop_ or task_; });
+            if (stop_)
+                return;
+
+            auto task = std::exchange(task_, nullptr);
+            lock.unlock();
+            try
+            {
+                task();
+            }
+            catch (...)
+            {
+                error_ = std::current_exception();
+            }
+            lock.lock();
+            done_ = true;
+            cv_.notify_all();
+        }
+    }
+
+
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::function<void()> task_;
+    std::exception_ptr error_;
+    bool done_ = true;
+    bool stop_ = false;
+    std::thread thread_; // last, it runs once all the above is initialized
+};
+
+
+
 class ParticleWriter
 {
 public:
+    // particles are packed and written by chunks of this many particles
+    static constexpr std::size_t chunk_size = 1 << 14;
+
+
+    /*
+     * Particles are packed chunk by chunk into one of two small reusable buffers, each chunk is
+     * written as a hyperslab of the datasets while the next one is packed into the other buffer by
+     * a persistent packing thread, rather than first packing a contiguous copy of the whole array.
+     * If given, only the particles of the selected indexes are written. They are written from row
+     * firstRow of the datasets, which may hold the particles of several arrays.
+     */
     template<typename H5File, typename Particles>
-    static void write(H5File& h5file, Particles const& particles, std::string const& path)
+    static void write(H5File& h5file, Particles const& particles, std::string const& path,
+                      std::vector<std::size_t> const* selection = nullptr,
+                      std::size_t const firstRow = 0)
     {
         auto constexpr dim = Particles::dimension;
         using Packer       = core::ParticlePacker<dim>;
 
-        Packer packer(particles);
-        core::ContiguousParticles<dim> copy{particles.size()};
-        packer.pack(copy);
-
-        std::size_t part_idx = 0;
-        core::apply(copy.as_tuple(), [&](auto const& arg) {
-            auto data_path = path + packer.keys()[part_idx++];
-            h5file.template write_data_set_flat<2>(data_path, arg.data());
-        });
+        auto& buffers       = chunkBuffers_<dim>();
+        auto& packingThread = packingThread_();
+        Packer packer       = selection ? Packer{particles, *selection} : Packer{particles};
+
+        std::size_t iBuffer = 0;
+        std::size_t row     = firstRow;
+        std::size_t count   = packer.pack_next(buffers[iBuffer], chunk_size);
+        while (count > 0)
+        {
+            auto& nextBuffer      = buffers[1 - iBuffer];
+            std::size_t nextCount = 0;
+            bool const packNext   = packer.hasNext();
+            if (packNext)
+                packingThread.start([&packer, &nextBuffer, &nextCount]() {
+                    nextCount = packer.pack_next(nextBuffer, chunk_size);
+                });
+
+            try
+            {
+                writeChunk_(h5file, buffers[iBuffer], path, row, count);
+            }
+            catch (...)
+            {
+                if (packNext) // the task uses this scope
+                    packingThread.wait();
+                throw;
+            }
+            if (packNext)
+                packingThread.wait();
+
+            row += count;
+            count   = nextCount;
+            iBuffer = 1 - iBuffer;
+        }
     }
 
 
@@ -45,6 +174,39 @@ public:
         else /* not an array so value one of type T*/
             return std::vector<std::size_t>{n_particles, 1};
     }
+
+
+private:
+    template<std::size_t dim>
+    static auto& chunkBuffers_()
+    {
+        static thread_local std::array<core::ContiguousParticles<dim>, 2> buffers{chunk_size,
+                                                                                 chunk_size};
+        return buffers;
+    }
+
+
+    static PackingThread& packingThread_()
+    {
+        static thread_local PackingThread packingThread;
+        return packingThread;
+    }
+
+
+    template<typename H5File, std::size_t dim>
+    static void writeChunk_(H5File& h5file, core::ContiguousParticles<dim> const& chunk,
+                            std::string const& path, std::size_t const firstRow,
+                            std::size_t const count)
+    {
+        using Packer = core::ParticlePacker<dim>;
+
+        std::size_t part_idx = 0;
+        core::apply(chunk.as_tuple(), [&](auto const& arg) {
+            auto const rowSize = arg.size() / chunk.size();
+            h5file.write_data_set_rows(path + Packer::keys()[part_idx++], arg.data(), firstRow,
+                                       count, rowSize);
+        });
+    }
 };
 
 
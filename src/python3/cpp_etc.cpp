@@ -4,6 +4,7 @@
 
 
 #include "amr/wrappers/hierarchy.hpp" // for HierarchyRestarter::getRestartFileFullPath
+#include "restarts/restarts_props.hpp"  // for restarts::phareRestartFile
 
 
 
@@ -48,6 +49,10 @@ PYBIND11_MODULE(cpp_etc, m)
         return PHARE::amr::HierarchyRestarter::getRestartFileFullPath(path);
     });
 
+    m.def("phare_restart_file", [](std::string path) {
+        return PHARE::restarts::phareRestartFile(path); //
+    });
+
     m.def("restart_path_for_time", [](std::string path, double timestamp) {
         return PHARE::amr::Hierarchy::restartFilePathForTime(path, timestamp);
     });
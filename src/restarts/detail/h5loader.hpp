@@ -0,0 +1,363 @@
+#ifndef PHARE_DETAIL_RESTART_HIGHFIVE_LOADER_HPP
+#define PHARE_DETAIL_RESTART_HIGHFIVE_LOADER_HPP
+
+#include "core/utilities/types.hpp"
+#include "core/utilities/mpi_utils.hpp"
+#include "core/utilities/box/box.hpp"
+#include "core/data/grid/gridlayoutdefs.hpp"
+#include "core/data/ndarray/ndarray_vector.hpp"
+#include "core/data/particles/particle.hpp"
+#include "core/data/particles/particle_array.hpp"
+#include "core/data/particles/particle_packer.hpp"
+#include "core/data/vecfield/vecfield_component.hpp"
+
+#include "restarts/restarts_props.hpp"
+
+#include "hdf5/detail/h5/h5_file.hpp"
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <numeric>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+namespace PHARE::restarts::h5
+{
+/*
+ * Loads the levels of a "phareh5" restart file (see Writer) into the patches of a hierarchy, which
+ * needs neither the patches of the saved one nor its number of processes.
+ *
+ * For each patch of the level, only the saved patches overlapping it are read, once per level.
+ *  - physical nodes of the electromagnetic field are copied from the saved physical nodes, ghost
+ *    nodes are left to the messengers
+ *  - domain particles in the cells of the saved patches are replaced by the saved ones
+ * What the saved level does not cover, a level created after the restart or a finer level
+ * larger than the saved one, keeps the data it was initialized with. Levels the saved level
+ * covers entirely need no initialization at all, see covers().
+ *
+ * The loader lives until the hierarchy is initialized, it then reports the time spent reading the
+ * file and the rest of the set up since its construction.
+ */
+template<typename ModelView>
+class Loader
+{
+public:
+    using GridLayout                = typename ModelView::GridLayout;
+    static constexpr auto dimension = ModelView::dimension;
+
+    template<typename Hierarchy, typename Model>
+    Loader(Hierarchy& hier, Model& model, std::string const& directory)
+        : modelView_{hier, model}
+        , start_{Clock::now()}
+        , h5File_{phareRestartFile(directory), HighFive::File::ReadOnly, /*para=*/false}
+    {
+        ioTime_ = secondsSince_(start_); // opening the file
+    }
+
+    ~Loader();
+
+    //! true if the saved level has data for all cells of the level, on all processes
+    template<typename Level>
+    bool covers(Level& level);
+
+    template<typename Level>
+    void load(Level& level);
+
+
+private:
+    using Box    = core::Box<int, dimension>;
+    using Packer = core::ParticlePacker<dimension>;
+    using SoA    = core::ContiguousParticles<dimension>;
+    using Clock  = std::chrono::steady_clock;
+
+    static double secondsSince_(Clock::time_point const start)
+    {
+        return std::chrono::duration<double>(Clock::now() - start).count();
+    }
+
+    //! returns fn(), its duration is added to the time spent reading the file
+    template<typename Fn>
+    auto timed_(Fn&& fn)
+    {
+        auto const start = Clock::now();
+        auto result      = fn();
+        ioTime_ += secondsSince_(start);
+        return result;
+    }
+
+    void readBoxes_(std::string const& levelPath);
+
+    static GridLayout savedLayout_(GridLayout const& layout, Box const& box);
+
+    template<typename Field>
+    void loadField_(Field& field, std::string const& path, GridLayout const& layout);
+
+    template<typename ParticleArray>
+    void loadParticles_(ParticleArray& domain, std::string const& path, GridLayout const& layout);
+
+
+    ModelView modelView_;
+    Clock::time_point const start_;
+    double ioTime_ = 0; // seconds
+    hdf5::h5::HighFiveFile h5File_;
+
+    // saved patches of the level being loaded, and what was read from them: first element of each
+    // patch per dataset, then data per dataset and patch index
+    std::vector<Box> boxes_;
+    std::unordered_map<std::string, std::vector<std::size_t>> offsets_;
+    std::unordered_map<std::string, std::map<std::size_t, std::vector<double>>> fields_;
+    std::unordered_map<std::string, std::map<std::size_t, SoA>> particles_;
+};
+
+
+
+template<typename ModelView>
+Loader<ModelView>::~Loader()
+{
+    if (core::mpi::rank() != 0)
+        return;
+
+    auto const total = secondsSince_(start_);
+    std::cout << "restart loaded in " << total << "s: " << ioTime_ << "s reading "
+              << h5File_.file().getName() << ", " << total - ioTime_ << "s setting up\n";
+}
+
+
+
+template<typename ModelView>
+template<typename Level>
+bool Loader<ModelView>::covers(Level& level)
+{
+    std::string const levelPath = "/levels/L" + std::to_string(level.getLevelNumber());
+    bool covered                = h5File_.file().exist(levelPath);
+
+    if (covered)
+    {
+        readBoxes_(levelPath);
+
+        // boxes of a level do not overlap, the cells of a patch are covered if the overlaps of
+        // the saved boxes with it add up to its size
+        auto checkPatch = [&](GridLayout& layout, std::string const&, std::size_t) {
+            auto const& patchBox = layout.AMRBox();
+            std::size_t nbrCells = 0;
+            for (auto const& box : boxes_)
+                if (auto overlap = box * patchBox)
+                    nbrCells += overlap->size();
+            covered = covered and nbrCells == static_cast<std::size_t>(patchBox.size());
+        };
+        modelView_.visitLevel(level, checkPatch);
+    }
+
+    // levels are initialized with collective schedules, all processes must agree
+    return !core::mpi::any(!covered);
+}
+
+
+
+template<typename ModelView>
+template<typename Level>
+void Loader<ModelView>::load(Level& level)
+{
+    std::string const levelPath = "/levels/L" + std::to_string(level.getLevelNumber());
+    if (!h5File_.file().exist(levelPath))
+        return;
+
+    readBoxes_(levelPath);
+
+    auto loadPatch = [&](GridLayout& layout, std::string const&, std::size_t) {
+        for (auto* vecField : modelView_.getElectromagFields())
+            for (auto& [id, type] : core::Components::componentMap)
+                loadField_(vecField->getComponent(type),
+                           levelPath + "/fields/" + vecField->name() + "_" + id, layout);
+
+        for (auto& pop : modelView_.getIons())
+            loadParticles_(pop.domainParticles(), levelPath + "/particles/" + pop.name() + "/",
+                           layout);
+    };
+    modelView_.visitLevel(level, loadPatch);
+
+    offsets_.clear();
+    fields_.clear();
+    particles_.clear();
+}
+
+
+
+template<typename ModelView>
+void Loader<ModelView>::readBoxes_(std::string const& levelPath)
+{
+    // lower and upper cells of each box, one after the other
+    auto const bounds
+        = timed_([&]() { return h5File_.template read_data_set_flat<int>(levelPath + "/boxes"); });
+
+    boxes_.clear();
+    for (std::size_t i = 0; i + 2 * dimension <= bounds.size(); i += 2 * dimension)
+    {
+        auto& box = boxes_.emplace_back();
+        for (std::size_t iDim = 0; iDim < dimension; ++iDim)
+        {
+            box.lower[iDim] = bounds[i + iDim];
+            box.upper[iDim] = bounds[i + dimension + iDim];
+        }
+    }
+}
+
+
+
+//! layout of a saved patch of the level of the given layout
+template<typename ModelView>
+auto Loader<ModelView>::savedLayout_(GridLayout const& layout, Box const& box) -> GridLayout
+{
+    std::array<std::uint32_t, dimension> nbrCells;
+    core::Point<double, dimension> origin;
+    for (std::size_t iDim = 0; iDim < dimension; ++iDim)
+    {
+        nbrCells[iDim] = static_cast<std::uint32_t>(box.upper[iDim] - box.lower[iDim] + 1);
+        origin[iDim]   = layout.origin()[iDim]
+                       + (box.lower[iDim] - layout.AMRBox().lower[iDim]) * layout.meshSize()[iDim];
+    }
+    return GridLayout{layout.meshSize(), nbrCells, origin, box};
+}
+
+
+
+template<typename ModelView>
+template<typename Field>
+void Loader<ModelView>::loadField_(Field& field, std::string const& path,
+                                   GridLayout const& layout)
+{
+    auto const qty = field.physicalQuantity();
+
+    // physical nodes of the field on a patch, by AMR index, and their local index
+    auto nodes = [&](GridLayout const& patchLayout) {
+        auto box = patchLayout.AMRBox();
+        for (std::size_t iDim = 0; iDim < dimension; ++iDim)
+        {
+            auto const dir  = static_cast<core::Direction>(iDim);
+            box.upper[iDim] = box.lower[iDim] + patchLayout.physicalEndIndex(qty, dir)
+                              - patchLayout.physicalStartIndex(qty, dir);
+        }
+        return box;
+    };
+    auto local = [&](GridLayout const& patchLayout, auto const& node) {
+        std::array<std::uint32_t, dimension> index;
+        for (std::size_t iDim = 0; iDim < dimension; ++iDim)
+            index[iDim] = patchLayout.physicalStartIndex(qty, static_cast<core::Direction>(iDim))
+                          + node[iDim] - patchLayout.AMRBox().lower[iDim];
+        return index;
+    };
+
+    auto& offsets = offsets_[path];
+    if (offsets.empty())
+    {
+        offsets.push_back(0);
+        for (auto const& box : boxes_)
+        {
+            auto const shape = savedLayout_(layout, box).allocSize(qty);
+            offsets.push_back(offsets.back()
+                              + std::accumulate(shape.begin(), shape.end(), std::size_t{1},
+                                                std::multiplies<std::size_t>{}));
+        }
+    }
+
+    auto const patchNodes = nodes(layout);
+    for (std::size_t iSaved = 0; iSaved < boxes_.size(); ++iSaved)
+    {
+        // saved patches overlapping no cell have no node the others do not have
+        if (!(boxes_[iSaved] * layout.AMRBox()))
+            continue;
+
+        auto const savedLayout = savedLayout_(layout, boxes_[iSaved]);
+        auto const overlap     = nodes(savedLayout) * patchNodes;
+
+        auto& saved = fields_[path][iSaved];
+        if (saved.empty())
+            saved = timed_([&]() {
+                return h5File_.template read_data_set_rows<double>(
+                    path, offsets[iSaved], offsets[iSaved + 1] - offsets[iSaved]);
+            });
+
+        core::NdArrayView<dimension> view{saved.data(), savedLayout.allocSize(qty)};
+        for (auto const& node : *overlap)
+            field(local(layout, node)) = view(local(savedLayout, node));
+    }
+}
+
+
+
+template<typename ModelView>
+template<typename ParticleArray>
+void Loader<ModelView>::loadParticles_(ParticleArray& domain, std::string const& path,
+                                       GridLayout const& layout)
+{
+    auto const& patchBox = layout.AMRBox();
+
+    std::vector<std::size_t> overlapping;
+    std::vector<Box> covered;
+    for (std::size_t iSaved = 0; iSaved < boxes_.size(); ++iSaved)
+        if (boxes_[iSaved] * patchBox)
+        {
+            overlapping.push_back(iSaved);
+            covered.push_back(boxes_[iSaved]);
+        }
+    if (overlapping.empty())
+        return;
+
+    auto& offsets = offsets_[path];
+    if (offsets.empty())
+    {
+        auto const counts = timed_([&]() {
+            return h5File_.template read_data_set_flat<std::size_t>(path + "counts");
+        });
+        offsets.assign(counts.size() + 1, 0);
+        std::partial_sum(counts.begin(), counts.end(), offsets.begin() + 1);
+    }
+
+    std::vector<typename ParticleArray::value_type> kept;
+    for (auto const& particle : domain)
+        if (!core::isIn(core::cellAsPoint(particle), covered))
+            kept.push_back(particle);
+    domain.clear();
+    for (auto const& particle : kept)
+        domain.push_back(particle);
+
+    std::array<std::size_t, 5> const rowSizes{1, 1, dimension, dimension, 3};
+    for (auto const iSaved : overlapping)
+    {
+        auto& savedPatches = particles_[path];
+        auto it            = savedPatches.find(iSaved);
+        if (it == savedPatches.end())
+        {
+            auto const first = offsets[iSaved];
+            auto const count = offsets[iSaved + 1] - first;
+            it               = savedPatches.emplace(iSaved, SoA{count}).first;
+
+            std::size_t iKey = 0;
+            core::apply(it->second.as_tuple(), [&](auto& data) {
+                using Value = typename std::decay_t<decltype(data)>::value_type;
+                data        = timed_([&]() {
+                    return h5File_.template read_data_set_rows<Value>(
+                        path + Packer::keys()[iKey], first, count, rowSizes[iKey]);
+                });
+                ++iKey;
+            });
+        }
+
+        auto& saved = it->second;
+        for (std::size_t i = 0; i < saved.size(); ++i)
+            if (auto particle = saved.copy(i); core::isIn(core::cellAsPoint(particle), patchBox))
+                domain.push_back(particle);
+    }
+}
+
+
+
+} // namespace PHARE::restarts::h5
+
+#endif /* PHARE_DETAIL_RESTART_HIGHFIVE_LOADER_HPP */
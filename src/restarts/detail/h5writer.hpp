@@ -1,58 +1,93 @@
-
 #ifndef PHARE_DETAIL_RESTART_HIGHFIVE_HPP
 #define PHARE_DETAIL_RESTART_HIGHFIVE_HPP
 
 #include "core/logger.hpp"
 #include "core/utilities/types.hpp"
+#include "core/utilities/mpi_utils.hpp"
+#include "core/data/particles/particle_array.hpp"
+#include "core/data/particles/particle_packer.hpp"
+#include "core/data/vecfield/vecfield_component.hpp"
 
 #include "restarts/restarts_props.hpp"
 
 #include "hdf5/detail/h5/h5_file.hpp"
+#include "hdf5/writer/particle_writer.hpp"
+
+#include <SAMRAI/tbox/Utilities.h>
+
+#include <array>
+#include <numeric>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 namespace PHARE::restarts::h5
 {
+/*
+ * Restarts are written in the format given by the "format" restart option
+ *
+ * samraih5 (default): SAMRAI restart files, one per process, that can only be loaded with the
+ *   same number of processes. The patch data ids of the model are added to each file, and the
+ *   "time_step" attribute of /phare, see below.
+ *
+ * phareh5: a single file per restart, see phareRestartFile(), written collectively and
+ *   independent of the number of processes. For each level L#:
+ *
+ *   /levels/L#/boxes                    (patch, lower and upper cells)
+ *   /levels/L#/fields/<field>           field data of all patches, ghost nodes included
+ *   /levels/L#/particles/<pop>/counts   number of domain particles per patch
+ *   /levels/L#/particles/<pop>/<key>    weight, charge, iCell, delta and v of these particles
+ *
+ *   Patches are in the same order in all datasets of a level. The data of a patch is found from
+ *   the boxes and the counts of the patches before it. See Loader to read it on any number of
+ *   processes. Each process writes the data of its patches straight at their offsets.
+ *
+ *   The tag ages of the tagging hysteresis are not saved in this format, pyphare rejects restarts
+ *   from it with a tagging hysteresis.
+ *
+ * Both formats save the time step to restart with as the "time_step" attribute, an adaptive time
+ * stepping resumes with it (see core::ITimeStamper::restartTimeStep).
+ */
 template<typename ModelView>
 class Writer
 {
 public:
-    using This = Writer<ModelView>;
+    using This                      = Writer<ModelView>;
+    using GridLayout                = typename ModelView::GridLayout;
+    static constexpr auto dimension = ModelView::dimension;
 
     template<typename Hierarchy, typename Model>
-    Writer(Hierarchy const& hier, Model const& model, std::string const filePath)
+    Writer(Hierarchy& hier, Model& model, std::string const filePath, std::string const format)
         : path_{filePath}
+        , format_{format}
         , modelView_{hier, model}
     {
+        if (format_ != "samraih5" and format_ != "phareh5")
+            throw std::runtime_error("Unknown restart format " + format_);
     }
 
     ~Writer() {}
 
 
     template<typename Hierarchy, typename Model>
-    static auto make_unique(Hierarchy const& hier, Model const& model,
-                            initializer::PHAREDict const& dict)
+    static auto make_unique(Hierarchy& hier, Model& model, initializer::PHAREDict const& dict)
     {
         std::string filePath = dict["filePath"].template to<std::string>();
-        return std::make_unique<This>(hier, model, filePath);
+        std::string format
+            = dict.contains("format") ? dict["format"].template to<std::string>() : "samraih5";
+        return std::make_unique<This>(hier, model, filePath, format);
     }
 
 
-    void dump(RestartsProperties const& properties, double timestamp)
+    void dump(RestartsProperties const& properties, double timestamp, double timeStep)
     {
-        auto restart_file
-            = modelView_.writeRestartFile(ModelView::restartFilePathForTime(path_, timestamp));
-
-        // write model patch_data_ids to file with highfive
-        // SAMRAI restart files are PER RANK
-        PHARE::hdf5::h5::HighFiveFile h5File{restart_file, HighFive::File::ReadWrite,
-                                             /*para=*/false};
+        auto const directory = ModelView::restartFilePathForTime(path_, timestamp);
 
-        auto patch_ids = modelView_.patch_data_ids();
-        h5File.create_data_set<int>("/phare/patch/ids", patch_ids.size());
-        h5File.write_data_set("/phare/patch/ids", patch_ids);
-
-        h5File.write_attribute(
-            "/phare", "serialized_simulation",
-            properties.fileAttributes["serialized_simulation"].template to<std::string>());
+        if (format_ == "phareh5")
+            dumpLevels_(properties, directory, timestamp, timeStep);
+        else
+            dumpSamrai_(properties, directory, timeStep);
 
         core::mpi::barrier();
     }
@@ -61,12 +96,180 @@ public:
 
 
 private:
+    void dumpSamrai_(RestartsProperties const& properties, std::string const& directory,
+                     double timeStep);
+
+    void dumpLevels_(RestartsProperties const& properties, std::string const& directory,
+                     double timestamp, double timeStep);
+
+    void writeLevel_(hdf5::h5::HighFiveFile& h5File, int iLevel);
+
+
     std::string const path_;
-    ModelView const modelView_;
+    std::string const format_;
+    ModelView modelView_;
 };
 
 
 
+template<typename ModelView>
+void Writer<ModelView>::dumpSamrai_(RestartsProperties const& properties,
+                                    std::string const& directory, double const timeStep)
+{
+    auto restart_file = modelView_.writeRestartFile(directory);
+
+    // write model patch_data_ids to file with highfive
+    // SAMRAI restart files are PER RANK
+    PHARE::hdf5::h5::HighFiveFile h5File{restart_file, HighFive::File::ReadWrite,
+                                         /*para=*/false};
+
+    auto patch_ids = modelView_.patch_data_ids();
+    h5File.create_data_set<int>("/phare/patch/ids", patch_ids.size());
+    h5File.write_data_set("/phare/patch/ids", patch_ids);
+
+    h5File.write_attribute(
+        "/phare", "serialized_simulation",
+        properties.fileAttributes["serialized_simulation"].template to<std::string>());
+    h5File.write_attribute("/phare", "time_step", timeStep);
+}
+
+
+
+template<typename ModelView>
+void Writer<ModelView>::dumpLevels_(RestartsProperties const& properties,
+                                    std::string const& directory, double timestamp,
+                                    double const timeStep)
+{
+    // only the first process creates the directory, others wait for it
+    SAMRAI::tbox::Utilities::recursiveMkdir(directory);
+
+    // floating point datasets are created in double precision, the default of the file
+    PHARE::hdf5::h5::HighFiveFile h5File{
+        phareRestartFile(directory),
+        HighFive::File::ReadWrite | HighFive::File::Create | HighFive::File::Truncate};
+
+    for (int iLevel = 0; iLevel < modelView_.nbrLevels(); ++iLevel)
+        writeLevel_(h5File, iLevel);
+
+    h5File.write_attribute(
+        "/", "serialized_simulation",
+        properties.fileAttributes["serialized_simulation"].template to<std::string>());
+    h5File.write_attribute("/", "time", timestamp);
+    h5File.write_attribute("/", "time_step", timeStep);
+    h5File.write_attribute("/", "nbrLevels", modelView_.nbrLevels());
+}
+
+
+
+template<typename ModelView>
+void Writer<ModelView>::writeLevel_(hdf5::h5::HighFiveFile& h5File, int const iLevel)
+{
+    using Packer = core::ParticlePacker<dimension>;
+    using SoA    = core::ContiguousParticles<dimension>;
+
+    auto& ions = modelView_.getIons();
+
+    // datasets are created collectively, names cannot depend on the patches of this process
+    std::vector<std::string> fieldNames;
+    for (auto* vecField : modelView_.getElectromagFields())
+        for (auto& [id, type] : core::Components::componentMap)
+            fieldNames.push_back(vecField->name() + "_" + id);
+
+    // only the sizes of the patches are gathered first, the data of each patch is then written
+    // straight at its offset in the datasets of the level
+    std::vector<int> boxes;
+    std::vector<std::size_t> fieldSizes(fieldNames.size(), 0);
+    std::vector<std::vector<std::size_t>> counts(ions.nbrPopulations());
+
+    auto sizePatch = [&](GridLayout& layout, std::string const&, std::size_t) {
+        auto const& box = layout.AMRBox();
+        for (auto const& bound : {box.lower, box.upper})
+            for (std::size_t iDim = 0; iDim < dimension; ++iDim)
+                boxes.push_back(bound[iDim]);
+
+        std::size_t iField = 0;
+        for (auto* vecField : modelView_.getElectromagFields())
+            for (auto& [id, type] : core::Components::componentMap)
+                fieldSizes[iField++] += vecField->getComponent(type).size();
+
+        std::size_t iPop = 0;
+        for (auto& pop : ions)
+            counts[iPop++].push_back(pop.domainParticles().size());
+    };
+    modelView_.visitLevel(iLevel, sizePatch);
+
+    // first element of this process in a dataset, processes being in rank order, and the size of
+    // the dataset
+    auto offsetAndTotal = [](std::size_t const size) {
+        auto const sizes = core::mpi::collect(size);
+        auto const rank  = static_cast<std::size_t>(core::mpi::rank());
+        return std::make_pair(std::accumulate(sizes.begin(), sizes.begin() + rank, std::size_t{0}),
+                              std::accumulate(sizes.begin(), sizes.end(), std::size_t{0}));
+    };
+
+    std::string const levelPath = "/levels/L" + std::to_string(iLevel) + "/";
+    auto popPath = [&](auto const& pop) { return levelPath + "particles/" + pop.name() + "/"; };
+
+    h5File.write_data_set_concatenated(levelPath + "boxes", boxes, 2 * dimension);
+
+    std::vector<std::size_t> fieldOffsets;
+    for (std::size_t iField = 0; iField < fieldNames.size(); ++iField)
+    {
+        auto const [offset, total] = offsetAndTotal(fieldSizes[iField]);
+        h5File.create_data_set<double>(levelPath + "fields/" + fieldNames[iField], total);
+        fieldOffsets.push_back(offset);
+    }
+
+    std::array<std::size_t, 5> const rowSizes{1, 1, dimension, dimension, 3};
+    SoA const noParticles{0};
+    std::vector<std::size_t> particleOffsets;
+    std::size_t iPop = 0;
+    for (auto& pop : ions)
+    {
+        h5File.write_data_set_concatenated(popPath(pop) + "counts", counts[iPop]);
+
+        auto const [offset, total] = offsetAndTotal(
+            std::accumulate(counts[iPop].begin(), counts[iPop].end(), std::size_t{0}));
+        auto const nbrParticles = total; // structured bindings cannot be captured
+
+        std::size_t iKey = 0;
+        core::apply(noParticles.as_tuple(), [&](auto const& data) {
+            using Value = typename std::decay_t<decltype(data)>::value_type;
+            auto const dims
+                = rowSizes[iKey] > 1 ? std::vector<std::size_t>{nbrParticles, rowSizes[iKey]}
+                                     : std::vector<std::size_t>{nbrParticles};
+            h5File.create_data_set<Value>(popPath(pop) + Packer::keys()[iKey], dims);
+            ++iKey;
+        });
+        particleOffsets.push_back(offset);
+        ++iPop;
+    }
+
+    auto writePatch = [&](GridLayout&, std::string const&, std::size_t) {
+        std::size_t iField = 0;
+        for (auto* vecField : modelView_.getElectromagFields())
+            for (auto& [id, type] : core::Components::componentMap)
+            {
+                auto& field = vecField->getComponent(type);
+                h5File.write_data_set_rows(levelPath + "fields/" + fieldNames[iField],
+                                           field.data(), fieldOffsets[iField], field.size(), 1);
+                fieldOffsets[iField++] += field.size();
+            }
+
+        std::size_t iPop = 0;
+        for (auto& pop : ions)
+        {
+            auto& domain = pop.domainParticles();
+            hdf5::ParticleWriter::write(h5File, domain, popPath(pop), nullptr,
+                                        particleOffsets[iPop]);
+            particleOffsets[iPop++] += domain.size();
+        }
+    };
+    modelView_.visitLevel(iLevel, writePatch);
+}
+
+
+
 } // namespace PHARE::restarts::h5
 
 #endif /* PHARE_DETAIL_RESTART_HIGHFIVE_H */
@@ -17,6 +17,7 @@
 
 #include "restarts_model_view.hpp"
 #include "restarts/detail/h5writer.hpp"
+#include "restarts/detail/h5loader.hpp"
 
 #endif
 
@@ -39,6 +40,19 @@ struct RestartsManagerResolver
 #if PHARE_HAS_HIGHFIVE
         using ModelView_t = ModelView<Hierarchy, Model>;
         using Writer_t    = h5::Writer<ModelView_t>;
+        using Loader_t    = h5::Loader<ModelView_t>;
+
+        // levels are filled from the file as they are initialized, until the simulator drops
+        // the loader once the hierarchy is complete
+        if (dict.contains("loadPath") and dict.contains("format")
+            and dict["format"].template to<std::string>() == "phareh5")
+        {
+            auto loader = std::make_shared<Loader_t>(
+                hier, model, dict["loadPath"].template to<std::string>());
+            model.restartLoader = [loader](auto& level) { loader->load(level); };
+            model.restartCovers = [loader](auto& level) { return loader->covers(level); };
+        }
+
         return RestartsManager<Writer_t>::make_unique(hier, model, dict);
 #else
         return std::make_unique<NullOpRestartsManager>();
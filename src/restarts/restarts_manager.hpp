@@ -4,6 +4,7 @@
 
 #include "core/logger.hpp"
 #include "core/data/particles/particle_array.hpp"
+#include "core/utilities/timestamps.hpp"
 
 #include "initializer/data_provider.hpp"
 
@@ -13,6 +14,7 @@
 #include <cmath>
 #include <memory>
 #include <utility>
+#include <vector>
 
 
 
@@ -21,7 +23,13 @@ namespace PHARE::restarts
 class IRestartsManager
 {
 public:
+    //! writes a restart if timeStamp is one of the restart timestamps, timeStep is the time step
+    //! the simulation resumes with from it
     virtual void dump(double timeStamp, double timeStep) = 0;
+
+    //! the timestamps at which restart files are written
+    virtual std::vector<double> timestamps() const { return {}; }
+
     inline virtual ~IRestartsManager();
 };
 IRestartsManager::~IRestartsManager() {}
@@ -60,6 +68,13 @@ public:
     RestartsManager& addRestartDict(initializer::PHAREDict&& dict) { return addRestartDict(dict); }
 
 
+    std::vector<double> timestamps() const override
+    {
+        return restarts_properties_ ? restarts_properties_->writeTimestamps
+                                    : std::vector<double>{};
+    }
+
+
     Writer& writer() { return *writer_.get(); }
 
 
@@ -69,10 +84,10 @@ public:
     RestartsManager& operator=(RestartsManager&&) = delete;
 
 private:
-    bool needsAction_(double nextTime, double timeStamp, double timeStep)
+    bool needsAction_(double nextTime, double timeStamp, double /*timeStep*/)
     {
-        // casting to float to truncate double to avoid trailing imprecision
-        return static_cast<float>(std::abs(nextTime - timeStamp)) < static_cast<float>(timeStep);
+        // time steps land on timestamps, up to rounding errors
+        return core::isOnLandmark(timeStamp, nextTime);
     }
 
 
@@ -122,7 +137,7 @@ void RestartsManager<Writer>::dump(double timeStamp, double timeStep)
 
     if (needsWrite_(*restarts_properties_, timeStamp, timeStep))
     {
-        writer_->dump(*restarts_properties_, timeStamp);
+        writer_->dump(*restarts_properties_, timeStamp, timeStep);
         ++nextWrite_;
     }
 }
@@ -6,6 +6,7 @@
 
 #include "core/utilities/mpi_utils.hpp"
 #include "amr/physical_models/hybrid_model.hpp"
+#include "amr/resources_manager/amr_utils.hpp"
 #include "hdf5/phare_hdf5.hpp"
 
 
@@ -27,8 +28,13 @@ bool constexpr is_hybrid_model
 template<typename Hierarchy, typename Model, std::enable_if_t<is_hybrid_model<Model>, int> = 0>
 class ModelView : public IModelView
 {
+    using VecField = typename Model::vecfield_type;
+
 public:
-    ModelView(Hierarchy const& hierarchy, Model const& model)
+    using GridLayout                = typename Model::gridlayout_type;
+    static constexpr auto dimension = Model::dimension;
+
+    ModelView(Hierarchy& hierarchy, Model& model)
         : model_{model}
         , hierarchy_{hierarchy}
     {
@@ -50,14 +56,39 @@ public:
     auto patch_data_ids() const { return model_.patch_data_ids(); }
 
 
+    std::vector<VecField*> getElectromagFields() const
+    {
+        return {&model_.state.electromag.B, &model_.state.electromag.E};
+    }
+
+    auto& getIons() const { return model_.state.ions; }
+
+    int nbrLevels() const { return hierarchy_.getNumberOfLevels(); }
+
+
+    template<typename Action>
+    void visitLevel(int const iLevel, Action&& action)
+    {
+        amr::visitHierarchy<GridLayout>(hierarchy_, *model_.resourcesManager,
+                                        std::forward<Action>(action), iLevel, iLevel, model_);
+    }
+
+    template<typename Action>
+    void visitLevel(typename Model::level_t& level, Action&& action)
+    {
+        amr::visitLevel<GridLayout>(level, *model_.resourcesManager, std::forward<Action>(action),
+                                    model_);
+    }
+
+
     ModelView(ModelView const&) = delete;
     ModelView(ModelView&&)      = delete;
     ModelView& operator=(ModelView const&) = delete;
     ModelView& operator=(ModelView&&) = delete;
 
 protected:
-    Model const& model_;
-    Hierarchy const& hierarchy_;
+    Model& model_;
+    Hierarchy& hierarchy_;
 };
 
 
@@ -18,6 +18,13 @@ struct RestartsProperties
     FileAttributes fileAttributes{};
 };
 
+
+//! the file of a restart directory, for the "phareh5" restart format
+inline std::string phareRestartFile(std::string const& directory)
+{
+    return directory + "/restart.h5";
+}
+
 } // namespace PHARE::restarts
 
 #endif // RESTART_DAO_HPP
@@ -67,7 +67,9 @@ public:
     {
         if (rMan)
         {
-            rMan->dump(timestamp, timestep);
+            // an adaptive time stepping resumes from its time step before it is shortened to
+            // land on a timestamp
+            rMan->dump(timestamp, timeStamper->restartTimeStep());
         }
 
         if (dMan)
@@ -144,6 +146,14 @@ private:
     std::vector<PHARE::amr::MessengerDescriptor> descriptors_;
     MessengerFactory messengerFactory_;
 
+    static amr::FieldStreamEncoding ghost_stream_encoding(initializer::PHAREDict const& amrDict)
+    {
+        if (amrDict.contains("ghost_stream_encoding"))
+            return amr::fieldStreamEncoding(
+                amrDict["ghost_stream_encoding"].template to<std::string>());
+        return amr::FieldStreamEncoding::Double;
+    }
+
     float x_lo_[dimension];
     float x_up_[dimension];
     int maxLevelNumber_;
@@ -177,6 +187,7 @@ private:
     double restarts_init(initializer::PHAREDict const&);
     void diagnostics_init(initializer::PHAREDict const&);
     void hybrid_init(initializer::PHAREDict const&);
+    std::vector<double> timeLandmarks_() const;
 };
 
 
@@ -258,8 +269,12 @@ void Simulator<dim, _interp, nbRefinedPart>::hybrid_init(initializer::PHAREDict
 
     multiphysInteg_->registerAndSetupMessengers(messengerFactory_);
 
-    // hard coded for now, should get some params later from the dict
-    auto hybridTagger_ = amr::TaggerFactory<PHARETypes>::make("HybridModel", "default");
+    auto const& refinementDict = dict["simulation"]["AMR"]["refinement"];
+    auto const taggingParams   = refinementDict.contains("tagging")
+                                   ? amr::taggingParams(refinementDict["tagging"])
+                                   : amr::TaggingParams{};
+    auto hybridTagger_
+        = amr::TaggerFactory<PHARETypes>::make("HybridModel", "default", taggingParams);
     multiphysInteg_->registerTagger(0, maxLevelNumber_ - 1, std::move(hybridTagger_));
 
     if (dict["simulation"].contains("restarts"))
@@ -268,10 +283,35 @@ void Simulator<dim, _interp, nbRefinedPart>::hybrid_init(initializer::PHAREDict
     integrator_ = std::make_unique<Integrator>(dict, hierarchy_, multiphysInteg_, multiphysInteg_,
                                                startTime_, finalTime_);
 
-    timeStamper = core::TimeStamperFactory::create(dict["simulation"]);
-
     if (dict["simulation"].contains("diagnostics"))
         diagnostics_init(dict["simulation"]["diagnostics"]);
+
+    timeStamper = core::TimeStamperFactory::create(dict["simulation"], timeLandmarks_());
+    dt_         = timeStamper->timeStep();
+    multiphysInteg_->enableStableTimeStep(timeStamper->adaptive());
+}
+
+
+
+/**
+ * returns the times, relative to the start time, on which an adaptive time stepping has to land:
+ * diagnostic and restart timestamps, and the final time
+ */
+template<std::size_t dim, std::size_t _interp, std::size_t nbRefinedPart>
+std::vector<double> Simulator<dim, _interp, nbRefinedPart>::timeLandmarks_() const
+{
+    std::vector<double> timestamps{finalTime_};
+    for (auto const& manager_timestamps :
+         {dMan ? dMan->timestamps() : std::vector<double>{},
+          rMan ? rMan->timestamps() : std::vector<double>{}})
+        timestamps.insert(std::end(timestamps), std::begin(manager_timestamps),
+                          std::end(manager_timestamps));
+
+    std::vector<double> landmarks;
+    for (auto const& timestamp : timestamps)
+        if (timestamp > startTime_)
+            landmarks.push_back(timestamp - startTime_);
+    return landmarks;
 }
 
 
@@ -284,7 +324,7 @@ Simulator<_dimension, _interp_order, _nbRefinedPart>::Simulator(
     , hierarchy_{hierarchy}
     , modelNames_{"HybridModel"}
     , descriptors_{PHARE::amr::makeDescriptors(modelNames_)}
-    , messengerFactory_{descriptors_}
+    , messengerFactory_{descriptors_, ghost_stream_encoding(dict["simulation"]["AMR"])}
     , maxLevelNumber_{dict["simulation"]["AMR"]["max_nbr_levels"].template to<int>()}
     , dt_{dict["simulation"]["time_step"].template to<double>()}
     , timeStepNbr_{dict["simulation"]["time_step_nbr"].template to<int>()}
@@ -351,6 +391,11 @@ void Simulator<_dimension, _interp_order, _nbRefinedPart>::initialize()
 
     if (hierarchy_->isFromRestart())
         hierarchy_->closeRestartFile();
+
+    // levels created from now on are not in the restart, dropping the loader also closes its file
+    // and reports the time spent reading it
+    hybridModel_->restartLoader = nullptr;
+    hybridModel_->restartCovers = nullptr;
 }
 
 
@@ -369,6 +414,9 @@ double Simulator<_dimension, _interp_order, _nbRefinedPart>::advance(double dt)
         PHARE_LOG_SCOPE("Simulator::advance");
         dt_new       = integrator_->advance(dt);
         currentTime_ = startTime_ + ((*timeStamper) += dt);
+
+        if (timeStamper->adaptive())
+            dt_ = timeStamper->updateTimeStep(multiphysInteg_->stableTimeStep(*hierarchy_));
     }
     catch (std::runtime_error const& e)
     {
@@ -8,7 +8,10 @@
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 
+#include <algorithm>
 #include <cassert>
+#include <cmath>
+#include <numeric>
 
 using testing::DoubleEq;
 using testing::DoubleNear;
@@ -346,4 +349,80 @@ TYPED_TEST(FieldCoarsenOperatorTest, doTheExpectedCoarseningForEB)
     }
 }
 
+
+
+
+template<typename dimType>
+struct aFieldCoarsener : public testing::Test
+{
+};
+
+using FieldCoarsenerDims = testing::Types<DimConst<1>, DimConst<2>, DimConst<3>>;
+
+TYPED_TEST_SUITE(aFieldCoarsener, FieldCoarsenerDims);
+
+
+TYPED_TEST(aFieldCoarsener, coarsensBoxesAsIndexByIndex)
+{
+    static constexpr auto dim = TypeParam{}();
+    using Field_t             = Field<NdArrayVector<dim>, HybridQuantity::Scalar>;
+
+    SAMRAI::tbox::Dimension dimension{dim};
+    SAMRAI::hier::BlockId blockId{0};
+
+    for (auto centering : {QtyCentering::primal, QtyCentering::dual})
+    {
+        for (int r : {2, 3, 4})
+        {
+            std::array<int, dim> coarseLower, coarseUpper, fineLower, fineUpper, lower, upper;
+            std::array<std::uint32_t, dim> coarseShape, fineShape;
+            for (std::size_t i = 0; i < dim; ++i)
+            {
+                coarseLower[i] = -3;
+                coarseUpper[i] = 8;
+                fineLower[i]   = coarseLower[i] * r - r;
+                fineUpper[i]   = coarseUpper[i] * r + 2 * r;
+                lower[i]       = coarseLower[i] + 1;
+                upper[i]       = coarseUpper[i] - 2;
+                coarseShape[i] = coarseUpper[i] - coarseLower[i] + 1;
+                fineShape[i]   = fineUpper[i] - fineLower[i] + 1;
+            }
+
+            SAMRAI::hier::Box sourceBox{SAMRAI::hier::Index{dimension, fineLower.data()},
+                                        SAMRAI::hier::Index{dimension, fineUpper.data()}, blockId};
+            SAMRAI::hier::Box destinationBox{SAMRAI::hier::Index{dimension, coarseLower.data()},
+                                             SAMRAI::hier::Index{dimension, coarseUpper.data()},
+                                             blockId};
+            SAMRAI::hier::Box box{SAMRAI::hier::Index{dimension, lower.data()},
+                                  SAMRAI::hier::Index{dimension, upper.data()}, blockId};
+
+            Field_t fine{"fine", HybridQuantity::Scalar::rho, fineShape};
+            Field_t byBox{"byBox", HybridQuantity::Scalar::rho, coarseShape};
+            Field_t byIndex{"byIndex", HybridQuantity::Scalar::rho, coarseShape};
+
+            std::iota(std::begin(fine), std::end(fine), 0.);
+            std::transform(std::begin(fine), std::end(fine), std::begin(fine),
+                           [](auto const& v) { return std::cos(v); });
+
+            std::array<QtyCentering, dim> centerings;
+            centerings.fill(centering);
+            SAMRAI::hier::IntVector ratio{dimension, r};
+            FieldCoarsener<dim> coarsener{centerings, sourceBox, destinationBox, ratio};
+
+            coarsener.coarsenBox(fine, byBox, box);
+
+            for (auto const& index : box)
+            {
+                Point<int, dim> coarseIndex;
+                for (std::size_t i = 0; i < dim; ++i)
+                    coarseIndex[i] = index(i);
+                coarsener(fine, byIndex, coarseIndex);
+            }
+
+            for (std::size_t i = 0; i < byBox.size(); ++i)
+                EXPECT_DOUBLE_EQ(byIndex.data()[i], byBox.data()[i]);
+        }
+    }
+}
+
 #endif
@@ -1,5 +1,9 @@
 #include "test_stream_pack_centered_ex.hpp"
 
+#include <cmath>
+#include <memory>
+#include <vector>
+
 using testing::Eq;
 
 using namespace PHARE::core;
@@ -88,9 +92,66 @@ TYPED_TEST_P(AFieldData1DCenteredOnEx, PackStreamARegionWithPeriodicsLikeACellDa
 
 
 
+TYPED_TEST_P(AFieldData1DCenteredOnEx, PackStreamEncodedRoundTripsWithinEncodingError)
+{
+    if (this->mpi.getSize() > 1)
+    {
+        GTEST_SKIP() << "Test Broken for // execution";
+    }
+    auto& param = this->param;
+
+    SAMRAI::hier::Box mask{SAMRAI::hier::Index{this->dim, 6}, SAMRAI::hier::Index{this->dim, 9},
+                           this->blockId};
+    SAMRAI::hier::Transformation transformation{SAMRAI::hier::IntVector::getZero(this->dim)};
+
+    auto overlap = std::dynamic_pointer_cast<FieldOverlap>(
+        param.destinationFieldGeometry->calculateOverlap(*param.sourceFieldGeometry, mask, mask,
+                                                          true, transformation));
+
+    // transfers the source on the overlap with the given encoding, returns the destination
+    auto transfer = [&](FieldStreamEncoding encoding, FieldStreamStats& stats) {
+        auto statsPtr = std::make_shared<FieldStreamStats>();
+        FieldOverlap encodedOverlap{overlap->getDestinationBoxContainer(),
+                                    overlap->getTransformation(), encoding, statsPtr};
+        param.resetValues();
+
+        SAMRAI::tbox::MessageStream stream;
+        param.sourceFieldData->packStream(stream, encodedOverlap);
+        EXPECT_LE(stream.getCurrentSize(),
+                  param.sourceFieldData->getDataStreamSize(encodedOverlap));
+
+        SAMRAI::tbox::MessageStream readStream{stream.getCurrentSize(),
+                                               SAMRAI::tbox::MessageStream::Read,
+                                               stream.getBufferStart()};
+        param.destinationFieldData->unpackStream(readStream, encodedOverlap);
+
+        stats       = *statsPtr;
+        auto& field = param.destinationFieldData->field;
+        return std::vector<double>(field.data(), field.data() + field.size());
+    };
+
+    FieldStreamStats doubleStats, floatStats, deltaStats;
+    auto const expected = transfer(FieldStreamEncoding::Double, doubleStats);
+    auto const floats   = transfer(FieldStreamEncoding::Float, floatStats);
+    auto const deltas   = transfer(FieldStreamEncoding::Delta, deltaStats);
+
+    // the Float error is the float32 rounding error of the values
+    for (std::size_t i = 0; i < expected.size(); ++i)
+        EXPECT_NEAR(expected[i], floats[i], std::abs(expected[i]) * 1e-7);
+    EXPECT_EQ(expected, deltas);
+
+    EXPECT_EQ(doubleStats.rawBytes, floatStats.rawBytes);
+    EXPECT_EQ(doubleStats.rawBytes, 2 * floatStats.wireBytes);
+    EXPECT_EQ(doubleStats.rawBytes, deltaStats.rawBytes);
+    param.resetValues();
+}
+
+
+
 REGISTER_TYPED_TEST_SUITE_P(AFieldData1DCenteredOnEx, PackStreamLikeACellData,
                             PackStreamWithPeriodicsLikeACellData,
-                            PackStreamARegionWithPeriodicsLikeACellData);
+                            PackStreamARegionWithPeriodicsLikeACellData,
+                            PackStreamEncodedRoundTripsWithinEncodingError);
 
 
 INSTANTIATE_TYPED_TEST_SUITE_P(TestWithOrderFrom1To3That, AFieldData1DCenteredOnEx,
@@ -5,6 +5,15 @@
 #include "gtest/gtest.h"
 
 #include "amr/data/field/field_overlap.hpp"
+#include "amr/data/field/field_stream_encoding.hpp"
+#include "amr/data/field/field_stream_plan.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <numeric>
+#include <vector>
 
 
 using namespace PHARE::amr;
@@ -36,6 +45,117 @@ TEST(FieldOverlap, returnsTransformationOffset)
     EXPECT_EQ(sourceOffset, overlap.getSourceOffset());
 }
 
+TEST(FieldOverlap, isDoubleEncodedByDefault)
+{
+    SAMRAI::hier::BoxContainer boxes;
+    auto dim = SAMRAI::tbox::Dimension{1};
+    FieldOverlap overlap{boxes, SAMRAI::hier::Transformation{SAMRAI::hier::IntVector::getOne(dim)}};
+
+    EXPECT_EQ(FieldStreamEncoding::Double, overlap.streamEncoding());
+    EXPECT_EQ(nullptr, overlap.streamStats());
+}
+
+
+TEST(FieldStreamCodec, deltaEncodingIsLosslessAndSmallerOnSmoothData)
+{
+    std::vector<double> values(1000);
+    for (std::size_t i = 0; i < values.size(); ++i)
+        values[i] = 1. + 1e-3 * std::sin(0.01 * i);
+    values[10] = -values[10];
+    values[20] = 0.;
+
+    std::vector<char> encoded;
+    FieldStreamCodec::encodeDelta(values, encoded);
+
+    EXPECT_LT(encoded.size(), values.size() * sizeof(double));
+    EXPECT_LE(encoded.size(),
+              FieldStreamCodec::maxEncodedSize(FieldStreamEncoding::Delta, values.size()));
+
+    std::vector<double> decoded;
+    FieldStreamCodec::decodeDelta(encoded, values.size(), decoded);
+    EXPECT_EQ(values, decoded);
+}
+
+
+TEST(FieldStreamCodec, floatEncodingHalvesTheStream)
+{
+    std::vector<double> values{1., 1. / 3., -2.5e10, 1e-20};
+
+    std::vector<float> encoded;
+    FieldStreamCodec::encodeFloat(values, encoded);
+    EXPECT_EQ(encoded.size() * sizeof(float),
+              FieldStreamCodec::maxEncodedSize(FieldStreamEncoding::Float, values.size()));
+
+    std::vector<double> decoded;
+    FieldStreamCodec::decodeFloat(encoded, decoded);
+    for (std::size_t i = 0; i < values.size(); ++i)
+        EXPECT_NEAR(values[i], decoded[i], std::abs(values[i]) * 1e-7);
+}
+
+
+TEST(FieldStreamPlan, gathersAndScattersBoxesInPackOrder)
+{
+    std::array<std::uint32_t, 3> shape{6, 7, 8};
+    std::vector<double> data(shape[0] * shape[1] * shape[2]);
+    std::iota(std::begin(data), std::end(data), 0.);
+
+    std::array<int, 3> lower0{1, 2, 0}, upper0{3, 4, 7}; // full rows, merged in segments
+    std::array<int, 3> lower1{0, 0, 2}, upper1{0, 6, 3};
+
+    FieldStreamPlan plan;
+    plan.reset({0});
+    plan.addBox(lower0, upper0, shape);
+    plan.addBox(lower1, upper1, shape);
+
+    std::vector<double> expected;
+    for (auto const& [lower, upper] :
+         {std::make_pair(lower0, upper0), std::make_pair(lower1, upper1)})
+        for (int ix = lower[0]; ix <= upper[0]; ++ix)
+            for (int iy = lower[1]; iy <= upper[1]; ++iy)
+                for (int iz = lower[2]; iz <= upper[2]; ++iz)
+                    expected.push_back(data[(ix * shape[1] + iy) * shape[2] + iz]);
+
+    EXPECT_EQ(plan.size, expected.size());
+    EXPECT_EQ(plan.segments.size(), 3 + 7);
+    EXPECT_TRUE(plan.matches({0}));
+
+    plan.gather(data.data());
+    EXPECT_EQ(plan.buffer, expected);
+
+    std::vector<double> scattered(data.size(), -1.);
+    plan.scatter(plan.buffer, scattered.data());
+    for (std::size_t i = 0; i < data.size(); ++i)
+        EXPECT_TRUE(scattered[i] == -1. or scattered[i] == data[i]);
+    EXPECT_EQ(static_cast<std::size_t>(std::count_if(std::begin(scattered), std::end(scattered),
+                                                     [](auto v) { return v >= 0; })),
+              plan.size);
+}
+
+
+TEST(FieldOverlap, keepsOnePlanPerKey)
+{
+    SAMRAI::hier::BoxContainer boxes;
+    auto dim = SAMRAI::tbox::Dimension{1};
+    FieldOverlap overlap{boxes, SAMRAI::hier::Transformation{SAMRAI::hier::IntVector::getOne(dim)}};
+
+    // e.g. two quantities of different centering streamed with the same overlap
+    std::vector<int> primalKey{0, 0, 9, -2, 11}, dualKey{1, 0, 9, -2, 11};
+
+    auto& primalPlan = overlap.packPlan(primalKey);
+    EXPECT_FALSE(primalPlan.matches(primalKey));
+    primalPlan.reset(primalKey);
+    primalPlan.addBox(std::array<int, 1>{0}, std::array<int, 1>{3},
+                      std::array<std::uint32_t, 1>{14});
+
+    auto& dualPlan = overlap.packPlan(dualKey);
+    EXPECT_FALSE(dualPlan.matches(dualKey));
+    EXPECT_EQ(0u, dualPlan.size);
+
+    EXPECT_TRUE(overlap.packPlan(primalKey).matches(primalKey));
+    EXPECT_EQ(4u, overlap.packPlan(primalKey).size);
+    EXPECT_FALSE(overlap.unpackPlan(primalKey).matches(primalKey));
+}
+
 
 int main(int argc, char** argv)
 {
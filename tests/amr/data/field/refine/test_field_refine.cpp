@@ -13,6 +13,8 @@
 #include "test_field_refinement_on_hierarchy.hpp"
 
 
+#include <algorithm>
+#include <cmath>
 #include <functional>
 #include <iostream>
 #include <numeric>
@@ -108,6 +110,72 @@ TYPED_TEST(aFieldRefine, canBeCreated)
 
 
 
+TYPED_TEST(aFieldRefine, refinesBoxesAsIndexByIndex)
+{
+    static constexpr auto dim = TypeParam{}();
+    using FieldT              = Field<NdArrayVector<dim>, HybridQuantity::Scalar>;
+
+    SAMRAI::tbox::Dimension dimension{dim};
+
+    for (auto centering : {QtyCentering::primal, QtyCentering::dual})
+    {
+        for (int r : {2, 3, 4})
+        {
+            std::array<int, dim> coarseLower, coarseUpper, fineLower, fineUpper, lower, upper;
+            std::array<std::uint32_t, dim> coarseShape, fineShape;
+            for (std::size_t i = 0; i < dim; ++i)
+            {
+                coarseLower[i] = -3;
+                coarseUpper[i] = 8;
+                fineLower[i]   = coarseLower[i] * r + r + 1;
+                fineUpper[i]   = coarseUpper[i] * r - r - 1;
+                lower[i]       = fineLower[i] + 2;
+                upper[i]       = fineUpper[i] - 3;
+                coarseShape[i] = coarseUpper[i] - coarseLower[i] + 1;
+                fineShape[i]   = fineUpper[i] - fineLower[i] + 1;
+            }
+
+            SAMRAI::hier::BlockId blockId{0};
+            SAMRAI::hier::Box sourceGhostBox{SAMRAI::hier::Index{dimension, coarseLower.data()},
+                                             SAMRAI::hier::Index{dimension, coarseUpper.data()},
+                                             blockId};
+            SAMRAI::hier::Box destinationGhostBox{SAMRAI::hier::Index{dimension, fineLower.data()},
+                                                  SAMRAI::hier::Index{dimension, fineUpper.data()},
+                                                  blockId};
+            SAMRAI::hier::Box box{SAMRAI::hier::Index{dimension, lower.data()},
+                                  SAMRAI::hier::Index{dimension, upper.data()}, blockId};
+
+            FieldT source{"source", HybridQuantity::Scalar::rho, coarseShape};
+            FieldT byBox{"byBox", HybridQuantity::Scalar::rho, fineShape};
+            FieldT byIndex{"byIndex", HybridQuantity::Scalar::rho, fineShape};
+
+            std::iota(std::begin(source), std::end(source), 0.);
+            std::transform(std::begin(source), std::end(source), std::begin(source),
+                           [](auto const& v) { return std::sin(v); });
+
+            std::array<QtyCentering, dim> centerings;
+            centerings.fill(centering);
+            SAMRAI::hier::IntVector ratio{dimension, r};
+            FieldRefiner<dim> refiner{centerings, destinationGhostBox, sourceGhostBox, ratio};
+
+            refiner.refineBox(source, byBox, box);
+
+            for (auto const& index : box)
+            {
+                Point<int, dim> fineIndex;
+                for (std::size_t i = 0; i < dim; ++i)
+                    fineIndex[i] = index(i);
+                refiner(source, byIndex, fineIndex);
+            }
+
+            for (std::size_t i = 0; i < byBox.size(); ++i)
+                EXPECT_DOUBLE_EQ(byIndex.data()[i], byBox.data()[i]);
+        }
+    }
+}
+
+
+
 
 template<typename dimType>
 struct aFieldLinearRefineIndexesAndWeights : public testing::Test
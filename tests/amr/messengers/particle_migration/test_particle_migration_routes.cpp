@@ -0,0 +1,179 @@
+#include <algorithm>
+#include <vector>
+
+#include "amr/messengers/particle_migration_routes.hpp"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+using namespace PHARE::core;
+using namespace PHARE::amr;
+
+
+
+/* neighborhoods of the patches of rank, as the overlap connector of the level gives them,
+ * periods holds the domain length in each direction, 0 for non periodic directions
+ */
+template<std::size_t dim>
+std::vector<MigrationNeighborhood<dim>>
+neighborhoodsOf(int rank, std::vector<MigrationPatch<dim>> const& patches, int ghostWidth,
+                std::array<int, dim> const& periods)
+{
+    std::vector<std::array<int, dim>> shifts{{}};
+    for (std::size_t iDim = 0; iDim < dim; ++iDim)
+        if (periods[iDim] != 0)
+            for (std::size_t iShift = 0, nbrShifts = shifts.size(); iShift < nbrShifts; ++iShift)
+                for (auto sign : {-1, 1})
+                {
+                    auto shift  = shifts[iShift];
+                    shift[iDim] = sign * periods[iDim];
+                    shifts.push_back(shift);
+                }
+
+    std::vector<MigrationNeighborhood<dim>> neighborhoods;
+    for (auto const& local : patches)
+    {
+        if (local.rank != rank)
+            continue;
+
+        auto& neighborhood = neighborhoods.emplace_back();
+        neighborhood.patch = local;
+        for (auto const& patch : patches)
+            for (auto const& shift : shifts)
+            {
+                auto image{patch};
+                for (std::size_t iDim = 0; iDim < dim; ++iDim)
+                {
+                    image.box.lower[iDim] += shift[iDim];
+                    image.box.upper[iDim] += shift[iDim];
+                }
+                if (image.box * grow(local.box, ghostWidth))
+                    neighborhood.neighbors.push_back({image, shift});
+            }
+    }
+    return neighborhoods;
+}
+
+
+template<std::size_t dim>
+auto routesBetween(std::vector<MigrationRoute<dim>> const& routes, int src, int dest)
+{
+    std::vector<MigrationRoute<dim>> selected;
+    std::copy_if(std::begin(routes), std::end(routes), std::back_inserter(selected),
+                 [&](auto const& r) { return r.srcRank == src and r.destRank == dest; });
+    return selected;
+}
+
+
+
+TEST(MigrationRoutes, selectSourceDomainCellsInDestinationGhostLayer)
+{
+    // two patches side by side on two ranks, non periodic
+    std::vector<MigrationPatch<1>> patches{{1, 0, Box<int, 1>{{5}, {9}}},
+                                           {0, 0, Box<int, 1>{{0}, {4}}}};
+
+    auto routes = makeMigrationRoutes<1>(0, neighborhoodsOf<1>(0, patches, 2, {0}), 2);
+
+    ASSERT_EQ(2u, routes.size());
+
+    // ordered by source patch, rank 0 first
+    EXPECT_EQ(0, routes[0].srcRank);
+    EXPECT_EQ(1, routes[0].destRank);
+    EXPECT_EQ((Box<int, 1>{{3}, {4}}), routes[0].selectionBox);
+    EXPECT_EQ((std::array<int, 1>{0}), routes[0].offset);
+
+    EXPECT_EQ(1, routes[1].srcRank);
+    EXPECT_EQ(0, routes[1].destRank);
+    EXPECT_EQ((Box<int, 1>{{5}, {6}}), routes[1].selectionBox);
+}
+
+
+
+TEST(MigrationRoutes, includePeriodicNeighborsWithTheirOffset)
+{
+    // a single patch covering a periodic domain is its own neighbor on both sides
+    std::vector<MigrationPatch<1>> patches{{0, 0, Box<int, 1>{{0}, {9}}}};
+
+    auto routes = makeMigrationRoutes<1>(0, neighborhoodsOf<1>(0, patches, 2, {10}), 2);
+
+    ASSERT_EQ(2u, routes.size());
+    for (auto const& route : routes)
+    {
+        EXPECT_EQ(route.srcLocalId, route.destLocalId);
+
+        // selected cells, once shifted, are in the ghost layer of the destination
+        auto lower = route.selectionBox.lower[0] + route.offset[0];
+        auto upper = route.selectionBox.upper[0] + route.offset[0];
+        EXPECT_TRUE((lower == -2 and upper == -1) or (lower == 10 and upper == 11));
+    }
+}
+
+
+
+TEST(MigrationRoutes, areFoundAlikeByTheSendingAndTheReceivingRanks)
+{
+    std::vector<MigrationPatch<2>> patches{{0, 0, Box<int, 2>{{0, 0}, {4, 4}}},
+                                           {0, 1, Box<int, 2>{{5, 0}, {9, 4}}},
+                                           {1, 0, Box<int, 2>{{0, 5}, {4, 9}}},
+                                           {2, 0, Box<int, 2>{{5, 5}, {9, 9}}}};
+    int const nbrRanks = 3;
+
+    std::vector<std::vector<MigrationRoute<2>>> routes;
+    for (int rank = 0; rank < nbrRanks; ++rank)
+        routes.push_back(
+            makeMigrationRoutes<2>(rank, neighborhoodsOf<2>(rank, patches, 1, {10, 10}), 1));
+
+    for (int src = 0; src < nbrRanks; ++src)
+        for (int dest = 0; dest < nbrRanks; ++dest)
+        {
+            auto const sent     = routesBetween(routes[src], src, dest);
+            auto const received = routesBetween(routes[dest], src, dest);
+
+            ASSERT_EQ(sent.size(), received.size());
+            for (std::size_t i = 0; i < sent.size(); ++i)
+            {
+                EXPECT_EQ(sent[i].srcLocalId, received[i].srcLocalId);
+                EXPECT_EQ(sent[i].destLocalId, received[i].destLocalId);
+                EXPECT_EQ(sent[i].selectionBox, received[i].selectionBox);
+                EXPECT_EQ(sent[i].offset, received[i].offset);
+            }
+        }
+
+    // each ghost cell of each patch is covered exactly once
+    for (auto const& patch : patches)
+    {
+        std::size_t nbrGhostCells = 0;
+        for (auto const& route : routes[patch.rank])
+            if (route.destRank == patch.rank and route.destLocalId == patch.localId)
+                nbrGhostCells += route.selectionBox.size();
+        EXPECT_EQ(grow(patch.box, 1).size() - patch.box.size(), nbrGhostCells);
+    }
+}
+
+
+
+TEST(MigrationRoutes, onlyConcernTheLocalPatches)
+{
+    std::vector<MigrationPatch<1>> patches{{0, 0, Box<int, 1>{{0}, {4}}},
+                                           {1, 0, Box<int, 1>{{5}, {9}}},
+                                           {2, 0, Box<int, 1>{{10}, {14}}},
+                                           {3, 0, Box<int, 1>{{15}, {19}}}};
+
+    auto routes = makeMigrationRoutes<1>(1, neighborhoodsOf<1>(1, patches, 2, {0}), 2);
+
+    ASSERT_EQ(4u, routes.size());
+    for (auto const& route : routes)
+    {
+        EXPECT_TRUE(route.srcRank == 1 or route.destRank == 1);
+        EXPECT_TRUE(route.srcRank != 3 and route.destRank != 3);
+    }
+}
+
+
+
+int main(int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+
+    return RUN_ALL_TESTS();
+}
@@ -45,14 +45,21 @@ private:
     std::shared_ptr<HybridModel> model_;
     std::shared_ptr<SolverPPC<HybridModel, SAMRAI_Types>> solver_;
     std::shared_ptr<HybridMessenger<HybridModel>> messenger_;
+    bool fromRestart_;
 
 public:
+    /** with fromRestart, B is set on each new level as a restart file would load it, and the
+     *  finer levels only get their level ghost particles from the coarser one, as levels a
+     *  phareh5 restart covers entirely
+     */
     explicit TagStrategy(std::shared_ptr<HybridModel> model,
                          std::shared_ptr<SolverPPC<HybridModel, SAMRAI_Types>> solver,
-                         std::shared_ptr<HybridMessenger<HybridModel>> messenger)
+                         std::shared_ptr<HybridMessenger<HybridModel>> messenger,
+                         bool const fromRestart = false)
         : model_{std::move(model)}
         , solver_{std::move(solver)}
         , messenger_{std::move(messenger)}
+        , fromRestart_{fromRestart}
     {
         auto infoFromFiner   = messenger_->emptyInfoFromFiner();
         auto infoFromCoarser = messenger_->emptyInfoFromCoarser();
@@ -95,12 +102,20 @@ public:
 
         else // we're creating a brand new finest level in the hierarchy
         {
+            if (fromRestart_)
+                loadMagnetic_(*level);
+
             if (levelNumber == 0)
             {
                 model_->initialize(*level);
                 messenger_->fillRootGhosts(*model_, *level, initDataTime);
             }
 
+            else if (fromRestart_)
+            {
+                messenger_->initLevelGhostParticles(*model_, *level, initDataTime);
+            }
+
             else
             {
                 messenger_->initLevel(*model_, *level, initDataTime);
@@ -135,6 +150,20 @@ public:
     static double fillInt([[maybe_unused]] double x) { return 1.; }
 
 private:
+    void loadMagnetic_(SAMRAI::hier::PatchLevel& level)
+    {
+        auto& B = model_->state.electromag.B;
+
+        for (auto& patch : level)
+        {
+            auto _      = model_->resourcesManager->setOnPatch(*patch, B);
+            auto layout = layoutFromPatch<typename HybridModel::gridlayout_type>(*patch);
+
+            fillField(B.getComponent(Component::X), layout, fillBx);
+            fillField(B.getComponent(Component::Y), layout, fillBy);
+            fillField(B.getComponent(Component::Z), layout, fillBz);
+        }
+    }
 };
 
 #endif
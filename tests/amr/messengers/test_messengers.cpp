@@ -31,7 +31,7 @@ template<>
 struct DimDict<1>
 {
     static constexpr uint8_t dim = 1;
-    static void set(PHARE::initializer::PHAREDict& dict)
+    static void set(PHARE::initializer::PHAREDict& dict, bool const withMagneticInit)
     {
         using namespace PHARE::initializer::test_fn::func_1d; // density/etc are here
 
@@ -79,12 +79,15 @@ struct DimDict<1>
         dict["ions"]["pop1"]["particle_initializer"]["thermal_velocity_z"]
             = static_cast<InitFunctionT<dim>>(vthz);
 
-        dict["electromag"]["magnetic"]["initializer"]["x_component"]
-            = static_cast<InitFunctionT<dim>>(bx);
-        dict["electromag"]["magnetic"]["initializer"]["y_component"]
-            = static_cast<InitFunctionT<dim>>(by);
-        dict["electromag"]["magnetic"]["initializer"]["z_component"]
-            = static_cast<InitFunctionT<dim>>(bz);
+        if (withMagneticInit)
+        {
+            dict["electromag"]["magnetic"]["initializer"]["x_component"]
+                = static_cast<InitFunctionT<dim>>(bx);
+            dict["electromag"]["magnetic"]["initializer"]["y_component"]
+                = static_cast<InitFunctionT<dim>>(by);
+            dict["electromag"]["magnetic"]["initializer"]["z_component"]
+                = static_cast<InitFunctionT<dim>>(bz);
+        }
 
         dict["simulation"]["algo"]["ion_updater"]["pusher"]["name"] = std::string{"modified_boris"};
     }
@@ -97,7 +100,7 @@ template<>
 struct DimDict<2>
 {
     static constexpr uint8_t dim = 2;
-    static void set(PHARE::initializer::PHAREDict& dict)
+    static void set(PHARE::initializer::PHAREDict& dict, bool const withMagneticInit)
     {
         using namespace PHARE::initializer::test_fn::func_2d; // density/etc are here
         dict["simulation"]["algo"]["pusher"]["name"] = std::string{"modified_boris"};
@@ -144,19 +147,23 @@ struct DimDict<2>
         dict["ions"]["pop1"]["particle_initializer"]["thermal_velocity_z"]
             = static_cast<InitFunctionT<dim>>(vthz);
 
-        dict["electromag"]["magnetic"]["initializer"]["x_component"]
-            = static_cast<InitFunctionT<dim>>(bx);
-        dict["electromag"]["magnetic"]["initializer"]["y_component"]
-            = static_cast<InitFunctionT<dim>>(by);
-        dict["electromag"]["magnetic"]["initializer"]["z_component"]
-            = static_cast<InitFunctionT<dim>>(bz);
+        if (withMagneticInit)
+        {
+            dict["electromag"]["magnetic"]["initializer"]["x_component"]
+                = static_cast<InitFunctionT<dim>>(bx);
+            dict["electromag"]["magnetic"]["initializer"]["y_component"]
+                = static_cast<InitFunctionT<dim>>(by);
+            dict["electromag"]["magnetic"]["initializer"]["z_component"]
+                = static_cast<InitFunctionT<dim>>(bz);
+        }
 
         dict["simulation"]["algo"]["ion_updater"]["pusher"]["name"] = std::string{"modified_boris"};
     }
 };
 
+// phareh5 restarts load B from the restart file and give no magnetic initializer
 template<uint8_t dimension = 1>
-PHARE::initializer::PHAREDict createDict()
+PHARE::initializer::PHAREDict createDict(bool const withMagneticInit = true)
 {
     PHARE::initializer::PHAREDict dict;
 
@@ -190,7 +197,7 @@ PHARE::initializer::PHAREDict createDict()
     dict["electrons"]["pressure_closure"]["Te"]   = 0.12;
 
 
-    DimDict<dimension>::set(dict);
+    DimDict<dimension>::set(dict, withMagneticInit);
 
     return dict;
 }
@@ -454,6 +461,7 @@ struct AfullHybridBasicHierarchy
     using ResourcesManagerT = typename HybridModelT::resources_manager_type;
     using Phare_Types       = PHARE::PHARE_Types<dimension, interpOrder, nbRefinePart>;
 
+    bool const fromRestart;
     int const firstHybLevel{0};
     int const ratio{2};
 
@@ -462,7 +470,7 @@ struct AfullHybridBasicHierarchy
 
     SAMRAI::tbox::SAMRAI_MPI mpi{MPI_COMM_WORLD};
 
-    PHARE::initializer::PHAREDict dict{createDict<dimension>()};
+    PHARE::initializer::PHAREDict dict{createDict<dimension>(/*withMagneticInit=*/!fromRestart)};
 
     std::shared_ptr<ResourcesManagerT> resourcesManagerHybrid{
         std::make_shared<ResourcesManagerT>()};
@@ -490,13 +498,15 @@ struct AfullHybridBasicHierarchy
 
     std::shared_ptr<BasicHierarchy> basicHierarchy;
 
-    AfullHybridBasicHierarchy()
+    explicit AfullHybridBasicHierarchy(bool const fromRestart_ = false)
+        : fromRestart{fromRestart_}
     {
         hybridModel->resourcesManager->registerResources(hybridModel->state);
 
         solver->registerResources(*hybridModel);
 
-        tagStrat   = std::make_shared<TagStrategy<HybridModelT>>(hybridModel, solver, messenger);
+        tagStrat   = std::make_shared<TagStrategy<HybridModelT>>(hybridModel, solver, messenger,
+                                                                 fromRestart);
         integrator = std::make_shared<TestIntegratorStrat>();
         basicHierarchy
             = std::make_shared<BasicHierarchy>(ratio, dimension, tagStrat.get(), integrator);
@@ -508,6 +518,93 @@ struct AfullHybridBasicHierarchy
 
 
 
+TEST(ASubcyclingLevel, interpolatesCoarserMomentsAtTheEndOfEachSubstep)
+{
+    using PHARE::amr::subcycleTimeInterpCoef;
+
+    // equal substeps, the first one ends at 1/ratio of the coarser step, the next ones further
+    EXPECT_DOUBLE_EQ(0.25, subcycleTimeInterpCoef(1., 2., 1.25));
+    EXPECT_DOUBLE_EQ(0.5, subcycleTimeInterpCoef(1., 2., 1.5));
+    EXPECT_DOUBLE_EQ(1., subcycleTimeInterpCoef(1., 2., 2.));
+
+    // substeps of an adaptive time refinement need not be equal
+    EXPECT_DOUBLE_EQ(0.1, subcycleTimeInterpCoef(0., 2., 0.2));
+    EXPECT_DOUBLE_EQ(0.7, subcycleTimeInterpCoef(0., 2., 1.4));
+
+    // the substeps may sum to slightly more than the coarser time step
+    double time = 1.;
+    for (auto iStep = 0; iStep < 10; ++iStep)
+        time += 0.1;
+    EXPECT_EQ(1., subcycleTimeInterpCoef(1., 2., time));
+    EXPECT_EQ(1., subcycleTimeInterpCoef(0., 1., 1. + 1e-12));
+    EXPECT_GT(subcycleTimeInterpCoef(0., 1., 1.1), 1.);
+}
+
+
+
+
+TEST(ARestartedHybridHierarchy, keepsItsLoadedFieldsAndGetsOnlyLevelGhostParticlesOnFinerLevels)
+{
+    // no magnetic initializer in the dict, B is set as a restart file would load it
+    AfullHybridBasicHierarchy<1, 2> restarted{/*fromRestart=*/true};
+
+    using HybridModelT = AfullHybridBasicHierarchy<1, 2>::HybridModelT;
+    using GridLayoutT  = HybridModelT::gridlayout_type;
+
+    auto& hierarchy = restarted.basicHierarchy->getHierarchy();
+    auto& model     = *restarted.hybridModel;
+
+    ASSERT_EQ(2, hierarchy.getNumberOfLevels());
+
+    for (auto iLevel = 0; iLevel < hierarchy.getNumberOfLevels(); ++iLevel)
+    {
+        for (auto& patch : *hierarchy.getPatchLevel(iLevel))
+        {
+            auto _      = model.resourcesManager->setOnPatch(*patch, model.state.electromag);
+            auto layout = PHARE::amr::layoutFromPatch<GridLayoutT>(*patch);
+            auto& B     = model.state.electromag.B;
+
+            auto checkMyField = [&layout](auto const& field, auto const& func) {
+                auto iStart = layout.physicalStartIndex(field, Direction::X);
+                auto iEnd   = layout.physicalEndIndex(field, Direction::X);
+
+                for (auto ix = iStart; ix <= iEnd; ++ix)
+                {
+                    auto x = layout.fieldNodeCoordinates(field, layout.origin(), ix);
+                    EXPECT_DOUBLE_EQ(func(x[0]), field(ix));
+                }
+            };
+
+            // the model initialization leaves B as it was loaded
+            checkMyField(B.getComponent(Component::X), TagStrategy<HybridModelT>::fillBx);
+            checkMyField(B.getComponent(Component::Y), TagStrategy<HybridModelT>::fillBy);
+            checkMyField(B.getComponent(Component::Z), TagStrategy<HybridModelT>::fillBz);
+        }
+    }
+
+    for (auto& patch : *hierarchy.getPatchLevel(1))
+    {
+        auto _         = model.resourcesManager->setOnPatch(*patch, model.state.ions);
+        auto domainBox = PHARE::amr::phare_box_from<1>(patch->getBox());
+
+        for (auto& pop : model.state.ions)
+        {
+            // the restart loads the domain particles, none are refined from the coarser level
+            EXPECT_EQ(0u, pop.domainParticles().size());
+            EXPECT_EQ(0u, pop.patchGhostParticles().size());
+
+            EXPECT_GT(pop.levelGhostParticlesOld().size(), 0u);
+            EXPECT_EQ(pop.levelGhostParticlesOld().size(), pop.levelGhostParticles().size());
+
+            for (auto const& particle : pop.levelGhostParticlesOld())
+                EXPECT_FALSE(isIn(cellAsPoint(particle), domainBox));
+        }
+    }
+}
+
+
+
+
 #if 0
 TEST_F(AfullHybridBasicHierarchy, fillsRefinedLevelGhostsAfterRegrid)
 {
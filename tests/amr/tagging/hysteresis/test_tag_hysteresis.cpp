@@ -0,0 +1,69 @@
+
+#include "amr/tagging/tag_hysteresis.hpp"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+using namespace PHARE::amr;
+
+
+
+TEST(TagAge, needsActivateThresholdToBeTaggedAndDeactivateOneToStayTagged)
+{
+    TaggingParams params;
+    params.activateThreshold   = 0.2;
+    params.deactivateThreshold = 0.1;
+
+    int age = 0;
+    EXPECT_FALSE(updateTagAge(0.15, age, params));
+    EXPECT_EQ(0, age);
+
+    EXPECT_TRUE(updateTagAge(0.25, age, params));
+    EXPECT_EQ(1, age);
+
+    EXPECT_TRUE(updateTagAge(0.15, age, params));
+    EXPECT_EQ(2, age);
+
+    EXPECT_FALSE(updateTagAge(0.05, age, params));
+    EXPECT_EQ(0, age);
+}
+
+
+
+TEST(TagAge, staysTaggedForMinLifetime)
+{
+    TaggingParams params;
+    params.minLifetime = 3;
+
+    int age = 0;
+    EXPECT_TRUE(updateTagAge(1., age, params));
+    EXPECT_TRUE(updateTagAge(0., age, params));
+    EXPECT_TRUE(updateTagAge(0., age, params));
+    EXPECT_FALSE(updateTagAge(0., age, params));
+}
+
+
+
+TEST(TaggingParams, rejectDeactivateThresholdAboveActivateOne)
+{
+    TaggingParams params;
+    params.deactivateThreshold = 2 * params.activateThreshold;
+    EXPECT_ANY_THROW(params.validate());
+}
+
+
+
+TEST(TaggingParams, rejectNegativeMinLifetime)
+{
+    TaggingParams params;
+    params.minLifetime = -1;
+    EXPECT_ANY_THROW(params.validate());
+}
+
+
+
+int main(int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,116 @@
+#include "initializer/data_provider.hpp"
+
+#include "core/data/electromag/electromag.hpp"
+#include "core/data/grid/gridlayout.hpp"
+#include "core/data/grid/gridlayout_impl.hpp"
+#include "core/data/vecfield/vecfield.hpp"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#include "tests/initializer/init_functions.hpp"
+
+
+using namespace PHARE::core;
+
+static constexpr std::size_t dim    = 1;
+static constexpr std::size_t interp = 1;
+
+using GridYee    = GridLayout<GridLayoutImplYee<dim, interp>>;
+using VecField1D = VecField<NdArrayVector<dim>, HybridQuantity>;
+using Field1D    = typename VecField1D::field_type;
+
+
+
+PHARE::initializer::PHAREDict createDict(bool const withMagneticInitializer)
+{
+    using InitFunctionT = PHARE::initializer::InitFunction<dim>;
+    using namespace PHARE::initializer::test_fn::func_1d;
+
+    PHARE::initializer::PHAREDict dict;
+    dict["name"]             = std::string{"EM"};
+    dict["electric"]["name"] = std::string{"E"};
+    dict["magnetic"]["name"] = std::string{"B"};
+
+    if (withMagneticInitializer)
+    {
+        dict["magnetic"]["initializer"]["x_component"] = static_cast<InitFunctionT>(bx);
+        dict["magnetic"]["initializer"]["y_component"] = static_cast<InitFunctionT>(by);
+        dict["magnetic"]["initializer"]["z_component"] = static_cast<InitFunctionT>(bz);
+    }
+
+    return dict;
+}
+
+
+
+struct AnElectromag : public ::testing::Test
+{
+    GridYee layout{{{0.1}}, {{50}}, {0.}};
+
+    Field1D Bx{"EM_B_x", HybridQuantity::Scalar::Bx, layout.allocSize(HybridQuantity::Scalar::Bx)};
+    Field1D By{"EM_B_y", HybridQuantity::Scalar::By, layout.allocSize(HybridQuantity::Scalar::By)};
+    Field1D Bz{"EM_B_z", HybridQuantity::Scalar::Bz, layout.allocSize(HybridQuantity::Scalar::Bz)};
+
+    void setB(Electromag<VecField1D>& em)
+    {
+        em.B.setBuffer(Bx.name(), &Bx);
+        em.B.setBuffer(By.name(), &By);
+        em.B.setBuffer(Bz.name(), &Bz);
+    }
+
+    // the test init functions all return x
+    template<typename Expected>
+    void expectB(Expected&& expected)
+    {
+        for (auto* field : {&Bx, &By, &Bz})
+        {
+            auto const iStart = layout.ghostStartIndex(*field, Direction::X);
+            auto const iEnd   = layout.ghostEndIndex(*field, Direction::X);
+
+            for (auto ix = iStart; ix <= iEnd; ++ix)
+            {
+                auto const x = layout.fieldNodeCoordinates(*field, layout.origin(), ix)[0];
+                EXPECT_DOUBLE_EQ(expected(x), (*field)(ix));
+            }
+        }
+    }
+};
+
+
+
+TEST_F(AnElectromag, initializesBWithItsMagneticInitializer)
+{
+    Electromag<VecField1D> em{createDict(true)};
+    setB(em);
+
+    em.initialize(layout);
+
+    expectB([](double x) { return x; });
+}
+
+
+
+TEST_F(AnElectromag, withoutMagneticInitializerLeavesBAsLoaded)
+{
+    Electromag<VecField1D> em{createDict(false)};
+    setB(em);
+
+    // B as a restart would have loaded it before the model is initialized
+    for (auto* field : {&Bx, &By, &Bz})
+        for (auto& v : *field)
+            v = 2.;
+
+    EXPECT_NO_THROW(em.initialize(layout));
+
+    expectB([](double) { return 2.; });
+}
+
+
+
+int main(int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+
+    return RUN_ALL_TESTS();
+}
@@ -63,6 +63,36 @@ TYPED_TEST(ParticleListTest, SoAandAoSInterop)
         EXPECT_EQ(particle, particleArray[i++]);
 }
 
+TYPED_TEST(ParticleListTest, PackedChunkByChunkLikeAtOnce)
+{
+    using Particle             = TypeParam;
+    constexpr auto dim         = Particle::dimension;
+    constexpr std::size_t size = 10, chunkSize = 4;
+    constexpr Box<int, dim> domain{ConstArray<int, dim>(0), ConstArray<int, dim>(size - 1)};
+
+    ParticleArray<dim> particleArray{domain};
+    for (std::size_t i = 0; i < size; i++)
+    {
+        Particle particle;
+        particle.weight = 1 + i;
+        particle.iCell  = ConstArray<int, dim>(i);
+        particle.v      = ConstArray<double, 3>(i);
+        particleArray.push_back(particle);
+    }
+
+    ParticlePacker<dim> packer{particleArray};
+    ContiguousParticles<dim> chunk{chunkSize};
+    std::size_t packed = 0;
+    while (auto const count = packer.pack_next(chunk, chunkSize))
+    {
+        EXPECT_EQ(count, std::min(chunkSize, size - packed));
+        for (std::size_t i = 0; i < count; i++)
+            EXPECT_EQ(chunk[i], particleArray[packed + i]);
+        packed += count;
+    }
+    EXPECT_EQ(packed, size);
+}
+
 int main(int argc, char** argv)
 {
     ::testing::InitGoogleTest(&argc, argv);
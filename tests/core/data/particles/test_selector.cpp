@@ -0,0 +1,115 @@
+#include "core/data/particles/particle.hpp"
+#include "core/data/particles/particle_array.hpp"
+#include "core/data/particles/particle_selector.hpp"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+using namespace PHARE::core;
+
+
+namespace
+{
+constexpr std::size_t dim = 1;
+
+ParticleArray<dim> makeParticles(std::size_t const nbrParticles)
+{
+    ParticleArray<dim> particles{Box<int, dim>{{0}, {99}}};
+    for (std::size_t i = 0; i < nbrParticles; ++i)
+    {
+        Particle<dim> particle;
+        particle.weight = 1.;
+        particle.iCell  = {static_cast<int>(i % 100)};
+        particle.delta  = {0.001 * static_cast<double>(i % 997)};
+        particle.v      = {static_cast<double>(i % 10) - 4.5, 0., 0.};
+        particles.push_back(particle);
+    }
+    return particles;
+}
+} // namespace
+
+
+
+TEST(AParticleSelector, selectsAllParticlesByDefault)
+{
+    ParticleSelector<dim> selector;
+    EXPECT_TRUE(selector.selectsAll());
+    EXPECT_EQ(10u, selector.select(makeParticles(10), 0).size());
+}
+
+
+
+TEST(AParticleSelector, keepsEveryStrideThParticle)
+{
+    ParticleSelector<dim> selector;
+    selector.stride = 3;
+    EXPECT_THAT(selector.select(makeParticles(10), 0), ::testing::ElementsAre(0, 3, 6, 9));
+}
+
+
+
+TEST(AParticleSelector, keepsParticlesOfTheBoxesRefinedForTheLevel)
+{
+    ParticleSelector<dim> selector;
+    selector.boxes.push_back(Box<int, dim>{{5}, {9}});
+
+    auto const particles = makeParticles(100);
+    for (std::size_t level : {0u, 1u})
+    {
+        auto const selection = selector.select(particles, level);
+        EXPECT_EQ(5u * (level + 1), selection.size());
+        for (auto index : selection)
+        {
+            EXPECT_GE(particles[index].iCell[0], 5 * static_cast<int>(level + 1));
+            EXPECT_LE(particles[index].iCell[0], 10 * static_cast<int>(level + 1) - 1);
+        }
+    }
+}
+
+
+
+TEST(AParticleSelector, keepsParticlesWithinTheVelocityCuts)
+{
+    ParticleSelector<dim> selector;
+    selector.vMin[0] = 0.;
+
+    auto const particles = makeParticles(100);
+    auto const selection = selector.select(particles, 0);
+    EXPECT_EQ(50u, selection.size());
+    for (auto index : selection)
+        EXPECT_GE(particles[index].v[0], 0.);
+}
+
+
+
+TEST(AParticleSelector, samplesAFractionIndependentlyOfTheParticleOrder)
+{
+    ParticleSelector<dim> selector;
+    selector.fraction = 0.1;
+
+    auto const particles = makeParticles(10000);
+    auto const selection = selector.select(particles, 0);
+    EXPECT_NEAR(1000., static_cast<double>(selection.size()), 150.);
+
+    ParticleArray<dim> reversed{particles.box()};
+    for (auto it = particles.end(); it != particles.begin();)
+        reversed.push_back(*--it);
+
+    auto const reversedSelection = selector.select(reversed, 0);
+    ASSERT_EQ(selection.size(), reversedSelection.size());
+    for (std::size_t i = 0; i < selection.size(); ++i)
+        EXPECT_EQ(particles[selection[i]],
+                  reversed[reversedSelection[selection.size() - 1 - i]]);
+}
+
+
+
+int main(int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,117 @@
+#include "core/data/particles/particle.hpp"
+#include "core/data/particles/particle_array.hpp"
+#include "core/data/particles/velocity_histogram.hpp"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#include <cstddef>
+#include <numeric>
+#include <vector>
+
+using namespace PHARE::core;
+
+
+namespace
+{
+constexpr std::size_t dim = 1;
+
+ParticleArray<dim> makeParticles(std::size_t const nbrParticles)
+{
+    ParticleArray<dim> particles{Box<int, dim>{{0}, {99}}};
+    for (std::size_t i = 0; i < nbrParticles; ++i)
+    {
+        Particle<dim> particle;
+        particle.weight = 0.5;
+        particle.iCell  = {static_cast<int>(i % 100)};
+        particle.delta  = {0.5};
+        particle.v      = {static_cast<double>(i % 10) - 4.5, 0., 0.};
+        particles.push_back(particle);
+    }
+    return particles;
+}
+
+double total(std::vector<double> const& counts)
+{
+    return std::accumulate(std::begin(counts), std::end(counts), 0.);
+}
+} // namespace
+
+
+
+TEST(AVelocityHistogram, countsTheWeightOfAllParticlesInRange)
+{
+    VelocityHistogram<dim> histogram{{Box<int, dim>{{0}, {99}}}, {10, 1, 1}, {-5, -1, -1},
+                                     {5, 1, 1}};
+    histogram.accumulate(makeParticles(1000), Box<int, dim>{{0}, {99}}, 0);
+
+    EXPECT_THAT(histogram.shape(), ::testing::ElementsAre(1, 10, 1, 1));
+    EXPECT_THAT(histogram.counts(), ::testing::Each(50.));
+}
+
+
+
+TEST(AVelocityHistogram, ignoresParticlesOutOfTheVelocityRange)
+{
+    VelocityHistogram<dim> histogram{{Box<int, dim>{{0}, {99}}}, {2, 1, 1}, {0, -1, -1},
+                                     {4, 1, 1}};
+    histogram.accumulate(makeParticles(1000), Box<int, dim>{{0}, {99}}, 0);
+
+    // v = 0.5, 1.5 in the first bin, 2.5, 3.5 in the second
+    EXPECT_THAT(histogram.counts(), ::testing::ElementsAre(100., 100.));
+}
+
+
+
+TEST(AVelocityHistogram, onlyCountsParticlesOfItsBoxesWithinThePatch)
+{
+    VelocityHistogram<dim> histogram{{Box<int, dim>{{0}, {9}}, Box<int, dim>{{40}, {59}}},
+                                     {1, 1, 1},
+                                     {-5, -1, -1},
+                                     {5, 1, 1}};
+    histogram.accumulate(makeParticles(1000), Box<int, dim>{{0}, {49}}, 0);
+
+    EXPECT_THAT(histogram.counts(), ::testing::ElementsAre(50., 50.));
+}
+
+
+
+TEST(AVelocityHistogram, refinesItsBoxesOnFinerLevels)
+{
+    VelocityHistogram<dim> histogram{{Box<int, dim>{{0}, {9}}}, {1, 1, 1}, {-5, -1, -1}, {5, 1, 1}};
+    histogram.accumulate(makeParticles(1000), Box<int, dim>{{0}, {99}}, 1);
+
+    // level 0 cells [0, 9] are level 1 cells [0, 19]
+    EXPECT_DOUBLE_EQ(100., total(histogram.counts()));
+
+    histogram.reset();
+    EXPECT_DOUBLE_EQ(0., total(histogram.counts()));
+}
+
+
+
+TEST(AVelocityHistogram, givesTheEdgesOfItsBins)
+{
+    VelocityHistogram<dim> histogram{{Box<int, dim>{{0}, {9}}}, {4, 1, 1}, {-2, -1, -1}, {2, 1, 1}};
+    EXPECT_THAT(histogram.edges(0), ::testing::ElementsAre(-2., -1., 0., 1., 2.));
+}
+
+
+
+TEST(AVelocityHistogram, throwsOnInvalidBins)
+{
+    EXPECT_THROW((VelocityHistogram<dim>{{Box<int, dim>{{0}, {9}}}, {0, 1, 1}, {-1, -1, -1},
+                                         {1, 1, 1}}),
+                 std::runtime_error);
+    EXPECT_THROW((VelocityHistogram<dim>{{Box<int, dim>{{0}, {9}}}, {1, 1, 1}, {1, -1, -1},
+                                         {1, 1, 1}}),
+                 std::runtime_error);
+}
+
+
+
+int main(int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -836,6 +836,127 @@ using My2dTypes = ::testing::Types<Interpolator<2, 1>, Interpolator<2, 2>, Inter
 INSTANTIATE_TYPED_TEST_SUITE_P(testInterpolator, ACollectionOfParticles_2d, My2dTypes);
 
 
+
+template<typename Interpolator>
+struct ASetOfParticleRanges : public ::testing::Test
+{
+    static constexpr auto interp_order = Interpolator::interp_order;
+    static constexpr std::size_t dim   = Interpolator::dimension;
+    static constexpr std::uint32_t nx  = 15;
+
+    using PHARE_TYPES               = PHARE::core::PHARE_Types<dim, interp_order>;
+    using NdArray_t                 = typename PHARE_TYPES::Array_t;
+    using ParticleArray_t           = typename PHARE_TYPES::ParticleArray_t;
+    using GridLayout_t              = typename PHARE_TYPES::GridLayout_t;
+    using Field_t                   = Field<NdArray_t, typename HybridQuantity::Scalar>;
+    using VecField_t                = VecField<NdArray_t, HybridQuantity>;
+    constexpr static auto safeLayer = static_cast<int>(1 + ghostWidthForParticles<interp_order>());
+
+    struct Moments
+    {
+        Moments(GridLayout_t const& layout)
+            : rho{"rho", HybridQuantity::Scalar::rho, layout.allocSize(HybridQuantity::Scalar::rho)}
+            , vx{"v_x", HybridQuantity::Scalar::Vx, layout.allocSize(HybridQuantity::Scalar::Vx)}
+            , vy{"v_y", HybridQuantity::Scalar::Vy, layout.allocSize(HybridQuantity::Scalar::Vy)}
+            , vz{"v_z", HybridQuantity::Scalar::Vz, layout.allocSize(HybridQuantity::Scalar::Vz)}
+            , v{"v", HybridQuantity::Vector::V}
+        {
+            v.setBuffer("v_x", &vx);
+            v.setBuffer("v_y", &vy);
+            v.setBuffer("v_z", &vz);
+        }
+
+        Field_t rho, vx, vy, vz;
+        VecField_t v;
+    };
+
+    ASetOfParticleRanges()
+        : patchGhosts{grow(layout.AMRBox(), safeLayer)}
+        , levelGhostsOld{grow(layout.AMRBox(), safeLayer)}
+        , levelGhostsNew{grow(layout.AMRBox(), safeLayer)}
+    {
+        std::mt19937 gen(42);
+        std::uniform_real_distribution<> delta(0, 1), velocity(-1, 1);
+
+        auto fill = [&](auto& particles, int firstCell) {
+            for (int i = firstCell; i < firstCell + 5; ++i)
+            {
+                auto& part  = particles.emplace_back();
+                part.iCell  = ConstArray<int, dim>(i);
+                part.delta  = ConstArray<double, dim>(delta(gen));
+                part.weight = .5 + delta(gen);
+                part.v      = {velocity(gen), velocity(gen), velocity(gen)};
+            }
+        };
+        fill(patchGhosts, 2);
+        fill(levelGhostsOld, 4);
+        fill(levelGhostsNew, 5);
+    }
+
+    GridLayout_t layout{ConstArray<double, dim>(.1), ConstArray<std::uint32_t, dim>(nx),
+                        ConstArray<double, dim>(0)};
+
+    ParticleArray_t patchGhosts, levelGhostsOld, levelGhostsNew;
+    Moments separate{layout}, together{layout};
+    Interpolator interpolator;
+};
+TYPED_TEST_SUITE_P(ASetOfParticleRanges);
+
+
+TYPED_TEST_P(ASetOfParticleRanges, DepositsInOneCallAsInSeparateCalls)
+{
+    double const alpha = .3;
+    auto& sep          = this->separate;
+    auto& tog          = this->together;
+
+    this->interpolator(makeRange(this->patchGhosts), sep.rho, sep.v, this->layout);
+    this->interpolator(makeRange(this->levelGhostsOld), sep.rho, sep.v, this->layout, 1. - alpha);
+    this->interpolator(makeRange(this->levelGhostsNew), sep.rho, sep.v, this->layout, alpha);
+
+    this->interpolator.depositRanges(tog.rho, tog.v, this->layout,
+                                     std::make_pair(makeRange(this->patchGhosts), 1.),
+                                     std::make_pair(makeRange(this->levelGhostsOld), 1. - alpha),
+                                     std::make_pair(makeRange(this->levelGhostsNew), alpha));
+
+    EXPECT_GT(std::accumulate(tog.rho.begin(), tog.rho.end(), 0.), 0.);
+
+    for (auto const& [s, t] : {std::make_pair(&sep.rho, &tog.rho), std::make_pair(&sep.vx, &tog.vx),
+                               std::make_pair(&sep.vy, &tog.vy), std::make_pair(&sep.vz, &tog.vz)})
+        for (std::size_t i = 0; i < s->size(); ++i)
+            EXPECT_NEAR(s->data()[i], t->data()[i], 1e-12);
+}
+
+
+TYPED_TEST_P(ASetOfParticleRanges, LeavesNothingInItsBufferFromOneCallToTheNext)
+{
+    auto& sep = this->separate;
+    auto& tog = this->together;
+
+    this->interpolator(makeRange(this->levelGhostsNew), sep.rho, sep.v, this->layout, .5);
+
+    this->interpolator.depositRanges(tog.rho, tog.v, this->layout,
+                                     std::make_pair(makeRange(this->patchGhosts), 1.));
+    for (auto* field : {&tog.rho, &tog.vx, &tog.vy, &tog.vz})
+        std::fill(field->begin(), field->end(), 0.);
+    this->interpolator.depositRanges(tog.rho, tog.v, this->layout,
+                                     std::make_pair(makeRange(this->levelGhostsNew), .5));
+
+    for (auto const& [s, t] : {std::make_pair(&sep.rho, &tog.rho), std::make_pair(&sep.vx, &tog.vx),
+                               std::make_pair(&sep.vy, &tog.vy), std::make_pair(&sep.vz, &tog.vz)})
+        for (std::size_t i = 0; i < s->size(); ++i)
+            EXPECT_NEAR(s->data()[i], t->data()[i], 1e-12);
+}
+REGISTER_TYPED_TEST_SUITE_P(ASetOfParticleRanges, DepositsInOneCallAsInSeparateCalls,
+                            LeavesNothingInItsBufferFromOneCallToTheNext);
+
+
+using RangeDepositTypes
+    = ::testing::Types<Interpolator<1, 1>, Interpolator<1, 2>, Interpolator<1, 3>,
+                       Interpolator<2, 1>, Interpolator<2, 2>, Interpolator<2, 3>,
+                       Interpolator<3, 1>, Interpolator<3, 2>, Interpolator<3, 3>>;
+INSTANTIATE_TYPED_TEST_SUITE_P(testInterpolator, ASetOfParticleRanges, RangeDepositTypes);
+
+
 int main(int argc, char** argv)
 {
     ::testing::InitGoogleTest(&argc, argv);
@@ -0,0 +1,126 @@
+
+#include <array>
+#include <cmath>
+#include <random>
+
+#include "core/data/particles/particle_array.hpp"
+#include "core/numerics/particle_merger/particle_merger.hpp"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+using namespace PHARE::core;
+
+
+
+struct ParticleMergerTest : public ::testing::Test
+{
+    static constexpr std::size_t dim = 2;
+    using ParticleArray_t            = ParticleArray<dim>;
+
+    Box<int, dim> box{{0, 0}, {3, 3}};
+    ParticleArray_t particles{grow(box, 1)};
+
+    ParticleMergerTest()
+    {
+        std::mt19937 gen{42};
+        std::uniform_real_distribution<double> delta{0, 1};
+        std::normal_distribution<double> velocity{0.5, 1.};
+        std::uniform_real_distribution<double> weight{0.5, 1.5};
+
+        // cell (1, 2) is crowded, the other cells are not
+        for (auto const& cell : box)
+        {
+            std::size_t const nbrParticles = cell[0] == 1 and cell[1] == 2 ? 500 : 20;
+            for (std::size_t i = 0; i < nbrParticles; ++i)
+                particles.push_back(Particle<dim>{weight(gen),
+                                                  1.,
+                                                  {cell[0], cell[1]},
+                                                  {delta(gen), delta(gen)},
+                                                  {velocity(gen), velocity(gen), velocity(gen)}});
+        }
+    }
+
+
+    struct Moments
+    {
+        double weight = 0;
+        std::array<double, 3> momentum{};
+        double energy = 0;
+    };
+
+    Moments moments() const
+    {
+        Moments m;
+        for (auto const& particle : particles)
+        {
+            m.weight += particle.weight;
+            for (std::size_t i = 0; i < 3; ++i)
+            {
+                m.momentum[i] += particle.weight * particle.v[i];
+                m.energy += particle.weight * particle.v[i] * particle.v[i];
+            }
+        }
+        return m;
+    }
+};
+
+
+
+TEST_F(ParticleMergerTest, onlyMergesCrowdedCellsDownToAboutTheTarget)
+{
+    ParticleMerger<ParticleArray_t> merger{100, 50};
+    merger.merge(particles, box);
+
+    EXPECT_EQ(1u, merger.stats().nbrMergedCells);
+    EXPECT_EQ(500u, merger.stats().nbrParticlesBefore);
+    EXPECT_LE(merger.stats().nbrParticlesAfter, 50u + 2 * 8);
+
+    for (auto const& cell : box)
+    {
+        auto const expected = cell[0] == 1 and cell[1] == 2 ? merger.stats().nbrParticlesAfter : 20;
+        EXPECT_EQ(expected, particles.nbr_particles_in({cell, cell}));
+    }
+    EXPECT_EQ(15 * 20 + merger.stats().nbrParticlesAfter, particles.size());
+    EXPECT_EQ(particles.size(), particles.nbr_particles_in(box));
+}
+
+
+
+TEST_F(ParticleMergerTest, conservesWeightMomentumAndEnergy)
+{
+    auto const before = moments();
+
+    ParticleMerger<ParticleArray_t> merger{100, 50};
+    merger.merge(particles, box);
+
+    auto const after = moments();
+
+    EXPECT_NEAR(before.weight, after.weight, 1e-10 * before.weight);
+    EXPECT_NEAR(before.energy, after.energy, 1e-10 * before.energy);
+    for (std::size_t i = 0; i < 3; ++i)
+        EXPECT_NEAR(before.momentum[i], after.momentum[i], 1e-10 * before.weight);
+
+    for (auto const& particle : particles)
+        for (auto const& delta : particle.delta)
+        {
+            EXPECT_GE(delta, 0.);
+            EXPECT_LT(delta, 1.);
+        }
+}
+
+
+
+TEST(ParticleMerger, rejectsInvalidTargets)
+{
+    EXPECT_ANY_THROW((ParticleMerger<ParticleArray<1>>{10, 1}));
+    EXPECT_ANY_THROW((ParticleMerger<ParticleArray<1>>{10, 20}));
+}
+
+
+
+int main(int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -224,6 +224,33 @@ TEST_F(APusher2D, trajectoryIsOk)
 
 
 
+TEST_F(APusher1D, tracksTheMaxSpeedOnlyOnceAsked)
+{
+    auto rangeIn  = makeIndexRange(particlesIn);
+    auto rangeOut = makeIndexRange(particlesOut);
+    auto push     = [&]() {
+        pusher->move(
+            rangeIn, rangeOut, em, mass, interpolator, layout, [](auto& rge) { return rge; },
+            selector);
+    };
+
+    push();
+    EXPECT_EQ(0., pusher->maxSpeed()[0]);
+
+    pusher->trackMaxSpeed(true);
+    push();
+    EXPECT_GT(pusher->maxSpeed()[0], 0.);
+    EXPECT_DOUBLE_EQ(std::abs(particlesOut[0].v[0]), pusher->maxSpeed()[0]);
+
+    pusher->resetMaxSpeed();
+    pusher->trackMaxSpeed(false);
+    push();
+    EXPECT_EQ(0., pusher->maxSpeed()[0]);
+}
+
+
+
+
 TEST_F(APusher1D, trajectoryIsOk)
 {
     auto rangeIn  = makeIndexRange(particlesIn);
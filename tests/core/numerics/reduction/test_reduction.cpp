@@ -0,0 +1,139 @@
+#include "core/numerics/reduction/fft.hpp"
+#include "core/numerics/reduction/global_field.hpp"
+#include "core/numerics/reduction/profile.hpp"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#include <cmath>
+#include <complex>
+#include <cstddef>
+#include <numeric>
+#include <vector>
+
+using namespace PHARE::core;
+
+
+namespace
+{
+double const pi = std::acos(-1.);
+
+std::vector<double> cosine(std::size_t const size, std::size_t const mode, double const amplitude)
+{
+    std::vector<double> signal(size);
+    for (std::size_t i = 0; i < size; ++i)
+        signal[i] = amplitude * std::cos(2. * pi * mode * i / size);
+    return signal;
+}
+} // namespace
+
+
+
+TEST(AnFFT, matchesTheDirectTransformForAllSizes)
+{
+    for (std::size_t size : {1, 2, 8, 12, 13, 97})
+    {
+        std::vector<std::complex<double>> values(size);
+        for (std::size_t i = 0; i < size; ++i)
+            values[i] = {std::sin(1. + i), std::cos(2. * i)};
+
+        auto transformed = values;
+        fft(transformed);
+
+        for (std::size_t k = 0; k < size; ++k)
+        {
+            std::complex<double> expected{};
+            for (std::size_t n = 0; n < size; ++n)
+                expected += values[n] * std::polar(1., -2. * pi * k * n / size);
+            EXPECT_NEAR(expected.real(), transformed[k].real(), 1e-9);
+            EXPECT_NEAR(expected.imag(), transformed[k].imag(), 1e-9);
+        }
+    }
+}
+
+
+
+TEST(APowerSpectrum, peaksAtTheModeOfACosineAndConservesTheMeanSquare)
+{
+    for (std::size_t size : {64, 60})
+    {
+        auto const signal   = cosine(size, 5, 2.);
+        auto const spectrum = powerSpectrum(signal);
+
+        ASSERT_EQ(size / 2 + 1, spectrum.size());
+        EXPECT_NEAR(2., spectrum[5], 1e-10);
+        EXPECT_NEAR(2., std::accumulate(std::begin(spectrum), std::end(spectrum), 0.), 1e-10);
+    }
+}
+
+
+
+TEST(AGlobalField, averagesProfilesOverTheTransverseDirection)
+{
+    GlobalField<2> field{{4, 3}};
+    for (auto const& cell : field.box())
+        field(cell) = cell[0] + 10. * cell[1];
+
+    EXPECT_THAT(field.profile(Box<int, 2>{{1, 0}, {2, 2}}, 0), ::testing::ElementsAre(11., 12.));
+    EXPECT_THAT(field.profile(Box<int, 2>{{0, 1}, {3, 5}}, 1), ::testing::ElementsAre(11.5, 21.5));
+    EXPECT_TRUE(field.profile(Box<int, 2>{{5, 5}, {6, 6}}, 0).empty());
+}
+
+
+
+TEST(AProfile, sumsTheSlicesOfPatchesAddedSeparately)
+{
+    Box<int, 2> const domain{{0, 0}, {3, 2}};
+    auto const value = [](auto const& cell) { return cell[0] + 10. * cell[1]; };
+
+    // two patches, as summed by two processes
+    Profile<2> lower{Box<int, 2>{{1, 0}, {2, 2}}, domain, 0};
+    Profile<2> upper{Box<int, 2>{{1, 0}, {2, 2}}, domain, 0};
+    lower.add(Box<int, 2>{{0, 0}, {3, 0}}, value);
+    upper.add(Box<int, 2>{{0, 1}, {3, 2}}, value);
+
+    auto summed = lower;
+    for (std::size_t i = 0; i < summed.size(); ++i)
+        summed.sums()[i] += upper.sums()[i];
+
+    EXPECT_THAT(summed.averages(), ::testing::ElementsAre(11., 12.));
+    EXPECT_EQ(0u, Profile<2>(Box<int, 2>{{5, 5}, {6, 6}}, domain, 0).size());
+}
+
+
+
+TEST(AGlobalField, averagesSpectraOverAllLines)
+{
+    std::size_t const size = 16;
+    GlobalField<2> field{{size, 2}};
+    auto const signal = cosine(size, 3, 1.);
+    for (auto const& cell : field.box())
+        field(cell) = (cell[1] + 1) * signal[cell[0]];
+
+    // mean square of the lines are 0.5 and 2
+    auto const spectrum = field.spectrum(0);
+    ASSERT_EQ(size / 2 + 1, spectrum.size());
+    EXPECT_NEAR(1.25, spectrum[3], 1e-10);
+}
+
+
+
+TEST(AGlobalField, knowsTheSizesOfItsResultsWithoutComputingThem)
+{
+    GlobalField<2> field{{4, 3}};
+    for (auto const& box :
+         {Box<int, 2>{{1, 0}, {2, 2}}, Box<int, 2>{{0, 1}, {3, 5}}, Box<int, 2>{{5, 5}, {6, 6}}})
+        for (std::size_t axis = 0; axis < 2; ++axis)
+            EXPECT_EQ(field.profile(box, axis).size(), field.profileSize(box, axis));
+
+    for (std::size_t axis = 0; axis < 2; ++axis)
+        EXPECT_EQ(field.spectrum(axis).size(), field.spectrumSize(axis));
+}
+
+
+
+int main(int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,60 @@
+#include "core/numerics/time_step/stable_time_step.hpp"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#include <cmath>
+#include <limits>
+
+using namespace PHARE::core;
+
+
+namespace
+{
+double const pi = std::acos(-1.);
+}
+
+
+
+TEST(AStableWaveTimeStep, isTheWhistlerOneForSmallCells)
+{
+    // whistler dl^2 n / (pi B) = 0.01 / pi, alfven dl sqrt(n) / B = 0.1
+    EXPECT_DOUBLE_EQ(0.01 / pi, stableWaveTimeStep(0.1, 1., 1.));
+}
+
+
+
+TEST(AStableWaveTimeStep, isRelaxedByFieldSubstepsUntilTheAlfvenLimitBinds)
+{
+    // 4 substeps relax the whistler limit to 0.04 / pi, still below the alfven one
+    EXPECT_DOUBLE_EQ(0.04 / pi, stableWaveTimeStep(0.1, 1., 1., 4));
+
+    // ions are pushed once per time step, whatever the number of field substeps
+    EXPECT_DOUBLE_EQ(0.1, stableWaveTimeStep(0.1, 1., 1., 100));
+    EXPECT_DOUBLE_EQ(0.1, stableWaveTimeStep(0.1, 1., 1., 1000));
+}
+
+
+
+TEST(AStableWaveTimeStep, isTheAlfvenOneForLargeCells)
+{
+    // whistler 100 / pi, alfven 10
+    EXPECT_DOUBLE_EQ(10., stableWaveTimeStep(10., 1., 1.));
+}
+
+
+
+TEST(AStableWaveTimeStep, isInfiniteWithoutMagneticFieldOrIons)
+{
+    auto const infinity = std::numeric_limits<double>::max();
+    EXPECT_EQ(infinity, stableWaveTimeStep(0.1, 1., 0.));
+    EXPECT_EQ(infinity, stableWaveTimeStep(0.1, infinity, 1.));
+}
+
+
+
+int main(int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,129 @@
+#include "core/utilities/timestamps.hpp"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#include <limits>
+#include <vector>
+
+using namespace PHARE::core;
+
+
+namespace
+{
+double const infinity = std::numeric_limits<double>::max();
+
+std::vector<double> advanceTo(AdaptiveTimeStamper& stamper, double const finalTime,
+                              double const stableDt)
+{
+    std::vector<double> times;
+    double time = 0;
+    while (time < finalTime)
+    {
+        time = (stamper += stamper.timeStep());
+        times.push_back(time);
+        stamper.updateTimeStep(stableDt);
+    }
+    return times;
+}
+} // namespace
+
+
+
+TEST(ALandmark, isReachedUpToRoundingErrorsOnly)
+{
+    EXPECT_TRUE(isOnLandmark(0.1 + 0.2, 0.3));
+    EXPECT_TRUE(isOnLandmark(3 * 0.1, 0.3));
+    EXPECT_TRUE(isOnLandmark(1000 * 0.001, 1.));
+
+    // a time step before the landmark, even less than a time step before, is not on it
+    EXPECT_FALSE(isOnLandmark(0.3 - 0.1, 0.3));
+    EXPECT_FALSE(isOnLandmark(0.3 - 1e-9, 0.3));
+}
+
+
+
+TEST(AnAdaptiveTimeStamper, takesTheFirstTimeStepItIsGiven)
+{
+    AdaptiveTimeStamper stamper{0.01, {}, {1.}};
+    EXPECT_DOUBLE_EQ(0.01, stamper.timeStep());
+}
+
+
+
+TEST(AnAdaptiveTimeStamper, takesAFractionOfTheStableTimeStep)
+{
+    AdaptiveTimeStepParams params;
+    params.cfl = 0.5;
+    AdaptiveTimeStamper stamper{0.1, params, {100.}};
+
+    stamper += stamper.timeStep();
+    EXPECT_DOUBLE_EQ(0.05, stamper.updateTimeStep(0.1));
+}
+
+
+
+TEST(AnAdaptiveTimeStamper, atMostDoublesTheTimeStepAndRespectsTheMaximum)
+{
+    AdaptiveTimeStepParams params;
+    params.maxDt = 0.3;
+    AdaptiveTimeStamper stamper{0.1, params, {100.}};
+
+    stamper += stamper.timeStep();
+    EXPECT_DOUBLE_EQ(0.2, stamper.updateTimeStep(infinity));
+    stamper += stamper.timeStep();
+    EXPECT_DOUBLE_EQ(0.3, stamper.updateTimeStep(infinity));
+}
+
+
+
+TEST(AnAdaptiveTimeStamper, landsOnAllLandmarks)
+{
+    std::vector<double> const landmarks{0.35, 1., 1.001, 2.5};
+    AdaptiveTimeStamper stamper{0.1, {}, landmarks};
+
+    auto const times = advanceTo(stamper, 2.5, 0.27);
+
+    for (auto const& landmark : landmarks)
+        EXPECT_THAT(times, ::testing::Contains(landmark));
+    EXPECT_DOUBLE_EQ(2.5, times.back());
+}
+
+
+
+TEST(AnAdaptiveTimeStamper, restartedWithItsRestartTimeStepTakesTheSameSteps)
+{
+    std::vector<double> const landmarks{0.35, 1., 2.5};
+    AdaptiveTimeStamper stamper{0.01, {}, landmarks};
+    advanceTo(stamper, 1., 0.27); // the last step is shortened to land on 1
+
+    // the restarted stamper starts at 1, its landmarks are relative to it
+    AdaptiveTimeStamper restarted{stamper.restartTimeStep(), {}, {1.5}};
+    EXPECT_DOUBLE_EQ(stamper.timeStep(), restarted.timeStep());
+
+    auto const times          = advanceTo(stamper, 2.5, 0.27);
+    auto const restartedTimes = advanceTo(restarted, 1.5, 0.27);
+    ASSERT_EQ(times.size(), restartedTimes.size());
+    for (std::size_t i = 0; i < times.size(); ++i)
+        EXPECT_NEAR(times[i], 1. + restartedTimes[i], 1e-12);
+}
+
+
+
+TEST(AnAdaptiveTimeStamper, throwsIfTheTimeStepFallsBelowTheMinimum)
+{
+    AdaptiveTimeStepParams params;
+    params.minDt = 0.01;
+    AdaptiveTimeStamper stamper{0.1, params, {1.}};
+
+    stamper += stamper.timeStep();
+    EXPECT_THROW(stamper.updateTimeStep(0.001), std::runtime_error);
+}
+
+
+
+int main(int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -1,9 +1,14 @@
 
+import os
 import unittest
 from datetime import datetime
 import pyphare.pharein as ph, numpy as np
 from pyphare.pharein import ElectronModel
 
+# test outputs are compared at machine precision, diagnostics default to doubles unless a test
+# requests otherwise, see also PHARE_TEST_DIAG_PRECISION in res/cmake/options.cmake
+os.environ.setdefault("PHARE_DIAG_PRECISION", "double")
+
 
 def parse_cli_args(pop_from_sys = True):
     import sys
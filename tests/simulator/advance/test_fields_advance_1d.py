@@ -81,6 +81,12 @@ class AdvanceTest(AdvanceTestBase):
         self._test_field_level_ghosts_via_subcycles_and_coarser_interpolation(ndim, interp_order, refinement_boxes)
 
 
+    @data(*interp_orders)
+    def test_field_substeps_match_smaller_time_steps(self, interp_order):
+        print(f"{self._testMethodName}_{ndim}d")
+        self._test_field_substeps_match_smaller_time_steps(ndim, interp_order)
+
+
 if __name__ == "__main__":
     unittest.main()
 
@@ -34,6 +34,12 @@ class AdvanceTest(AdvanceTestBase):
 
 
 
+    @data(*interp_orders)
+    def test_patch_ghost_particles_are_exchanged_between_ranks(self, interp_order):
+        self._test_patch_ghost_particles_are_exchanged_between_ranks(ndim, interp_order)
+
+
+
     @data(*interp_orders)
     def test_L0_particle_number_conservation(self, interp):
         self._test_L0_particle_number_conservation(ndim, interp)
@@ -0,0 +1,116 @@
+#!/usr/bin/env python3
+#
+# phareh5 restarts do not depend on the number of processes of the saved simulation:
+#   python3 restart_rank_count.py dump       # with N processes, saves a restart and diagnostics
+#   python3 restart_rank_count.py restart    # with M != N processes, restarts from the saved one
+# the restarted simulation diagnostics are compared to the ones of the saved simulation, patches
+# differ with the number of processes, values are thus compared per level and coordinate
+
+from pyphare.cpp import cpp_lib
+cpp = cpp_lib()
+
+import sys
+import numpy as np
+
+import pyphare.pharein as ph
+from pyphare.pharesee.run import Run
+from pyphare.simulator.simulator import Simulator
+
+from tests.diagnostic import dump_all_diags
+from tests.simulator.test_restarts import setup_model, simArgs, dup, phareh5, out, timestep
+
+
+restart_idx = 4
+restart_time = timestep * restart_idx
+timestamps = [restart_time, timestep * simArgs["time_step_nbr"]]
+dump_dir = f"{out}/rank_count/dump"
+
+# moments are deposited and fields updated per patch, with other patches the summations are in
+# another order. Differences of the order of the double precision rounding may change the
+# diagnostics by one unit in the last place, at most a float one if written in single precision
+float_eps = np.finfo(np.float32).eps
+
+
+def simulation(diag_dir, restart_time=None):
+    simput = phareh5(dup(dict(smallest_patch_size=10, largest_patch_size=20)))
+    for key in ["cells", "dl", "boundary_types"]:
+        simput[key] = [simput[key]]
+    simput["refinement_boxes"] = {"L0": {"B0": [[10], [19]]}}
+    simput["restart_options"]["dir"] = dump_dir
+    simput["diag_options"]["options"]["dir"] = diag_dir
+    if restart_time is not None:
+        simput["restart_options"]["restart_time"] = restart_time
+
+    ph.global_vars.sim = None
+    ph.global_vars.sim = ph.Simulation(**simput)
+    model = setup_model()
+    dump_all_diags(model.populations, timestamps=np.array(timestamps))
+    Simulator(ph.global_vars.sim).run().reset()
+    return model
+
+
+def field_values(hier, time):
+    """ patch values per level, field name and coordinate, ghost nodes excluded """
+    values = {}
+    for ilvl, lvl in hier.levels(time).items():
+        for patch in lvl.patches:
+            for name, pd in patch.patch_datas.items():
+                data = pd[pd.box]
+                start = pd.ghosts_nbr[0]
+                x = pd.x[start : start + len(data)]
+                for xi, value in zip(np.round(2 * x / pd.dl[0]).astype(int), data):
+                    values[(ilvl, name, xi)] = value
+    return values
+
+
+def particle_sums(hier, time):
+    """ number of domain particles and sum of their weights, per level """
+    sums = {}
+    for ilvl, lvl in hier.levels(time).items():
+        nbr, weight = sums.get(ilvl, (0, 0.0))
+        for patch in lvl.patches:
+            for pd in patch.patch_datas.values():
+                nbr += pd.dataset.size()
+                weight += np.sum(pd.dataset.weights)
+        sums[ilvl] = (nbr, weight)
+    return sums
+
+
+def compare(dump_dir, restart_dir, pops):
+    run0, run1 = Run(dump_dir), Run(restart_dir)
+    for time in timestamps:
+        for get in [Run.GetB, Run.GetE, Run.GetNi, Run.GetVi]:
+            values0 = field_values(get(run0, time), time)
+            values1 = field_values(get(run1, time), time)
+            assert sorted(values0.keys()) == sorted(values1.keys())
+            keys = sorted(values0.keys())
+            np.testing.assert_allclose(
+                [values0[key] for key in keys],
+                [values1[key] for key in keys],
+                rtol=float_eps,
+                atol=float_eps,
+            )
+
+        sums0 = particle_sums(run0.GetParticles(time, pops), time)
+        sums1 = particle_sums(run1.GetParticles(time, pops), time)
+        assert sorted(sums0.keys()) == sorted(sums1.keys())
+        for ilvl, (nbr, weight) in sums0.items():
+            assert nbr == sums1[ilvl][0]
+            np.testing.assert_allclose(weight, sums1[ilvl][1], rtol=1e-12)
+
+
+def main():
+    mode = sys.argv[1]
+    if mode == "dump":
+        simulation(dump_dir)
+    elif mode == "restart":
+        restart_dir = f"{out}/rank_count/restart_mpi_n_{cpp.mpi_size()}"
+        model = simulation(restart_dir, restart_time=restart_time)
+        if cpp.mpi_rank() == 0:
+            compare(dump_dir, restart_dir, model.populations)
+    else:
+        raise ValueError(f"unknown mode {mode}, expected dump or restart")
+
+
+if __name__ == "__main__":
+    main()
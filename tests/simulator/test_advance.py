@@ -34,7 +34,7 @@ class AdvanceTestBase(SimulatorTest):
                      smallest_patch_size=None, largest_patch_size=20,
                      cells=120, time_step=0.001, model_init={},
                      dl=0.2, extra_diag_options={}, time_step_nbr=1, timestamps=None, ndim=1,
-                     block_merging_particles=False):
+                     block_merging_particles=False, field_substeps=1):
 
         diag_outputs = f"phare_outputs/advance/{diag_outputs}"
         from pyphare.pharein import global_vars
@@ -45,6 +45,7 @@ class AdvanceTestBase(SimulatorTest):
 
         extra_diag_options["mode"] = "overwrite"
         extra_diag_options["dir"]  = diag_outputs
+        extra_diag_options["precision"] = "double" # outputs are compared at machine precision
         self.register_diag_dir_for_cleanup(diag_outputs)
         Simulation(
             smallest_patch_size=smallest_patch_size,
@@ -56,6 +57,7 @@ class AdvanceTestBase(SimulatorTest):
             dl=np_array_ify(dl, ndim),
             interp_order=interp_order,
             refinement_boxes=refinement_boxes,
+            field_substeps=field_substeps,
             diag_options={"format": "phareh5",
                           "options": extra_diag_options},
             strict=True,
@@ -299,6 +301,67 @@ class AdvanceTestBase(SimulatorTest):
                         part2.iCells = part2.iCells + offsets[1]
                         self.assertEqual(part1, part2)
 
+        return datahier
+
+
+
+    def _test_patch_ghost_particles_are_exchanged_between_ranks(self, ndim, interp_order, **kwargs):
+        """
+          patch ghost particles are filled by the ParticleMigrator, with small patches the level
+          is spread over all ranks, and overlaps of patches owned by different ranks are checked
+        """
+        datahier = self._test_overlapped_particledatas_have_identical_particles(
+            ndim, interp_order, None, largest_patch_size=10, cells=60, **kwargs)
+
+        if cpp.mpi_size() == 1:
+            return
+
+        def rank_of(patch): # patch ids are "p{rank}#{local id}"
+            return patch.id[1:].split("#")[0]
+
+        remote_overlaps = [
+            overlap for overlap in hierarchy_overlaps(datahier)[0]
+            if rank_of(overlap["patches"][0]) != rank_of(overlap["patches"][1])
+        ]
+        self.assertGreater(len(remote_overlaps), 0)
+
+
+    def _test_field_substeps_match_smaller_time_steps(self, ndim, interp_order, field_substeps=4):
+        """
+          B advanced over one time step in field_substeps substeps is compared to B advanced by
+          the single step solver in field_substeps steps of a field_substeps times smaller time
+          step. Ion moments are fixed during the substeps, so the two only agree up to a small
+          fraction of the change of B over the time step.
+        """
+        print(f"test_field_substeps_match_smaller_time_steps for dim/interp : {ndim}/{interp_order}")
+
+        time_step = 0.001
+        timestamps = np.asarray([0, time_step])
+        substepped, reference = [
+            self.getHierarchy(interp_order, None, "b", ndim=ndim,
+                              diag_outputs=f"phare_field_substeps/{ndim}/{interp_order}/{self.ddt_test_id()}/{substeps}",
+                              time_step=time_step / time_step_nbr, time_step_nbr=time_step_nbr,
+                              field_substeps=substeps, timestamps=timestamps)
+            for substeps, time_step_nbr in [(field_substeps, 1), (1, field_substeps)]
+        ]
+
+        max_diff, max_change = 0, 0
+        patches = zip(reference.level(0, 0).patches,
+                      reference.level(0, time_step).patches,
+                      substepped.level(0, time_step).patches)
+        for initial, final, substepped_final in patches:
+            self.assertEqual(final.box, substepped_final.box)
+            for name in ["Bx", "By", "Bz"]:
+                B0 = initial.patch_datas[name].dataset[:]
+                B  = final.patch_datas[name].dataset[:]
+                Bs = substepped_final.patch_datas[name].dataset[:]
+                max_diff   = max(max_diff, np.max(np.abs(Bs - B)))
+                max_change = max(max_change, np.max(np.abs(B - B0)))
+
+        self.assertGreater(max_change, 0)
+        self.assertLess(max_diff, 0.05 * max_change)
+
+
 
     def _test_L0_particle_number_conservation(self, ndim, interp_order, ppc=100):
         cells=120
@@ -5,12 +5,14 @@
 from pyphare.cpp import cpp_lib
 cpp = cpp_lib()
 
-from tests.diagnostic import dump_all_diags
+from tests.diagnostic import dump_all_diags, all_timestamps
 from tests.simulator import populate_simulation
 from pyphare.pharein import ElectronModel
 from pyphare.simulator.simulator import Simulator, startMPI
 from pyphare.pharein.simulation import supported_dimensions
 from pyphare.pharesee.hierarchy import hierarchy_from, h5_filename_from, h5_time_grp_key
+from pyphare.pharesee.hierarchy import is_aggregated_layout
+from pyphare.core.box import Box
 import pyphare.pharein as ph
 import unittest
 import os
@@ -207,6 +209,144 @@ class DiagnosticsTest(unittest.TestCase):
 
 
 
+    def _dump_layout(self, layout, local_out, refinement_boxes=None, **diag_kwargs):
+        if refinement_boxes is None:
+            refinement_boxes = {"L0": {"B0": [[10], [19]]}}
+        simInput = dup({"smallest_patch_size": 5, "largest_patch_size": 10})
+        simInput.update({"time_step_nbr": 2, "final_time": 0.002, "cells": [40], "dl": [0.3],
+                         "boundary_types": ["periodic"], "refinement_boxes": refinement_boxes})
+        simInput["diag_options"] = {"format": "phareh5",
+                                    "options": {"dir": local_out, "mode": "overwrite"}}
+        simulation = ph.Simulation(**simInput)
+        model = setup_model(ppc=10)
+        timestamps = all_timestamps(simulation)
+
+        for quantity in ["E", "B"]:
+            ph.ElectromagDiagnostics(quantity=quantity, write_timestamps=timestamps,
+                                     layout=layout, **diag_kwargs)
+        ph.FluidDiagnostics(quantity="density", write_timestamps=timestamps, layout=layout,
+                            **diag_kwargs)
+        for pop in model.populations:
+            ph.ParticleDiagnostics(quantity="domain", write_timestamps=timestamps,
+                                   population_name=pop, layout=layout)
+
+        self.simulator = Simulator(simulation).run().reset()
+        self.simulator = None
+        ph.global_vars.sim = None
+
+
+
+    def _patch_datas(self, h5_filepath):
+        """ datasets of the file per time, level and patch lower corner """
+        hier = hierarchy_from(h5_filename=h5_filepath)
+        patch_datas = {}
+        for time in hier.times():
+            for ilvl, lvl in hier.levels(time).items():
+                for patch in lvl.patches:
+                    key = (float(time), ilvl, tuple(patch.box.lower))
+                    patch_datas[key] = {name: pd for name, pd in patch.patch_datas.items()}
+        return patch_datas
+
+
+
+    def test_aggregated_layout_matches_patches_layout(self):
+        # with several MPI processes, each rank writes its patches at an offset of the level
+        # datasets, which need be read back as the patches written by the default layout
+        local_out = f"{out}_aggregated_mpi_n_{cpp.mpi_size()}"
+        self._dump_layout("patches", f"{local_out}_patches")
+        self._dump_layout("aggregated", f"{local_out}_aggregated")
+
+        if cpp.mpi_rank() > 0:
+            return
+
+        self._assert_same_patch_datas(f"{local_out}_patches", f"{local_out}_aggregated")
+
+
+
+    def test_aggregated_layout_with_ranks_without_patches_on_a_level(self):
+        # the refined level is a single patch, so with several MPI processes all ranks but one
+        # have no patch on it, and still have to take part in the collective writes of its datasets
+        local_out = f"{out}_aggregated_single_fine_patch_mpi_n_{cpp.mpi_size()}"
+        refinement_boxes = {"L0": {"B0": [[10], [14]]}}
+        self._dump_layout("patches", f"{local_out}_patches", refinement_boxes)
+        self._dump_layout("aggregated", f"{local_out}_aggregated", refinement_boxes)
+
+        if cpp.mpi_rank() > 0:
+            return
+
+        self._assert_same_patch_datas(f"{local_out}_patches", f"{local_out}_aggregated")
+
+        patch_datas = self._patch_datas(os.path.join(f"{local_out}_aggregated", "EM_B.h5"))
+        fine_patches = {key[2] for key in patch_datas if key[1] == 1}
+        self.assertEqual(len(fine_patches), 1)
+
+
+
+    def _assert_same_patch_datas(self, ref_out, local_out, atol=0):
+        h5_files = [f for f in os.listdir(ref_out) if f.endswith(".h5")]
+        self.assertEqual(len(h5_files), 5)
+
+        for h5_file in h5_files:
+            with h5py.File(os.path.join(local_out, h5_file), "r") as data_file:
+                self.assertTrue(is_aggregated_layout(data_file))
+
+            patches = self._patch_datas(os.path.join(ref_out, h5_file))
+            aggregated = self._patch_datas(os.path.join(local_out, h5_file))
+            self.assertEqual(sorted(patches.keys()), sorted(aggregated.keys()))
+            self.assertTrue(any(key[1] == 1 for key in patches))
+
+            for key, pdatas in patches.items():
+                self.assertEqual(sorted(pdatas.keys()), sorted(aggregated[key].keys()))
+                for name, pd in pdatas.items():
+                    that = aggregated[key][name]
+                    if h5_file.endswith("domain.h5"):
+                        self.assertEqual(pd.dataset.size(), that.dataset.size())
+                        np.testing.assert_array_equal(pd.dataset.iCells, that.dataset.iCells)
+                        np.testing.assert_array_equal(pd.dataset.v, that.dataset.v)
+                    else:
+                        np.testing.assert_allclose(pd.dataset[:], that.dataset[:], rtol=0, atol=atol)
+
+
+
+    def _filtered_datasets(self, local_out, h5_file):
+        datasets = []
+        def visit(name, node):
+            if isinstance(node, h5py.Dataset) and node.chunks is not None:
+                datasets.append(node)
+        with h5py.File(os.path.join(local_out, h5_file), "r") as data_file:
+            data_file.visititems(visit)
+            return [(ds.name, ds.compression, ds.shuffle, ds.scaleoffset) for ds in datasets]
+
+
+
+    def test_compressed_datasets_round_trip(self):
+        local_out = f"{out}_compression_mpi_n_{cpp.mpi_size()}"
+        lossless = {"chunk_size": 64, "shuffle": True, "deflate": 4}
+        error_bound = 1e-4
+        self._dump_layout("patches", f"{local_out}_reference")
+        self._dump_layout("aggregated", f"{local_out}_lossless", compression=lossless)
+        self._dump_layout("aggregated", f"{local_out}_lossy",
+                          compression={"chunk_size": 64, "error_bound": error_bound})
+
+        if cpp.mpi_rank() > 0:
+            return
+
+        lossless_datasets = self._filtered_datasets(f"{local_out}_lossless", "EM_B.h5")
+        self.assertGreater(len(lossless_datasets), 0)
+        for name, compression, shuffle, scaleoffset in lossless_datasets:
+            self.assertEqual(compression, "gzip", name)
+            self.assertTrue(shuffle, name)
+            self.assertIsNone(scaleoffset, name)
+
+        lossy_datasets = self._filtered_datasets(f"{local_out}_lossy", "EM_B.h5")
+        self.assertTrue(any(scaleoffset is not None for *_, scaleoffset in lossy_datasets))
+
+        self._assert_same_patch_datas(f"{local_out}_reference", f"{local_out}_lossless")
+        self._assert_same_patch_datas(f"{local_out}_reference", f"{local_out}_lossy",
+                                      atol=error_bound)
+
+
+
     def test_twice_register(self):
         simulation = ph.Simulation(**simArgs.copy())
         model = setup_model()
@@ -214,5 +354,26 @@ class DiagnosticsTest(unittest.TestCase):
         self.assertRaises(RuntimeError, dump_all_diags, model.populations)
 
 
+
+    def test_compute_timestamps_past_the_last_write_are_rejected(self):
+        simulation = ph.Simulation(**simArgs.copy())
+        setup_model()
+        write_timestamps = np.asarray([0., 1.])
+        late_compute_timestamps = np.asarray([0., 1., 2.])
+
+        self.assertRaises(RuntimeError, ph.ReductionDiagnostics, quantity="energy",
+                          write_timestamps=write_timestamps,
+                          compute_timestamps=late_compute_timestamps)
+        self.assertRaises(RuntimeError, ph.DistributionDiagnostics, quantity="distribution",
+                          population_name="protons", write_timestamps=write_timestamps,
+                          compute_timestamps=late_compute_timestamps,
+                          distribution={"boxes": [Box(0, 9)], "bins": 10,
+                                        "v_min": [-1] * 3, "v_max": [1] * 3})
+
+        ph.ReductionDiagnostics(quantity="energy", write_timestamps=write_timestamps,
+                                compute_timestamps=write_timestamps)
+        ph.global_vars.sim = None
+
+
 if __name__ == "__main__":
     unittest.main()
@@ -47,6 +47,7 @@ class InitializationTest(SimulatorTest):
 
         extra_diag_options["mode"] = "overwrite"
         extra_diag_options["dir"]  = diag_outputs
+        extra_diag_options["precision"] = "double" # outputs are compared at machine precision
         self.register_diag_dir_for_cleanup(diag_outputs)
         Simulation(
             smallest_patch_size=smallest_patch_size,
@@ -73,6 +73,9 @@ class SimulatorValidation(unittest.TestCase):
         # finer box is within set of coarser boxes
         dup({"cells":[65], "refinement_boxes": {"L0": [Box(5, 9), Box(10, 15)], "L1": [Box(11, 29)]}}),
 
+        dup({"cells":[65], "refinement_boxes": {"L0": [Box(5, 25)]}, "ghost_stream_encoding": "delta"}),
+        dup({"cells":[65], "refinement_boxes": {"L0": [Box(5, 25)]}, "ghost_stream_encoding": "float"}),
+        dup({"cells":[65], "refinement_boxes": {"L0": [Box(5, 25)]}, "field_substeps": 4}),
     ]
 
     invalid1D = [
@@ -97,6 +100,11 @@ class SimulatorValidation(unittest.TestCase):
         dup({"cells":[65], "refinement_boxes": None, "largest_patch_size": 20, "nesting_buffer": 46}),
         # finer box is not within set of coarser boxes
         dup({"cells":[65], "refinement_boxes": {"L0": [Box(5, 9), Box(11, 15)], "L1": [Box(11, 29)]}}),
+        # unknown ghost stream encoding
+        dup({"cells":[65], "refinement_boxes": {"L0": [Box(5, 25)]}, "ghost_stream_encoding": "half"}),
+        # field substeps must be a strictly positive integer
+        dup({"cells":[65], "refinement_boxes": {"L0": [Box(5, 25)]}, "field_substeps": 0}),
+        dup({"cells":[65], "refinement_boxes": {"L0": [Box(5, 25)]}, "field_substeps": 1.5}),
     ]
 
 
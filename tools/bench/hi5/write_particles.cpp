@@ -1,6 +1,5 @@
 
 #include "benchmark/benchmark.hpp"
-#define PHARE_DIAG_DOUBLES 0
 #include "diagnostic/detail/h5writer.hpp"
 #include "diagnostic/detail/h5_utils.hpp"
 #include "diagnostic/diagnostic_manager.hpp"